@@ -69,6 +69,10 @@ CONF_AUTO_ALIGN_TIME = "auto_align_time"
 CONF_AUTO_ALIGN_MIDPOINT = "auto_align_midpoint"
 CONF_MAX_RETRIES = "max_retries"
 CONF_RETRY_COOLDOWN = "retry_cooldown"
+CONF_READ_CACHE_MAX_AGE = "read_cache_max_age"
+CONF_READ_BUDGET_PER_DAY = "read_budget_per_day"
+CONF_READ_BUDGET_BURST = "read_budget_burst"
+CONF_PUBLISH_FULL_REFRESH = "publish_full_refresh"
 CONF_INITIAL_READ_ON_BOOT = "initial_read_on_boot"
 CONF_DEBUG_CC1101 = "debug_cc1101"
 CONF_ADAPTIVE_THRESHOLD = "adaptive_threshold"
@@ -101,6 +105,17 @@ CONF_TOTAL_ATTEMPTS = "total_attempts"
 CONF_SUCCESSFUL_READS = "successful_reads"
 CONF_FAILED_READS = "failed_reads"
 CONF_GDO2_TIMEOUTS = "gdo2_timeouts"
+CONF_READ_DURATION = "read_duration"
+CONF_READ_TIMELINE = "read_timeline"
+CONF_SPI_TRANSACTIONS = "spi_transactions"
+CONF_SPI_STATS = "spi_stats"
+CONF_FREE_HEAP = "free_heap"
+CONF_LARGEST_FREE_BLOCK = "largest_free_block"
+CONF_HEAP_FRAGMENTATION = "heap_fragmentation"
+CONF_MIN_FREE_HEAP = "min_free_heap"
+CONF_STACK_FREE = "stack_free"
+CONF_MAX_LOOP_BLOCK = "max_loop_block"
+CONF_RUNTIME_DIAGNOSTICS = "runtime_diagnostics"
 CONF_FREQUENCY_OFFSET = "frequency_offset"
 CONF_TUNED_FREQUENCY = "tuned_frequency"
 CONF_FREQUENCY_ESTIMATE = "frequency_estimate"
@@ -114,7 +129,7 @@ CONF_RX_ATTENUATION = "rx_attenuation"
 METER_TYPE_WATER = "water"
 METER_TYPE_GAS = "gas"
 
-# Reading schedules - must match C++ ScheduleManager::isValidSchedule(...) string comparisons
+# Reading schedules - must match C++ ScheduleManager::compileSchedule(...)
 SCHEDULE_MONDAY_FRIDAY = "Monday-Friday"
 SCHEDULE_MONDAY_SATURDAY = "Monday-Saturday"
 SCHEDULE_MONDAY_SUNDAY = "Monday-Sunday"
@@ -127,30 +142,42 @@ SCHEDULE_SINGLE_DAYS = [
     "Saturday",
     "Sunday",
 ]
+# Monthly rules: Nth (or last) occurrence of a weekday, e.g. "First-Monday"
+SCHEDULE_NTH_PREFIXES = ["First", "Second", "Third", "Fourth", "Last"]
+SCHEDULE_NTH_WEEKDAYS = [
+    f"{nth}-{day}" for nth in SCHEDULE_NTH_PREFIXES for day in SCHEDULE_SINGLE_DAYS
+]
 # Full set accepted by the C++ ScheduleManager (case-sensitive exact match).
 VALID_SCHEDULES = [
     SCHEDULE_MONDAY_FRIDAY,
     SCHEDULE_MONDAY_SATURDAY,
     SCHEDULE_MONDAY_SUNDAY,
     *SCHEDULE_SINGLE_DAYS,
+    *SCHEDULE_NTH_WEEKDAYS,
 ]
 # Lowercase -> canonical lookup so YAML values are accepted case-insensitively
-# and normalized to the exact form the C++ ScheduleManager compares against.
+# and normalized to the exact form the C++ ScheduleManager compiles.
 _SCHEDULE_LOOKUP = {s.lower(): s for s in VALID_SCHEDULES}
 
 
 def validate_reading_schedule(value):
     """Accept the reading schedule case-insensitively and normalize it.
 
-    The C++ ScheduleManager does a case-sensitive exact match, so map any
-    casing (e.g. 'monday-friday', 'FRIDAY') to the canonical form and reject
-    anything that is not a known preset or weekday.
+    The C++ ScheduleManager compiles the schedule with a case-sensitive exact
+    match, so map any casing (e.g. 'monday-friday', 'FRIDAY', 'last-friday') to
+    the canonical form and reject anything that is not a known preset, weekday
+    or Nth-weekday rule. Invalid schedules therefore fail at config time rather
+    than silently disabling scheduled reads on the device.
     """
     canonical = _SCHEDULE_LOOKUP.get(cv.string(value).strip().lower())
     if canonical is None:
         raise cv.Invalid(
             f"Invalid reading_schedule '{value}'. Expected one of (case-insensitive): "
-            + ", ".join(VALID_SCHEDULES)
+            + ", ".join(
+                [SCHEDULE_MONDAY_FRIDAY, SCHEDULE_MONDAY_SATURDAY, SCHEDULE_MONDAY_SUNDAY]
+            )
+            + ", a day name (Monday..Sunday) or an Nth weekday of the month "
+            "(First-Monday..Fourth-Sunday, Last-Monday..Last-Sunday)"
         )
     return canonical
 
@@ -255,6 +282,18 @@ CONFIG_SCHEMA = (
             cv.Optional(
                 CONF_RETRY_COOLDOWN, default="1h"
             ): cv.positive_time_period_milliseconds,
+            cv.Optional(
+                CONF_READ_CACHE_MAX_AGE, default="60s"
+            ): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_READ_BUDGET_PER_DAY, default=24): cv.int_range(
+                min=0, max=1440
+            ),
+            cv.Optional(CONF_READ_BUDGET_BURST, default=10): cv.int_range(
+                min=1, max=100
+            ),
+            cv.Optional(
+                CONF_PUBLISH_FULL_REFRESH, default="1h"
+            ): cv.positive_time_period_milliseconds,
             cv.Optional(CONF_INITIAL_READ_ON_BOOT, default=False): cv.boolean,
             cv.Optional(CONF_DEBUG_CC1101, default=False): cv.boolean,
             cv.Optional(CONF_ADAPTIVE_THRESHOLD, default=1): cv.int_range(
@@ -331,6 +370,61 @@ CONFIG_SCHEMA = (
                 icon="mdi:pulse",
                 entity_category="diagnostic",
             ),
+            cv.Optional(CONF_READ_DURATION): sensor.sensor_schema(
+                unit_of_measurement="ms",
+                accuracy_decimals=0,
+                state_class=STATE_CLASS_MEASUREMENT,
+                icon="mdi:timer-outline",
+                entity_category="diagnostic",
+            ),
+            cv.Optional(CONF_SPI_TRANSACTIONS): sensor.sensor_schema(
+                accuracy_decimals=0,
+                state_class=STATE_CLASS_MEASUREMENT,
+                icon="mdi:swap-horizontal",
+                entity_category="diagnostic",
+            ),
+            cv.Optional(CONF_FREE_HEAP): sensor.sensor_schema(
+                unit_of_measurement="B",
+                accuracy_decimals=0,
+                state_class=STATE_CLASS_MEASUREMENT,
+                icon="mdi:memory",
+                entity_category="diagnostic",
+            ),
+            cv.Optional(CONF_LARGEST_FREE_BLOCK): sensor.sensor_schema(
+                unit_of_measurement="B",
+                accuracy_decimals=0,
+                state_class=STATE_CLASS_MEASUREMENT,
+                icon="mdi:memory",
+                entity_category="diagnostic",
+            ),
+            cv.Optional(CONF_HEAP_FRAGMENTATION): sensor.sensor_schema(
+                unit_of_measurement=UNIT_PERCENT,
+                accuracy_decimals=0,
+                state_class=STATE_CLASS_MEASUREMENT,
+                icon="mdi:chart-donut",
+                entity_category="diagnostic",
+            ),
+            cv.Optional(CONF_MIN_FREE_HEAP): sensor.sensor_schema(
+                unit_of_measurement="B",
+                accuracy_decimals=0,
+                state_class=STATE_CLASS_MEASUREMENT,
+                icon="mdi:memory",
+                entity_category="diagnostic",
+            ),
+            cv.Optional(CONF_STACK_FREE): sensor.sensor_schema(
+                unit_of_measurement="B",
+                accuracy_decimals=0,
+                state_class=STATE_CLASS_MEASUREMENT,
+                icon="mdi:layers-outline",
+                entity_category="diagnostic",
+            ),
+            cv.Optional(CONF_MAX_LOOP_BLOCK): sensor.sensor_schema(
+                unit_of_measurement="ms",
+                accuracy_decimals=0,
+                state_class=STATE_CLASS_MEASUREMENT,
+                icon="mdi:timer-sand",
+                entity_category="diagnostic",
+            ),
             cv.Optional(CONF_FREQUENCY_OFFSET): sensor.sensor_schema(
                 unit_of_measurement="kHz",
                 accuracy_decimals=3,
@@ -399,6 +493,18 @@ CONFIG_SCHEMA = (
                 icon="mdi:clock-outline",
                 entity_category="diagnostic",
             ),
+            cv.Optional(CONF_READ_TIMELINE): text_sensor.text_sensor_schema(
+                icon="mdi:chart-timeline-variant",
+                entity_category="diagnostic",
+            ),
+            cv.Optional(CONF_SPI_STATS): text_sensor.text_sensor_schema(
+                icon="mdi:chart-histogram",
+                entity_category="diagnostic",
+            ),
+            cv.Optional(CONF_RUNTIME_DIAGNOSTICS): text_sensor.text_sensor_schema(
+                icon="mdi:heart-pulse",
+                entity_category="diagnostic",
+            ),
             # Binary sensors
             cv.Optional(CONF_ACTIVE_READING): binary_sensor.binary_sensor_schema(
                 device_class=DEVICE_CLASS_RUNNING,
@@ -562,6 +668,10 @@ async def to_code(config):
     cg.add(var.set_auto_align_midpoint(config[CONF_AUTO_ALIGN_MIDPOINT]))
     cg.add(var.set_max_retries(config[CONF_MAX_RETRIES]))
     cg.add(var.set_retry_cooldown(config[CONF_RETRY_COOLDOWN]))  # Already in ms
+    cg.add(var.set_read_cache_max_age(config[CONF_READ_CACHE_MAX_AGE]))  # Already in ms
+    cg.add(var.set_read_budget_per_day(config[CONF_READ_BUDGET_PER_DAY]))
+    cg.add(var.set_read_budget_burst(config[CONF_READ_BUDGET_BURST]))
+    cg.add(var.set_publish_full_refresh(config[CONF_PUBLISH_FULL_REFRESH]))  # Already in ms
     cg.add(var.set_initial_read_on_boot(config[CONF_INITIAL_READ_ON_BOOT]))
     cg.add(var.set_adaptive_threshold(config[CONF_ADAPTIVE_THRESHOLD]))
     cg.add(var.set_rx_attenuation(config[CONF_RX_ATTENUATION]))
@@ -653,6 +763,38 @@ async def to_code(config):
         sens = await sensor.new_sensor(config[CONF_GDO2_TIMEOUTS])
         cg.add(var.set_gdo2_timeouts_sensor(sens))
 
+    if CONF_READ_DURATION in config:
+        sens = await sensor.new_sensor(config[CONF_READ_DURATION])
+        cg.add(var.set_read_duration_sensor(sens))
+
+    if CONF_SPI_TRANSACTIONS in config:
+        sens = await sensor.new_sensor(config[CONF_SPI_TRANSACTIONS])
+        cg.add(var.set_spi_transactions_sensor(sens))
+
+    if CONF_FREE_HEAP in config:
+        sens = await sensor.new_sensor(config[CONF_FREE_HEAP])
+        cg.add(var.set_free_heap_sensor(sens))
+
+    if CONF_LARGEST_FREE_BLOCK in config:
+        sens = await sensor.new_sensor(config[CONF_LARGEST_FREE_BLOCK])
+        cg.add(var.set_largest_free_block_sensor(sens))
+
+    if CONF_HEAP_FRAGMENTATION in config:
+        sens = await sensor.new_sensor(config[CONF_HEAP_FRAGMENTATION])
+        cg.add(var.set_heap_fragmentation_sensor(sens))
+
+    if CONF_MIN_FREE_HEAP in config:
+        sens = await sensor.new_sensor(config[CONF_MIN_FREE_HEAP])
+        cg.add(var.set_min_free_heap_sensor(sens))
+
+    if CONF_STACK_FREE in config:
+        sens = await sensor.new_sensor(config[CONF_STACK_FREE])
+        cg.add(var.set_stack_free_sensor(sens))
+
+    if CONF_MAX_LOOP_BLOCK in config:
+        sens = await sensor.new_sensor(config[CONF_MAX_LOOP_BLOCK])
+        cg.add(var.set_max_loop_block_sensor(sens))
+
     if CONF_FREQUENCY_OFFSET in config:
         sens = await sensor.new_sensor(config[CONF_FREQUENCY_OFFSET])
         cg.add(var.set_frequency_offset_sensor(sens))
@@ -714,6 +856,18 @@ async def to_code(config):
         sens = await text_sensor.new_text_sensor(config[CONF_READING_TIME_UTC_SENSOR])
         cg.add(var.set_reading_time_utc_sensor(sens))
 
+    if CONF_READ_TIMELINE in config:
+        sens = await text_sensor.new_text_sensor(config[CONF_READ_TIMELINE])
+        cg.add(var.set_read_timeline_sensor(sens))
+
+    if CONF_SPI_STATS in config:
+        sens = await text_sensor.new_text_sensor(config[CONF_SPI_STATS])
+        cg.add(var.set_spi_stats_sensor(sens))
+
+    if CONF_RUNTIME_DIAGNOSTICS in config:
+        sens = await text_sensor.new_text_sensor(config[CONF_RUNTIME_DIAGNOSTICS])
+        cg.add(var.set_runtime_diagnostics_sensor(sens))
+
     # Register binary sensors
     if CONF_ACTIVE_READING in config:
         sens = await binary_sensor.new_binary_sensor(config[CONF_ACTIVE_READING])
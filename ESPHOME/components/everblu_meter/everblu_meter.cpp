@@ -12,6 +12,8 @@
 
 // Include CC1101 header for SPI device setup
 #include "cc1101.h"
+#include "utils.h"  // echo_debug_flush()
+#include "services/json_writer.h"
 namespace esphome {
 namespace everblu_meter {
 
@@ -37,6 +39,10 @@ static const char *const TAG = "everblu_meter";
 // low-noise DEBUG diagnostic that surfaces the (expected, bounded) block duration.
 static const uint32_t LOOP_BLOCK_WARN_MS = 30;
 
+// Heap and stack sensors are sampled and published this often, and after every
+// reported read (with the before/after read snapshots in the JSON sensor).
+static const uint32_t DIAGNOSTICS_PUBLISH_INTERVAL_MS = 60000;
+
 void EverbluMeterTriggerButton::press_action() {
   if (this->parent_ == nullptr) {
     ESP_LOGW(TAG, "Trigger button pressed but parent not set");
@@ -81,6 +87,10 @@ void EverbluMeterComponent::setup() {
   this->config_provider_->setUseAutoAlignMidpoint(this->auto_align_midpoint_);
   this->config_provider_->setMaxRetries(this->max_retries_);
   this->config_provider_->setRetryCooldownMs(this->retry_cooldown_ms_);
+  this->config_provider_->setReadCacheMaxAgeMs(this->read_cache_max_age_ms_);
+  this->config_provider_->setReadBudgetPerDay(this->read_budget_per_day_);
+  this->config_provider_->setReadBudgetBurst(this->read_budget_burst_);
+  this->config_provider_->setPublishFullRefreshMs(this->publish_full_refresh_ms_);
 
   // Create time provider
   if (this->time_component_ != nullptr) {
@@ -137,6 +147,14 @@ void EverbluMeterComponent::setup() {
   numeric += (this->successful_reads_sensor_ != nullptr);
   numeric += (this->failed_reads_sensor_ != nullptr);
   numeric += (this->frequency_offset_sensor_ != nullptr);
+  numeric += (this->read_duration_sensor_ != nullptr);
+  numeric += (this->spi_transactions_sensor_ != nullptr);
+  numeric += (this->free_heap_sensor_ != nullptr);
+  numeric += (this->largest_free_block_sensor_ != nullptr);
+  numeric += (this->heap_fragmentation_sensor_ != nullptr);
+  numeric += (this->min_free_heap_sensor_ != nullptr);
+  numeric += (this->stack_free_sensor_ != nullptr);
+  numeric += (this->max_loop_block_sensor_ != nullptr);
 
   int texts = 0;
   texts += (this->status_sensor_ != nullptr);
@@ -149,6 +167,9 @@ void EverbluMeterComponent::setup() {
   texts += (this->meter_year_sensor_ != nullptr);
   texts += (this->reading_schedule_sensor_ != nullptr);
   texts += (this->reading_time_utc_sensor_ != nullptr);
+  texts += (this->read_timeline_sensor_ != nullptr);
+  texts += (this->spi_stats_sensor_ != nullptr);
+  texts += (this->runtime_diagnostics_sensor_ != nullptr);
 
   int binaries = 0;
   binaries += (this->active_reading_sensor_ != nullptr);
@@ -245,6 +266,16 @@ void EverbluMeterComponent::republish_initial_states() {
 }
 
 void EverbluMeterComponent::loop() {
+  // Print any debug lines still deferred by a radio read (normally flushed
+  // as soon as the frame capture ends; a no-op when nothing is pending)
+  echo_debug_flush();
+
+  // Sensor updates staged by the last read go out a few per iteration, within
+  // the publisher's budget, instead of all at once after the radio block
+  if (this->data_publisher_ != nullptr && this->data_publisher_->hasPending()) {
+    this->data_publisher_->flushPending();
+  }
+
   // Let the meter reader handle its periodic tasks
   if (this->meter_reader_ != nullptr) {
     // Ensure this instance's SPI and GDO0 settings are active before any radio operations.
@@ -304,6 +335,7 @@ void EverbluMeterComponent::loop() {
     uint32_t loop_start = millis();
     this->meter_reader_->loop();
     uint32_t loop_elapsed = millis() - loop_start;
+    this->meter_reader_->getDiagnostics().recordLoop(loop_elapsed);
     if (loop_elapsed > LOOP_BLOCK_WARN_MS) {
       ESP_LOGD(TAG,
                "meter_reader loop blocked for %lu ms (ESPHome budget %lu ms); multi-second blocks are normal during an "
@@ -321,6 +353,82 @@ void EverbluMeterComponent::loop() {
       this->gdo2_timeouts_sensor_->publish_state(static_cast<float>(timeouts));
     }
   }
+
+  // Read latency percentiles and the SPI cost of the last read, refreshed once
+  // per committed (reported) read
+  const ReadTimeline &timeline = this->read_timeline_;
+  if (timeline.getCommitted() != this->last_read_timeline_published_) {
+    this->last_read_timeline_published_ = timeline.getCommitted();
+    this->publish_read_diagnostics(timeline);
+    this->publish_runtime_diagnostics();
+  } else if (this->meter_reader_ != nullptr &&
+             millis() - this->last_runtime_diagnostics_ms_ >= DIAGNOSTICS_PUBLISH_INTERVAL_MS) {
+    this->meter_reader_->getDiagnostics().sample();
+    this->publish_runtime_diagnostics();
+  }
+}
+
+void EverbluMeterComponent::publish_runtime_diagnostics() {
+  if (this->meter_reader_ == nullptr)
+    return;
+  this->last_runtime_diagnostics_ms_ = millis();
+  const RuntimeDiagnostics &diag = this->meter_reader_->getDiagnostics();
+  const MemorySnapshot &mem = diag.getLast();
+  if (this->free_heap_sensor_ != nullptr)
+    this->free_heap_sensor_->publish_state(static_cast<float>(mem.freeHeap));
+  if (this->largest_free_block_sensor_ != nullptr)
+    this->largest_free_block_sensor_->publish_state(static_cast<float>(mem.largestFreeBlock));
+  if (this->heap_fragmentation_sensor_ != nullptr)
+    this->heap_fragmentation_sensor_->publish_state(static_cast<float>(mem.fragmentationPct));
+  if (this->min_free_heap_sensor_ != nullptr)
+    this->min_free_heap_sensor_->publish_state(static_cast<float>(diag.getMinFreeHeap()));
+  if (this->stack_free_sensor_ != nullptr)
+    this->stack_free_sensor_->publish_state(static_cast<float>(diag.getMinStackFree()));
+  if (this->max_loop_block_sensor_ != nullptr)
+    this->max_loop_block_sensor_->publish_state(static_cast<float>(diag.getMaxLoopMs()));
+  if (this->runtime_diagnostics_sensor_ != nullptr) {
+    char json_buf[512];
+    JsonWriter json(json_buf, sizeof(json_buf));
+    diag.writeJson(json);
+    if (json.ok()) {
+      this->runtime_diagnostics_sensor_->publish_state(json_buf);
+    } else {
+      ESP_LOGW(TAG, "Runtime diagnostics JSON did not fit its buffer, not published");
+    }
+  }
+}
+
+void EverbluMeterComponent::publish_read_diagnostics(const ReadTimeline &timeline) {
+  if (this->read_duration_sensor_ != nullptr) {
+    this->read_duration_sensor_->publish_state(timeline.getTotalStats().p50Us / 1000.0f);
+  }
+  if (this->read_timeline_sensor_ != nullptr) {
+    char json_buf[640];
+    JsonWriter json(json_buf, sizeof(json_buf));
+    timeline.writeJson(json);
+    if (json.ok()) {
+      this->read_timeline_sensor_->publish_state(json_buf);
+    } else {
+      ESP_LOGW(TAG, "Read timeline JSON did not fit its buffer, not published");
+    }
+  }
+
+  const SpiStats &spi = this->spi_stats_;
+  ESP_LOGD(TAG, "SPI: %lu transactions, %lu us in transfers during the last read", (unsigned long) spi.totalCount(),
+           (unsigned long) spi.totalUs());
+  if (this->spi_transactions_sensor_ != nullptr) {
+    this->spi_transactions_sensor_->publish_state(static_cast<float>(spi.totalCount()));
+  }
+  if (this->spi_stats_sensor_ != nullptr) {
+    char json_buf[768];
+    JsonWriter json(json_buf, sizeof(json_buf));
+    spi.writeJson(json);
+    if (json.ok()) {
+      this->spi_stats_sensor_->publish_state(json_buf);
+    } else {
+      ESP_LOGW(TAG, "SPI stats JSON did not fit its buffer, not published");
+    }
+  }
 }
 
 void EverbluMeterComponent::request_manual_read() {
@@ -393,6 +501,9 @@ void EverbluMeterComponent::apply_radio_context() {
   // Apply RX attenuation (0 = default, no LNA limiting; 6/12/18 = reduce LNA gain
   // to prevent front-end saturation when mounted close to the meter).
   cc1101_set_rx_attenuation(this->rx_attenuation_db_);
+
+  // Record this meter's read timings and SPI traffic in its own statistics
+  cc1101_set_read_stats(&this->read_timeline_, &this->spi_stats_);
 }
 
 void EverbluMeterComponent::update() {
@@ -415,6 +526,9 @@ void EverbluMeterComponent::dump_config() {
                 "  Auto Align Midpoint: %s\n"
                 "  Max Retries: %d\n"
                 "  Retry Cooldown: %lu ms\n"
+                "  Read Cache Max Age: %lu ms\n"
+                "  Read Budget: %d per day, burst %d\n"
+                "  Publish Full Refresh: %lu ms\n"
                 "  Initial Read On Boot: %s\n"
                 "  GDO0 Pin: %s\n"
                 "  GDO2 Pin: %s",
@@ -423,6 +537,8 @@ void EverbluMeterComponent::dump_config() {
                 this->auto_scan_ ? "Enabled" : "Disabled", this->reading_schedule_.c_str(), this->read_hour_,
                 this->read_minute_, this->timezone_offset_, this->auto_align_time_ ? "Enabled" : "Disabled",
                 this->auto_align_midpoint_ ? "Enabled" : "Disabled", this->max_retries_, this->retry_cooldown_ms_,
+                this->read_cache_max_age_ms_, this->read_budget_per_day_, this->read_budget_burst_,
+                this->publish_full_refresh_ms_,
                 this->initial_read_on_boot_ ? "Enabled" : "Disabled",
                 this->gdo0_pin_ != nullptr ? "configured" : "NOT configured (error)",
                 this->gdo2_pin_ != nullptr ? "configured (HW FIFO threshold, TX+RX dynamic)"
@@ -445,11 +561,22 @@ void EverbluMeterComponent::dump_config() {
   LOG_SENSOR("    ", "Failed Reads", this->failed_reads_sensor_);
   LOG_SENSOR("    ", "Frequency Offset", this->frequency_offset_sensor_);
   LOG_SENSOR("    ", "Frequency Estimate", this->frequency_estimate_sensor_);
+  LOG_SENSOR("    ", "Read Duration", this->read_duration_sensor_);
+  LOG_SENSOR("    ", "SPI Transactions", this->spi_transactions_sensor_);
+  LOG_SENSOR("    ", "Free Heap", this->free_heap_sensor_);
+  LOG_SENSOR("    ", "Largest Free Block", this->largest_free_block_sensor_);
+  LOG_SENSOR("    ", "Heap Fragmentation", this->heap_fragmentation_sensor_);
+  LOG_SENSOR("    ", "Min Free Heap", this->min_free_heap_sensor_);
+  LOG_SENSOR("    ", "Stack Free", this->stack_free_sensor_);
+  LOG_SENSOR("    ", "Max Loop Block", this->max_loop_block_sensor_);
   LOG_TEXT_SENSOR("    ", "Status", this->status_sensor_);
   LOG_TEXT_SENSOR("    ", "Error", this->error_sensor_);
   LOG_TEXT_SENSOR("    ", "Radio State", this->radio_state_sensor_);
   LOG_TEXT_SENSOR("    ", "Timestamp", this->timestamp_sensor_);
   LOG_TEXT_SENSOR("    ", "History", this->history_sensor_);
+  LOG_TEXT_SENSOR("    ", "Read Timeline", this->read_timeline_sensor_);
+  LOG_TEXT_SENSOR("    ", "SPI Stats", this->spi_stats_sensor_);
+  LOG_TEXT_SENSOR("    ", "Runtime Diagnostics", this->runtime_diagnostics_sensor_);
   LOG_BINARY_SENSOR("    ", "Active Reading", this->active_reading_sensor_);
   LOG_BINARY_SENSOR("    ", "Radio Connected", this->radio_connected_sensor_);
 }
@@ -33,6 +33,8 @@
 // Include core meter reading components
 // These are in src/ subdirectory within the component
 #include "services/meter_reader.h"
+#include "services/read_timeline.h"
+#include "services/spi_stats.h"
 #include "adapters/implementations/esphome_config_provider.h"
 #include "adapters/implementations/esphome_time_provider.h"
 #include "adapters/implementations/esphome_data_publisher.h"
@@ -97,6 +99,10 @@ class EverbluMeterComponent final : public PollingComponent,
   void set_auto_align_midpoint(bool enabled) { this->auto_align_midpoint_ = enabled; }
   void set_max_retries(int retries) { this->max_retries_ = retries; }
   void set_retry_cooldown(unsigned long ms) { this->retry_cooldown_ms_ = ms; }
+  void set_read_cache_max_age(unsigned long ms) { this->read_cache_max_age_ms_ = ms; }
+  void set_read_budget_per_day(int per_day) { this->read_budget_per_day_ = per_day; }
+  void set_read_budget_burst(int burst) { this->read_budget_burst_ = burst; }
+  void set_publish_full_refresh(unsigned long ms) { this->publish_full_refresh_ms_ = ms; }
   void set_time_component(time::RealTimeClock *time) { this->time_component_ = time; }
   void set_initial_read_on_boot(bool v) { this->initial_read_on_boot_ = v; }
   void set_adaptive_threshold(int threshold) { this->adaptive_threshold_ = threshold; }
@@ -118,6 +124,14 @@ class EverbluMeterComponent final : public PollingComponent,
   void set_successful_reads_sensor(sensor::Sensor *sensor) { this->successful_reads_sensor_ = sensor; }
   void set_failed_reads_sensor(sensor::Sensor *sensor) { this->failed_reads_sensor_ = sensor; }
   void set_gdo2_timeouts_sensor(sensor::Sensor *sensor) { this->gdo2_timeouts_sensor_ = sensor; }
+  void set_read_duration_sensor(sensor::Sensor *sensor) { this->read_duration_sensor_ = sensor; }
+  void set_spi_transactions_sensor(sensor::Sensor *sensor) { this->spi_transactions_sensor_ = sensor; }
+  void set_free_heap_sensor(sensor::Sensor *sensor) { this->free_heap_sensor_ = sensor; }
+  void set_largest_free_block_sensor(sensor::Sensor *sensor) { this->largest_free_block_sensor_ = sensor; }
+  void set_heap_fragmentation_sensor(sensor::Sensor *sensor) { this->heap_fragmentation_sensor_ = sensor; }
+  void set_min_free_heap_sensor(sensor::Sensor *sensor) { this->min_free_heap_sensor_ = sensor; }
+  void set_stack_free_sensor(sensor::Sensor *sensor) { this->stack_free_sensor_ = sensor; }
+  void set_max_loop_block_sensor(sensor::Sensor *sensor) { this->max_loop_block_sensor_ = sensor; }
   void set_frequency_offset_sensor(sensor::Sensor *sensor) { this->frequency_offset_sensor_ = sensor; }
   void set_tuned_frequency_sensor(sensor::Sensor *sensor) { this->tuned_frequency_sensor_ = sensor; }
   void set_frequency_estimate_sensor(sensor::Sensor *sensor) { this->frequency_estimate_sensor_ = sensor; }
@@ -134,6 +148,9 @@ class EverbluMeterComponent final : public PollingComponent,
   void set_meter_model_sensor(text_sensor::TextSensor *sensor) { this->meter_model_sensor_ = sensor; }
   void set_reading_schedule_sensor(text_sensor::TextSensor *sensor) { this->reading_schedule_sensor_ = sensor; }
   void set_reading_time_utc_sensor(text_sensor::TextSensor *sensor) { this->reading_time_utc_sensor_ = sensor; }
+  void set_read_timeline_sensor(text_sensor::TextSensor *sensor) { this->read_timeline_sensor_ = sensor; }
+  void set_spi_stats_sensor(text_sensor::TextSensor *sensor) { this->spi_stats_sensor_ = sensor; }
+  void set_runtime_diagnostics_sensor(text_sensor::TextSensor *sensor) { this->runtime_diagnostics_sensor_ = sensor; }
 
   void set_active_reading_sensor(binary_sensor::BinarySensor *sensor) { this->active_reading_sensor_ = sensor; }
   void set_radio_connected_sensor(binary_sensor::BinarySensor *sensor) { this->radio_connected_sensor_ = sensor; }
@@ -162,6 +179,10 @@ class EverbluMeterComponent final : public PollingComponent,
   bool auto_align_midpoint_{true};
   int max_retries_{5};
   unsigned long retry_cooldown_ms_{3600000};
+  unsigned long read_cache_max_age_ms_{60000};
+  int read_budget_per_day_{24};
+  int read_budget_burst_{10};
+  unsigned long publish_full_refresh_ms_{3600000};
   int adaptive_threshold_{1};
   int rx_attenuation_db_{0};
 
@@ -169,6 +190,8 @@ class EverbluMeterComponent final : public PollingComponent,
   void publish_boot_states();
   void republish_initial_states();
   void apply_radio_context();
+  void publish_read_diagnostics(const ReadTimeline &timeline);
+  void publish_runtime_diagnostics();
   bool gdo0_error_logged_{false};  // One-shot flag to prevent log flooding
 
   // GDO0 pin (required) and GDO2 pin (optional TX FIFO threshold)
@@ -193,6 +216,20 @@ class EverbluMeterComponent final : public PollingComponent,
   sensor::Sensor *failed_reads_sensor_{nullptr};
   sensor::Sensor *gdo2_timeouts_sensor_{nullptr};
   uint32_t last_gdo2_timeouts_published_{0xFFFFFFFFu};  // sentinel: force first publish
+  sensor::Sensor *read_duration_sensor_{nullptr};
+  sensor::Sensor *spi_transactions_sensor_{nullptr};
+  sensor::Sensor *free_heap_sensor_{nullptr};
+  sensor::Sensor *largest_free_block_sensor_{nullptr};
+  sensor::Sensor *heap_fragmentation_sensor_{nullptr};
+  sensor::Sensor *min_free_heap_sensor_{nullptr};
+  sensor::Sensor *stack_free_sensor_{nullptr};
+  sensor::Sensor *max_loop_block_sensor_{nullptr};
+  uint32_t last_runtime_diagnostics_ms_{0};
+  // This meter's read timings and SPI counters, bound into the shared driver
+  // by apply_radio_context()
+  ReadTimeline read_timeline_;
+  SpiStats spi_stats_;
+  unsigned long last_read_timeline_published_{0};  // ReadTimeline::getCommitted() last published
   sensor::Sensor *frequency_offset_sensor_{nullptr};
   sensor::Sensor *tuned_frequency_sensor_{nullptr};
   sensor::Sensor *frequency_estimate_sensor_{nullptr};
@@ -209,6 +246,9 @@ class EverbluMeterComponent final : public PollingComponent,
   text_sensor::TextSensor *meter_model_sensor_{nullptr};
   text_sensor::TextSensor *reading_schedule_sensor_{nullptr};
   text_sensor::TextSensor *reading_time_utc_sensor_{nullptr};
+  text_sensor::TextSensor *read_timeline_sensor_{nullptr};
+  text_sensor::TextSensor *spi_stats_sensor_{nullptr};
+  text_sensor::TextSensor *runtime_diagnostics_sensor_{nullptr};
 
   binary_sensor::BinarySensor *active_reading_sensor_{nullptr};
   binary_sensor::BinarySensor *radio_connected_sensor_{nullptr};
@@ -45,6 +45,18 @@
 //
 #define ENABLE_HA_DISCOVERY 1
 
+// Consolidated MQTT state
+// Controls how each reading is published.
+//
+// 0 (default): One retained topic per value (liters, counter, battery, ...)
+//              plus the legacy /json summary
+// 1:           One retained JSON document on everblu/cyble/{serial}/state;
+//              discovery reads each entity from it with a value template, so
+//              a read is one publish instead of fifteen. Old per-value topics
+//              stay retained on the broker until you clear them.
+//
+#define MQTT_CONSOLIDATED_STATE 0
+
 // Meter number prefix in entity IDs
 // Controls whether the meter serial number is included as a prefix in MQTT entity IDs
 // and Home Assistant entity names. This is useful for distinguishing entities when
@@ -74,6 +86,7 @@
 //   "Monday-Saturday"
 //   "Monday-Sunday"
 //   "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday", "Sunday"
+//   "First-Monday".."Fourth-Sunday", "Last-Monday".."Last-Sunday" (once a month)
 // Invalid or missing values fall back to "Monday-Friday".
 #define DEFAULT_READING_SCHEDULE "Monday-Friday"
 
@@ -81,14 +94,16 @@
 #define DEFAULT_READING_HOUR_UTC 10
 #define DEFAULT_READING_MINUTE_UTC 0
 
-// Automatically align reading time to meter wake window
+// Automatically align reading time to meter wake window. Read outcomes are
+// recorded by hour (persisted), and after trying each hour of the window the
+// read settles on the hour where the meter answers first time most often.
 // 1 = enabled (recommended)
 // 0 = disabled
 #define AUTO_ALIGN_READING_TIME 1
 
-// Alignment strategy when auto-alignment is enabled
-// 0 = align to time_start
-// 1 = align to midpoint of [time_start, time_end]
+// Where auto-alignment starts exploring (and breaks ties)
+// 0 = time_start
+// 1 = midpoint of [time_start, time_end]
 #define AUTO_ALIGN_USE_MIDPOINT 0
 
 // ============================================================================
@@ -216,6 +231,11 @@
 // 0 = disable (default)
 #define DEBUG_CC1101 0
 
+// SPI transaction counters and latency histograms per read (published on
+// {base}/spi_stats). Each transaction costs two micros() calls; set to 0 to
+// measure the driver without them.
+// #define CC1101_SPI_STATS 0
+
 // Front-end RX input attenuation (dB)
 // Use this if the device is permanently mounted close to the meter (<0.5 m) and
 // near-field saturation causes CRC failures despite strong RSSI (e.g. flat −31 dBm
@@ -230,10 +250,55 @@
 // ============================================================================
 
 // Maximum number of retry attempts when reading fails
-// After this many failed attempts, the system enters a 1-hour cooldown period
+// Retries back off from about 5 s, doubling with random jitter. After this many
+// failed attempts the system enters a 1-hour cooldown, doubled for each further
+// failed session (up to 8 hours). Retries are skipped while the meter's wake
+// window is known to be closed, and a meter that missed 3 sessions in a row
+// only gets 2 attempts per session until it answers again.
 // Default: 5 retries
 #define MAX_RETRIES 5
 
+// Read cache for manual triggers
+// A "trigger" command within this many seconds of the last successful read keeps
+// that reading (already on the retained MQTT topics) instead of waking the meter,
+// which spends meter battery and bumps its reads counter. A trigger during a
+// retry sequence joins it. "trigger_force" always reads. 0 disables the cache.
+// Default: 60 seconds
+#define READ_CACHE_MAX_AGE_S 60
+
+// Read budget (protects the meter battery and our radio duty cycle)
+// Token bucket over meter interrogations: each read attempt (retries included)
+// costs 1 token, a frequency scan costs 5. Tokens refill at READ_BUDGET_PER_DAY
+// per day up to READ_BUDGET_BURST. Scheduled reads may spend the last tokens;
+// manual reads and scans must leave MAX_RETRIES tokens for the next scheduled
+// session. Set READ_BUDGET_PER_DAY to 0 to disable the limit.
+// Default: 24 per day, burst of 10
+#define READ_BUDGET_PER_DAY 24
+#define READ_BUDGET_BURST 10
+
+// Compact binary payload for a local ingester (not Home Assistant)
+// 1 also publishes each reading with its history as ~50 bytes on {base}/binary,
+// 2 publishes only that (no per-value topics, /json, /state or history JSON).
+// Decode with ReadingCodec::decode() from src/services/reading_codec.h.
+// Default: 0 (text topics only)
+#define MQTT_BINARY_PAYLOAD 0
+
+// Change-only publishing
+// A retained topic whose value has not changed since it was last published is
+// skipped (the broker still holds it). Everything is republished once per
+// PUBLISH_FULL_REFRESH_S and after every MQTT reconnect. 0 publishes every
+// value every time.
+// Default: 3600 seconds (1 hour)
+#define PUBLISH_FULL_REFRESH_S 3600
+
+// Store-and-forward for readings taken while Wi-Fi or the broker is down
+// Up to 8 readings are kept in RAM with their original timestamps and published,
+// oldest first, once the connection is back. Set PUBLISH_QUEUE_PERSIST to 1 to
+// also keep the newest 4 in flash so they survive the offline reboot
+// (ESP32 only; the ESP8266 storage slot is used by the read slot statistics).
+// Default: 0 (RAM only)
+#define PUBLISH_QUEUE_PERSIST 0
+
 // Adaptive frequency tracking threshold
 // Controls how many successful meter reads trigger an automatic frequency adjustment
 // based on the CC1101's FREQEST register (frequency error estimate)
@@ -263,6 +328,10 @@
 //
 // To use when enabled:
 //   telnet <device-ip> 23
+//
+// The output buffer (up to 8 KB) is taken from the heap only while a client is
+// connected. Build with -DWIFI_SERIAL_MAX_CLIENTS=3 to let up to 3 clients
+// watch at once (default 1: a new connection replaces the old one).
 #define WIFI_SERIAL_MONITOR_ENABLED 0
 #if WIFI_SERIAL_MONITOR_ENABLED
 #warning "WiFi serial monitor is ENABLED: meter readings may fail due to timing/compensation limits on the ESP"
@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+"""
+Report the flash and RAM saved by each compile-time log level.
+
+Builds one PlatformIO environment once per EVERBLU_LOG_LEVEL (5 VERBOSE down
+to 0 NONE, see src/core/logging.h) and prints the "RAM:" / "Flash:" usage
+PlatformIO reports after linking, with the saving against VERBOSE:
+
+  | Level   | Flash (bytes) | Saved | RAM (bytes) | Saved |
+  |---------|---------------|-------|-------------|-------|
+  | VERBOSE | ...           | 0     | ...         | 0     |
+  | DEBUG   | ...           | ...   | ...         | ...   |
+
+The extra flags are passed through PLATFORMIO_BUILD_FLAGS, so platformio.ini
+and include/private.h are left untouched. Each level is a full rebuild.
+
+Usage:
+  python scripts/log_level_size_report.py -e huzzah
+  python scripts/log_level_size_report.py -e esp32dev --tags EVERBLU_LOG_TAG_METER
+"""
+
+from __future__ import annotations
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+LEVELS = [
+    (5, "VERBOSE"),
+    (4, "DEBUG"),
+    (3, "INFO"),
+    (2, "WARN"),
+    (1, "ERROR"),
+    (0, "NONE"),
+]
+
+# PlatformIO's size summary after linking, e.g.
+# RAM:   [====      ]  38.9% (used <n> bytes from 81920 bytes)
+# Flash: [====      ]  41.5% (used <n> bytes from 1044464 bytes)
+USAGE_RE = re.compile(
+    r"^(RAM|Flash):.*\(used (\d+) bytes from (\d+) bytes\)", re.MULTILINE
+)
+
+
+def build(env_name: str, flags: list[str]) -> dict[str, int]:
+    run_env = dict(os.environ)
+    run_env["PLATFORMIO_BUILD_FLAGS"] = " ".join(
+        [run_env.get("PLATFORMIO_BUILD_FLAGS", ""), *flags]
+    ).strip()
+    result = subprocess.run(
+        ["pio", "run", "-e", env_name],
+        env=run_env,
+        capture_output=True,
+        text=True,
+        check=False,
+    )
+    if result.returncode != 0:
+        sys.stderr.write(result.stdout[-4000:] + result.stderr[-4000:])
+        raise RuntimeError(f"build failed for {' '.join(flags)}")
+    usage = {kind: int(used) for kind, used, _total in USAGE_RE.findall(result.stdout)}
+    if "RAM" not in usage or "Flash" not in usage:
+        raise RuntimeError("no RAM/Flash usage lines in the PlatformIO output")
+    return usage
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter
+    )
+    parser.add_argument(
+        "-e",
+        "--environment",
+        default="huzzah",
+        help="PlatformIO environment (default: %(default)s)",
+    )
+    parser.add_argument(
+        "--tags",
+        help="EVERBLU_LOG_TAGS mask for every build, e.g. EVERBLU_LOG_TAG_METER or 0x09",
+    )
+    args = parser.parse_args()
+
+    extra = [f"-DEVERBLU_LOG_TAGS={args.tags}"] if args.tags else []
+    rows = []
+    for level, name in LEVELS:
+        print(
+            f"Building {args.environment} with EVERBLU_LOG_LEVEL={level} ({name})...",
+            file=sys.stderr,
+        )
+        rows.append(
+            (name, build(args.environment, [f"-DEVERBLU_LOG_LEVEL={level}", *extra]))
+        )
+
+    base = rows[0][1]
+    print("| Level   | Flash (bytes) | Saved | RAM (bytes) | Saved |")
+    print("|---------|---------------|-------|-------------|-------|")
+    for name, usage in rows:
+        print(
+            f"| {name:<7} | {usage['Flash']:>13} | {base['Flash'] - usage['Flash']:>5} | {usage['RAM']:>11} | {base['RAM'] - usage['RAM']:>5} |"
+        )
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
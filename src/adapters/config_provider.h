@@ -51,6 +51,16 @@ public:
     virtual int getMaxRetries() const = 0;
     virtual unsigned long getRetryCooldownMs() const = 0;
 
+    // Read cache: manual triggers within this age of the last good read reuse it (0 = always read)
+    virtual unsigned long getReadCacheMaxAgeMs() const = 0;
+
+    // Read budget: token bucket over read attempts and scans (perDay 0 = unlimited)
+    virtual int getReadBudgetPerDay() const = 0;
+    virtual int getReadBudgetBurst() const = 0;
+
+    // Change-only publishing: unchanged values are republished at this interval (0 = always publish)
+    virtual unsigned long getPublishFullRefreshMs() const = 0;
+
     // Network configuration (for standalone mode)
     virtual const char *getWiFiSSID() const = 0;
     virtual const char *getWiFiPassword() const = 0;
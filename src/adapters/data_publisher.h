@@ -19,6 +19,33 @@
 #include "../core/cc1101.h"
 #include <stdint.h>
 
+/**
+ * @struct ReadingSnapshot
+ * @brief Everything a successful read produced, published in one call
+ *
+ * Built once per read by MeterReader and handed to the backend as a whole,
+ * so a backend can batch, diff and serialise it in one pass. The snapshot
+ * only lives for the duration of publishSnapshot(); copy what must be kept.
+ */
+struct ReadingSnapshot
+{
+    const tmeter_data &reading; // Reading, history, radio quality and FREQEST
+    const char *timestamp;      // ISO8601 UTC time of the read
+
+    // Read statistics, including this read
+    unsigned long totalAttempts;
+    unsigned long successfulReads;
+    unsigned long failedReads;
+
+    // Frequency state after this read's adaptive correction
+    float frequencyOffsetMHz;
+    float tunedFrequencyMHz;
+
+    // What differs from the last published values (false: the backend may skip it)
+    bool historyChanged;
+    bool frequencyChanged;
+};
+
 /**
  * @class IDataPublisher
  * @brief Abstract interface for publishing meter data and status
@@ -32,18 +59,15 @@ public:
     virtual ~IDataPublisher() = default;
 
     /**
-     * @brief Publish complete meter reading
-     * @param data Meter data structure with all readings
-     * @param timestamp ISO8601 timestamp string
-     */
-    virtual void publishMeterReading(const tmeter_data &data, const char *timestamp) = 0;
-
-    /**
-     * @brief Publish meter historical data
-     * @param history Array of 13 monthly readings
-     * @param historyAvailable Whether history was successfully decoded
+     * @brief Publish the results of a successful read
+     *
+     * Covers the reading, its history, radio quality, read statistics and
+     * frequency state. History (when available) and frequency state should
+     * be published when flagged as changed and may be skipped otherwise.
+     *
+     * @param snapshot Values of the read, valid for the duration of the call
      */
-    virtual void publishHistory(const uint32_t *history, bool historyAvailable) = 0;
+    virtual void publishSnapshot(const ReadingSnapshot &snapshot) = 0;
 
     /**
      * @brief Publish WiFi connection details
@@ -114,12 +138,6 @@ public:
      */
     virtual void publishTunedFrequency(float frequencyMHz) = 0;
 
-    /**
-     * @brief Publish frequency estimate from CC1101
-     * @param freqestValue Raw FREQEST value from meter reading (-128 to +127)
-     */
-    virtual void publishFrequencyEstimate(int8_t freqestValue) = 0;
-
     /**
      * @brief Publish uptime
      * @param uptimeSeconds System uptime in seconds
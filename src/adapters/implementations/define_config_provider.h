@@ -164,6 +164,45 @@ public:
                 return 3600000; // 1 hour
         }
 
+        // Read cache
+        unsigned long getReadCacheMaxAgeMs() const override
+        {
+#ifdef READ_CACHE_MAX_AGE_S
+                return (unsigned long)READ_CACHE_MAX_AGE_S * 1000UL;
+#else
+                return 60000; // 1 minute
+#endif
+        }
+
+        // Read budget
+        int getReadBudgetPerDay() const override
+        {
+#ifdef READ_BUDGET_PER_DAY
+                return READ_BUDGET_PER_DAY;
+#else
+                return 24;
+#endif
+        }
+
+        int getReadBudgetBurst() const override
+        {
+#ifdef READ_BUDGET_BURST
+                return READ_BUDGET_BURST;
+#else
+                return 10;
+#endif
+        }
+
+        // Change-only publishing
+        unsigned long getPublishFullRefreshMs() const override
+        {
+#ifdef PUBLISH_FULL_REFRESH_S
+                return (unsigned long)PUBLISH_FULL_REFRESH_S * 1000UL;
+#else
+                return 3600000; // 1 hour
+#endif
+        }
+
         // Network configuration (for standalone mode)
         const char *getWiFiSSID() const override { return SECRET_WIFI_SSID; }
         const char *getWiFiPassword() const override { return SECRET_WIFI_PASSWORD; }
@@ -231,6 +270,10 @@ public:
         bool useAutoAlignMidpoint() const override { return true; }
         int getMaxRetries() const override { return 5; }
         unsigned long getRetryCooldownMs() const override { return 3600000; }
+        unsigned long getReadCacheMaxAgeMs() const override { return 60000; }
+        int getReadBudgetPerDay() const override { return 24; }
+        int getReadBudgetBurst() const override { return 10; }
+        unsigned long getPublishFullRefreshMs() const override { return 3600000; }
         const char *getWiFiSSID() const override { return ""; }
         const char *getWiFiPassword() const override { return ""; }
         const char *getMqttServer() const override { return ""; }
@@ -46,6 +46,10 @@ public:
     void setUseAutoAlignMidpoint(bool enabled) { auto_align_midpoint_ = enabled; }
     void setMaxRetries(int retries) { max_retries_ = retries; }
     void setRetryCooldownMs(unsigned long ms) { retry_cooldown_ms_ = ms; }
+    void setReadCacheMaxAgeMs(unsigned long ms) { read_cache_max_age_ms_ = ms; }
+    void setReadBudgetPerDay(int perDay) { read_budget_per_day_ = perDay; }
+    void setReadBudgetBurst(int burst) { read_budget_burst_ = burst; }
+    void setPublishFullRefreshMs(unsigned long ms) { publish_full_refresh_ms_ = ms; }
 
     // IConfigProvider interface implementation
     uint8_t getMeterYear() const override { return meter_year_; }
@@ -63,6 +67,10 @@ public:
     bool useAutoAlignMidpoint() const override { return auto_align_midpoint_; }
     int getMaxRetries() const override { return max_retries_; }
     unsigned long getRetryCooldownMs() const override { return retry_cooldown_ms_; }
+    unsigned long getReadCacheMaxAgeMs() const override { return read_cache_max_age_ms_; }
+    int getReadBudgetPerDay() const override { return read_budget_per_day_; }
+    int getReadBudgetBurst() const override { return read_budget_burst_; }
+    unsigned long getPublishFullRefreshMs() const override { return publish_full_refresh_ms_; }
 
     // Network configuration - Not applicable in ESPHome
     // ESPHome handles WiFi/MQTT/network connectivity through its core
@@ -97,6 +105,16 @@ private:
     // Retry configuration
     int max_retries_{5};
     unsigned long retry_cooldown_ms_{3600000}; // 1 hour
+
+    // Read cache
+    unsigned long read_cache_max_age_ms_{60000}; // 1 minute
+
+    // Read budget
+    int read_budget_per_day_{24};
+    int read_budget_burst_{10};
+
+    // Change-only publishing
+    unsigned long publish_full_refresh_ms_{3600000}; // 1 hour
 };
 
 #endif // ESPHOME_CONFIG_PROVIDER_H
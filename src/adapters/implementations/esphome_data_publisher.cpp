@@ -28,125 +28,255 @@ ESPHomeDataPublisher::ESPHomeDataPublisher()
 {
 }
 
-void ESPHomeDataPublisher::publishMeterReading(const tmeter_data &data, const char *timestamp)
+void ESPHomeDataPublisher::publishSnapshot(const ReadingSnapshot &snapshot)
 {
-#ifdef USE_ESPHOME
-    ESP_LOGD(TAG_PUB, "Publishing meter reading: volume=%lu, battery=%.1f, counter=%lu", (unsigned long)data.volume, (double)data.battery_left, (unsigned long)data.reads_counter);
-    have_last_volume_ = true;
-    last_volume_ = data.volume;
-    // Publish main meter reading
-    if (volume_sensor_)
-    {
-        volume_sensor_->publish_state(data.volume);
-    }
+    const tmeter_data &data = snapshot.reading;
+    publishMeterReading(data, snapshot.timestamp);
 
-    if (battery_sensor_)
+    // History only changes once a month; its JSON includes the current month's usage
+    if (data.history_available && snapshot.historyChanged)
     {
-        battery_sensor_->publish_state(data.battery_left);
+        publishHistory(data.history, static_cast<uint32_t>(data.volume));
     }
 
-    if (counter_sensor_)
-    {
-        counter_sensor_->publish_state(data.reads_counter);
-    }
-
-    // Signal quality metrics
-    if (rssi_sensor_)
-    {
-        rssi_sensor_->publish_state(data.rssi_dbm);
-    }
+    publishStatistics(snapshot.totalAttempts, snapshot.successfulReads, snapshot.failedReads);
 
-    if (rssi_percentage_sensor_)
+    if (snapshot.frequencyChanged)
     {
-        rssi_percentage_sensor_->publish_state(calculateRssiPercentage(data.rssi_dbm));
+        publishFrequencyOffset(snapshot.frequencyOffsetMHz);
+        publishTunedFrequency(snapshot.tunedFrequencyMHz);
     }
+}
 
-    if (lqi_sensor_)
-    {
-        lqi_sensor_->publish_state(data.lqi);
-    }
+void ESPHomeDataPublisher::publishMeterReading(const tmeter_data &data, const char *timestamp)
+{
+#ifdef USE_ESPHOME
+    ESP_LOGD(TAG_PUB, "Staging meter reading: volume=%lu, battery=%.1f, counter=%lu", (unsigned long)data.volume, (double)data.battery_left, (unsigned long)data.reads_counter);
+#endif
+    // Main meter reading first: it is what Home Assistant is waiting for
+    stage(SLOT_VOLUME, data.volume);
+    stage(SLOT_BATTERY, data.battery_left);
+    stage(SLOT_COUNTER, data.reads_counter);
 
-    if (lqi_percentage_sensor_)
-    {
-        lqi_percentage_sensor_->publish_state(calculateLqiPercentage(data.lqi));
-    }
+    // Signal quality metrics
+    stage(SLOT_RSSI, data.rssi_dbm);
+    stage(SLOT_RSSI_PERCENTAGE, calculateRssiPercentage(data.rssi_dbm));
+    stage(SLOT_LQI, data.lqi);
+    stage(SLOT_LQI_PERCENTAGE, calculateLqiPercentage(data.lqi));
 
     // Wake window times (formatted as HH:MM)
-    if (time_start_sensor_)
-    {
-        char time_start_str[6];
-        snprintf(time_start_str, sizeof(time_start_str), "%02d:00", data.time_start);
-        time_start_sensor_->publish_state(time_start_str);
-    }
-
-    if (time_end_sensor_)
-    {
-        char time_end_str[6];
-        snprintf(time_end_str, sizeof(time_end_str), "%02d:00", data.time_end);
-        time_end_sensor_->publish_state(time_end_str);
-    }
+    char hour[6];
+    snprintf(hour, sizeof(hour), "%02d:00", data.time_start);
+    stageText(SLOT_TIME_START, pending_time_start_, sizeof(pending_time_start_), hour);
+    snprintf(hour, sizeof(hour), "%02d:00", data.time_end);
+    stageText(SLOT_TIME_END, pending_time_end_, sizeof(pending_time_end_), hour);
 
     // Timestamp
-    if (timestamp_sensor_ && timestamp)
+    if (timestamp)
     {
-        timestamp_sensor_->publish_state(timestamp);
+        stageText(SLOT_TIMESTAMP, pending_timestamp_, sizeof(pending_timestamp_), timestamp);
     }
 
     // Meter's own real-time clock and type/identifier string (decoded from the
     // frame). Only published when present so an unset clock stays "unknown".
-    if (meter_clock_sensor_ && data.meter_time[0] != '\0')
+    if (data.meter_time[0] != '\0')
     {
-        meter_clock_sensor_->publish_state(data.meter_time);
+        stageText(SLOT_METER_CLOCK, pending_meter_clock_, sizeof(pending_meter_clock_), data.meter_time);
     }
-
-    if (meter_model_sensor_ && data.meter_type[0] != '\0')
+    if (data.meter_type[0] != '\0')
     {
-        meter_model_sensor_->publish_state(data.meter_type);
+        stageText(SLOT_METER_MODEL, pending_meter_model_, sizeof(pending_meter_model_), data.meter_type);
     }
 
     // Frequency estimate from CC1101
-    if (frequency_estimate_sensor_)
-    {
-        publishFrequencyEstimate(data.freqest);
-    }
-#endif
+    publishFrequencyEstimate(data.freqest);
 }
 
-void ESPHomeDataPublisher::publishHistory(const uint32_t *history, bool historyAvailable)
+void ESPHomeDataPublisher::publishHistory(const uint32_t *history, uint32_t currentVolume)
 {
-#ifdef USE_ESPHOME
-    if (!history_sensor_)
+    // The JSON is rendered when the slot is flushed, and only again when the
+    // history or current volume changed
+    if (hasSensor(SLOT_HISTORY))
     {
-        return; // Not configured
+        history_model_.build(history, currentVolume);
+        pending_ |= 1UL << SLOT_HISTORY;
     }
+}
 
-    if (!historyAvailable || history == nullptr)
+void ESPHomeDataPublisher::stage(PendingSlot slot, float value)
+{
+    if (hasSensor(slot))
     {
-        history_sensor_->publish_state("unavailable");
-        return;
+        pending_values_[slot] = value;
+        pending_ |= 1UL << slot;
     }
+}
 
-    // Build a JSON payload matching the legacy MQTT attributes
-    char history_json[512];
-    const uint32_t current_volume = have_last_volume_ ? last_volume_ : 0;
-    int written = MeterHistory::generateHistoryJson(history, current_volume, history_json, sizeof(history_json));
-
-    if (written <= 0)
+void ESPHomeDataPublisher::stageText(PendingSlot slot, char *buffer, size_t size, const char *text)
+{
+    if (hasSensor(slot))
     {
-        ESP_LOGW(TAG_PUB, "History JSON generation failed (buffer=%u)", (unsigned)sizeof(history_json));
-        history_sensor_->publish_state("unavailable");
-        return;
+        snprintf(buffer, size, "%s", text);
+        pending_ |= 1UL << slot;
     }
+}
+
+bool ESPHomeDataPublisher::flushPending(uint32_t budgetUs)
+{
+    const uint32_t start = micros();
+    while (pending_ != 0)
+    {
+        // Lowest pending slot is the highest priority
+        uint8_t slot = 0;
+        while (!(pending_ & (1UL << slot)))
+        {
+            slot++;
+        }
+        pending_ &= ~(1UL << slot);
+        publishSlot(static_cast<PendingSlot>(slot));
+
+        if (micros() - start >= budgetUs)
+        {
+            break;
+        }
+    }
+    return pending_ == 0;
+}
 
-    ESP_LOGD(TAG_PUB, "Publishing history JSON (%d bytes)", written);
-    history_sensor_->publish_state(history_json);
+bool ESPHomeDataPublisher::hasSensor(PendingSlot slot) const
+{
+#ifdef USE_ESPHOME
+    switch (slot)
+    {
+    case SLOT_VOLUME:
+        return volume_sensor_ != nullptr;
+    case SLOT_TIMESTAMP:
+        return timestamp_sensor_ != nullptr;
+    case SLOT_COUNTER:
+        return counter_sensor_ != nullptr;
+    case SLOT_BATTERY:
+        return battery_sensor_ != nullptr;
+    case SLOT_RSSI:
+        return rssi_sensor_ != nullptr;
+    case SLOT_RSSI_PERCENTAGE:
+        return rssi_percentage_sensor_ != nullptr;
+    case SLOT_LQI:
+        return lqi_sensor_ != nullptr;
+    case SLOT_LQI_PERCENTAGE:
+        return lqi_percentage_sensor_ != nullptr;
+    case SLOT_TIME_START:
+        return time_start_sensor_ != nullptr;
+    case SLOT_TIME_END:
+        return time_end_sensor_ != nullptr;
+    case SLOT_METER_CLOCK:
+        return meter_clock_sensor_ != nullptr;
+    case SLOT_METER_MODEL:
+        return meter_model_sensor_ != nullptr;
+    case SLOT_FREQUENCY_ESTIMATE:
+        return frequency_estimate_sensor_ != nullptr;
+    case SLOT_TOTAL_ATTEMPTS:
+        return total_attempts_sensor_ != nullptr;
+    case SLOT_SUCCESSFUL_READS:
+        return successful_reads_sensor_ != nullptr;
+    case SLOT_FAILED_READS:
+        return failed_reads_sensor_ != nullptr;
+    case SLOT_FREQUENCY_OFFSET:
+        return frequency_offset_sensor_ != nullptr;
+    case SLOT_TUNED_FREQUENCY:
+        return tuned_frequency_sensor_ != nullptr;
+    case SLOT_HISTORY:
+        return history_sensor_ != nullptr;
+    default:
+        return false;
+    }
+#else
+    (void)slot;
+    return false;
+#endif
+}
 
-    // Mirror the legacy serial dump so users can see history in ESPHome logs
-    const int month_count = MeterHistory::countValidMonths(history);
-    if (month_count > 0)
-    {
-        MeterHistory::printToSerial(history, current_volume, "[HISTORY]");
-    }
+void ESPHomeDataPublisher::publishSlot(PendingSlot slot)
+{
+#ifdef USE_ESPHOME
+    const float value = pending_values_[slot];
+    switch (slot)
+    {
+    case SLOT_VOLUME:
+        volume_sensor_->publish_state(value);
+        break;
+    case SLOT_TIMESTAMP:
+        timestamp_sensor_->publish_state(pending_timestamp_);
+        break;
+    case SLOT_COUNTER:
+        counter_sensor_->publish_state(value);
+        break;
+    case SLOT_BATTERY:
+        battery_sensor_->publish_state(value);
+        break;
+    case SLOT_RSSI:
+        rssi_sensor_->publish_state(value);
+        break;
+    case SLOT_RSSI_PERCENTAGE:
+        rssi_percentage_sensor_->publish_state(value);
+        break;
+    case SLOT_LQI:
+        lqi_sensor_->publish_state(value);
+        break;
+    case SLOT_LQI_PERCENTAGE:
+        lqi_percentage_sensor_->publish_state(value);
+        break;
+    case SLOT_TIME_START:
+        time_start_sensor_->publish_state(pending_time_start_);
+        break;
+    case SLOT_TIME_END:
+        time_end_sensor_->publish_state(pending_time_end_);
+        break;
+    case SLOT_METER_CLOCK:
+        meter_clock_sensor_->publish_state(pending_meter_clock_);
+        break;
+    case SLOT_METER_MODEL:
+        meter_model_sensor_->publish_state(pending_meter_model_);
+        break;
+    case SLOT_FREQUENCY_ESTIMATE:
+        frequency_estimate_sensor_->publish_state(value);
+        break;
+    case SLOT_TOTAL_ATTEMPTS:
+        total_attempts_sensor_->publish_state(value);
+        break;
+    case SLOT_SUCCESSFUL_READS:
+        successful_reads_sensor_->publish_state(value);
+        break;
+    case SLOT_FAILED_READS:
+        failed_reads_sensor_->publish_state(value);
+        break;
+    case SLOT_FREQUENCY_OFFSET:
+        frequency_offset_sensor_->publish_state(value);
+        break;
+    case SLOT_TUNED_FREQUENCY:
+        tuned_frequency_sensor_->publish_state(value);
+        break;
+    case SLOT_HISTORY:
+    {
+        // Build a JSON payload matching the legacy MQTT attributes
+        const int written = history_model_.jsonLength();
+        if (written <= 0)
+        {
+            ESP_LOGW(TAG_PUB, "History JSON generation failed (buffer=%u)", (unsigned)HistoryModel::JSON_BUFFER_SIZE);
+            history_sensor_->publish_state("unavailable");
+            break;
+        }
+        ESP_LOGD(TAG_PUB, "Publishing history JSON (%d bytes)", written);
+        history_sensor_->publish_state(history_model_.json());
+
+        // Mirror the legacy serial dump so users can see history in ESPHome logs
+        history_model_.printToSerial("[HISTORY]");
+        break;
+    }
+    default:
+        break;
+    }
+#else
+    (void)slot;
 #endif
 }
 
@@ -272,62 +402,41 @@ void ESPHomeDataPublisher::publishStatistics(unsigned long totalAttempts, unsign
                                              unsigned long failedReads)
 {
 #ifdef USE_ESPHOME
-    ESP_LOGD(TAG_PUB, "Publishing stats: total=%lu success=%lu failed=%lu", totalAttempts, successfulReads, failedReads);
-
-    if (total_attempts_sensor_)
-    {
-        total_attempts_sensor_->publish_state(totalAttempts);
-    }
-
-    if (successful_reads_sensor_)
-    {
-        successful_reads_sensor_->publish_state(successfulReads);
-    }
-
-    if (failed_reads_sensor_)
-    {
-        failed_reads_sensor_->publish_state(failedReads);
-    }
+    ESP_LOGD(TAG_PUB, "Staging stats: total=%lu success=%lu failed=%lu", totalAttempts, successfulReads, failedReads);
 #endif
+    stage(SLOT_TOTAL_ATTEMPTS, totalAttempts);
+    stage(SLOT_SUCCESSFUL_READS, successfulReads);
+    stage(SLOT_FAILED_READS, failedReads);
 }
 
 void ESPHomeDataPublisher::publishFrequencyOffset(float offsetMHz)
 {
+    // Convert MHz to kHz like MQTT version
+    const float offsetKHz = offsetMHz * 1000.0f;
 #ifdef USE_ESPHOME
-    if (frequency_offset_sensor_)
-    {
-        // Convert MHz to kHz like MQTT version
-        float offsetKHz = offsetMHz * 1000.0f;
-        ESP_LOGD(TAG_PUB, "Publishing frequency offset: %.3f kHz", offsetKHz);
-        frequency_offset_sensor_->publish_state(offsetKHz);
-    }
+    ESP_LOGD(TAG_PUB, "Staging frequency offset: %.3f kHz", offsetKHz);
 #endif
+    stage(SLOT_FREQUENCY_OFFSET, offsetKHz);
 }
 
 void ESPHomeDataPublisher::publishTunedFrequency(float frequencyMHz)
 {
+    // Published in MHz with high precision (6 decimal places = kHz resolution)
 #ifdef USE_ESPHOME
-    if (tuned_frequency_sensor_)
-    {
-        // Publish in MHz with high precision (6 decimal places = kHz resolution)
-        ESP_LOGD(TAG_PUB, "Publishing tuned frequency: %.6f MHz", frequencyMHz);
-        tuned_frequency_sensor_->publish_state(frequencyMHz);
-    }
+    ESP_LOGD(TAG_PUB, "Staging tuned frequency: %.6f MHz", frequencyMHz);
 #endif
+    stage(SLOT_TUNED_FREQUENCY, frequencyMHz);
 }
 
 void ESPHomeDataPublisher::publishFrequencyEstimate(int8_t freqestValue)
 {
+    // Convert FREQEST raw value to kHz (approximately 1.59 kHz per LSB with 26 MHz crystal)
+    constexpr float FREQEST_TO_KHZ = 1.587; // ~1.59 kHz per LSB
+    const float freqestKHz = (float)freqestValue * FREQEST_TO_KHZ;
 #ifdef USE_ESPHOME
-    if (frequency_estimate_sensor_)
-    {
-        // Convert FREQEST raw value to kHz (approximately 1.59 kHz per LSB with 26 MHz crystal)
-        constexpr float FREQEST_TO_KHZ = 1.587; // ~1.59 kHz per LSB
-        float freqestKHz = (float)freqestValue * FREQEST_TO_KHZ;
-        ESP_LOGD(TAG_PUB, "Publishing frequency estimate: %d (%.3f kHz)", freqestValue, freqestKHz);
-        frequency_estimate_sensor_->publish_state(freqestKHz);
-    }
+    ESP_LOGD(TAG_PUB, "Staging frequency estimate: %d (%.3f kHz)", freqestValue, freqestKHz);
 #endif
+    stage(SLOT_FREQUENCY_ESTIMATE, freqestKHz);
 }
 
 void ESPHomeDataPublisher::publishUptime(unsigned long uptimeSeconds, const char *uptimeISO)
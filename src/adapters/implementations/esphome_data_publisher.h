@@ -10,6 +10,7 @@
 #define ESPHOME_DATA_PUBLISHER_H
 
 #include "../data_publisher.h"
+#include "../../services/meter_history.h"
 
 // Forward declarations for ESPHome components
 // These will be available when compiled in ESPHome environment
@@ -43,6 +44,14 @@ namespace esphome
  * - No JSON serialization
  * - No Home Assistant discovery messages
  * - Just update sensor states
+ *
+ * A read's sensor updates (reading, history, statistics, frequency) are staged
+ * rather than published at once: each publish_state() triggers API and log
+ * traffic, and a read has just blocked the loop for seconds. The component
+ * calls flushPending() from every loop() to publish them in priority order
+ * (volume first) within a per-iteration time budget. A sensor staged again
+ * before it was flushed is published once, with the newest value. Status,
+ * error and active-reading updates are still published immediately.
  */
 class ESPHomeDataPublisher : public IDataPublisher
 {
@@ -123,8 +132,7 @@ public:
 #endif
 
     // IDataPublisher interface implementation
-    void publishMeterReading(const tmeter_data &data, const char *timestamp) override;
-    void publishHistory(const uint32_t *history, bool historyAvailable) override;
+    void publishSnapshot(const ReadingSnapshot &snapshot) override;
     void publishWiFiDetails(const char *ip, int rssi, int signalPercent,
                             const char *mac, const char *ssid, const char *bssid) override;
     void publishMeterSettings(int meterYear, unsigned long meterSerial,
@@ -138,12 +146,28 @@ public:
                            unsigned long failedReads) override;
     void publishFrequencyOffset(float offsetMHz) override;
     void publishTunedFrequency(float frequencyMHz) override;
-    void publishFrequencyEstimate(int8_t freqestValue) override;
     void publishUptime(unsigned long uptimeSeconds, const char *uptimeISO) override;
     void publishFirmwareVersion(const char *version) override;
     void publishDiscovery() override;
     bool isReady() const override;
 
+    /// Per-iteration budget for flushPending(), well inside ESPHome's 30 ms loop guideline
+    static constexpr uint32_t FLUSH_BUDGET_US = 10000;
+
+    /**
+     * @brief Publish staged sensor updates, highest priority first
+     *
+     * At least one update is published per call; the rest wait for the next
+     * call once budgetUs has been used.
+     *
+     * @param budgetUs Time budget in microseconds
+     * @return true if nothing is left pending
+     */
+    bool flushPending(uint32_t budgetUs = FLUSH_BUDGET_US);
+
+    /// Staged updates not yet published
+    bool hasPending() const { return pending_ != 0; }
+
 private:
 #ifdef USE_ESPHOME
     // Numeric sensors
@@ -191,13 +215,51 @@ private:
     static esphome::binary_sensor::BinarySensor *radio_connected_sensor_;
 #endif
 
+    // Last history published, with its statistics and rendered JSON
+    HistoryModel history_model_;
+
+    // Staged sensor updates, in publish order (lowest slot first)
+    enum PendingSlot : uint8_t
+    {
+        SLOT_VOLUME,
+        SLOT_TIMESTAMP,
+        SLOT_COUNTER,
+        SLOT_BATTERY,
+        SLOT_RSSI,
+        SLOT_RSSI_PERCENTAGE,
+        SLOT_LQI,
+        SLOT_LQI_PERCENTAGE,
+        SLOT_TIME_START,
+        SLOT_TIME_END,
+        SLOT_METER_CLOCK,
+        SLOT_METER_MODEL,
+        SLOT_FREQUENCY_ESTIMATE,
+        SLOT_TOTAL_ATTEMPTS,
+        SLOT_SUCCESSFUL_READS,
+        SLOT_FAILED_READS,
+        SLOT_FREQUENCY_OFFSET,
+        SLOT_TUNED_FREQUENCY,
+        SLOT_HISTORY,
+        SLOT_COUNT
+    };
+    uint32_t pending_{0};                // Bit per PendingSlot
+    float pending_values_[SLOT_COUNT]{}; // Numeric slots
+    char pending_timestamp_[32]{};
+    char pending_time_start_[6]{};
+    char pending_time_end_[6]{};
+    char pending_meter_clock_[32]{};
+    char pending_meter_model_[12]{};
+
     // Helper methods
+    void stage(PendingSlot slot, float value);
+    void stageText(PendingSlot slot, char *buffer, size_t size, const char *text);
+    bool hasSensor(PendingSlot slot) const;
+    void publishSlot(PendingSlot slot);
+    void publishMeterReading(const tmeter_data &data, const char *timestamp);
+    void publishHistory(const uint32_t *history, uint32_t currentVolume);
+    void publishFrequencyEstimate(int8_t freqestValue);
     int calculateRssiPercentage(int rssi_dbm) const;
     int calculateLqiPercentage(int lqi) const;
-
-    // Cache last volume so history JSON can include current month usage
-    uint32_t last_volume_{0};
-    bool have_last_volume_{false};
 };
 
 #endif // ESPHOME_DATA_PUBLISHER_H
@@ -4,6 +4,11 @@
  *
  * This is the implementation for standalone mode that uses
  * the ESP8266/ESP32 NTP client for time synchronization.
+ *
+ * Synchronization is asynchronous: begin() and requestSync() only start the
+ * SNTP client and return, and isTimeSynced() reports when the clock has been
+ * set. Callers poll it instead of waiting, so the main loop (MQTT keepalive,
+ * OTA) keeps running while NTP answers.
  */
 
 #ifndef NTP_TIME_PROVIDER_H
@@ -25,7 +30,7 @@ public:
     ~NTPTimeProvider() override = default;
 
     /**
-     * @brief Initialize NTP client with server
+     * @brief Initialize NTP client with server and start a sync (non-blocking)
      * @param ntpServer NTP server hostname or IP
      */
     void begin(const char *ntpServer);
@@ -35,13 +40,15 @@ public:
     time_t getCurrentTime() const override;
     void requestSync() override;
 
+    /// millis() when the last sync was requested
+    unsigned long getLastSyncAttempt() const { return m_lastSyncAttempt; }
+
 private:
-    bool m_synced;
+    mutable bool m_synced; // Set on the first valid clock seen, for the one-time log
     const char *m_ntpServer;
     unsigned long m_lastSyncAttempt;
 
     static const time_t MIN_VALID_EPOCH = 1609459200; // 2021-01-01
-    static const unsigned long SYNC_TIMEOUT_MS = 10000;
 };
 
 #endif // NTP_TIME_PROVIDER_H
@@ -18,6 +18,13 @@
 #endif
 #endif
 #include "wifi_serial.h" // Optional WiFi serial mirroring
+#if __has_include("../services/read_timeline.h")
+#include "../services/read_timeline.h" // Per-phase read timing
+#include "../services/spi_stats.h"     // SPI transaction counters
+#else
+#include "read_timeline.h"
+#include "spi_stats.h"
+#endif
 #if !defined(USE_ESPHOME)
 #include <SPI.h> // Include the SPI library for SPI communication (not needed for ESPHome)
 #endif
@@ -66,6 +73,13 @@ uint8_t CC1101_status_FIFO_ReadByte = 0;
 #endif
 static const uint8_t debug_out = (uint8_t)(DEBUG_CC1101);
 
+// Count and time every SPI transaction by type (see services/spi_stats.h).
+// Costs two micros() calls per transaction; set to 0 in private.h or as a
+// build flag to measure the driver without it.
+#ifndef CC1101_SPI_STATS
+#define CC1101_SPI_STATS 1
+#endif
+
 #ifndef TRUE
 #define TRUE true
 #endif
@@ -315,6 +329,33 @@ void cc1101_set_rx_attenuation(int db)
 // Monotonic (lifetime) counter; surfaced via cc1101_get_gdo2_timeout_count() for telemetry.
 static uint32_t _gdo2_stuck_timeouts = 0;
 
+// Phase timings of the read in progress and of recent reads; the trace is
+// begun in get_meter_data_for_meter() and committed by the caller.
+static ReadTimeline s_driver_read_timeline;
+static ReadTimeline *s_read_timeline = &s_driver_read_timeline;
+
+ReadTimeline &cc1101_get_read_timeline(void)
+{
+  return *s_read_timeline;
+}
+
+// SPI transactions since the start of the last read
+static SpiStats s_driver_spi_stats;
+static SpiStats *s_spi_stats = &s_driver_spi_stats;
+
+const SpiStats &cc1101_get_spi_stats(void)
+{
+  return *s_spi_stats;
+}
+
+#ifdef USE_ESPHOME
+void cc1101_set_read_stats(ReadTimeline *timeline, SpiStats *spi_stats)
+{
+  s_read_timeline = timeline ? timeline : &s_driver_read_timeline;
+  s_spi_stats = spi_stats ? spi_stats : &s_driver_spi_stats;
+}
+#endif
+
 uint32_t cc1101_get_gdo2_timeout_count(void)
 {
   return _gdo2_stuck_timeouts;
@@ -339,6 +380,11 @@ uint32_t cc1101_get_gdo2_timeout_count(void)
 int _spi_speed = 0;
 int wiringPiSPIDataRW(int channel, unsigned char *data, int len)
 {
+#if CC1101_SPI_STATS
+  // The header byte is replaced by the chip status during the transfer
+  const SpiOp op = SpiStats::classify(data[0], len);
+  const uint32_t start_us = micros();
+#endif
 #ifdef USE_ESPHOME
   // ESPHome mode: Use SPIDevice methods (enable/transfer_array/disable)
   // The SPIDevice handles bus configuration, speed, and transaction management
@@ -360,6 +406,9 @@ int wiringPiSPIDataRW(int channel, unsigned char *data, int len)
   SPI.endTransaction();
 #endif
 
+#if CC1101_SPI_STATS
+  s_spi_stats->record(op, len, micros() - start_us);
+#endif
   return 0;
 }
 
@@ -1038,6 +1087,21 @@ static bool validate_radian_crc(const uint8_t *decoded_buffer, size_t size)
   return crc_ok;
 }
 
+// Seconds since 1970 for a calendar date/time, treating it as UTC. The meter
+// clock has no time zone, so this is "meter time" in epoch form; comparing it
+// with the NTP epoch gives the meter's total offset (zone plus drift).
+static uint32_t meterClockToEpoch(int year, int month, int day, int hour, int minute, int second)
+{
+  // Days from civil (H. Hinnant), valid for the proleptic Gregorian calendar
+  year -= month <= 2;
+  const int era = year / 400;
+  const int yoe = year - era * 400;
+  const int doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  const long days = (long)era * 146097 + doe - 719468;
+  return (uint32_t)days * 86400UL + (uint32_t)(hour * 3600L + minute * 60L + second);
+}
+
 struct tmeter_data parse_meter_report(uint8_t *decoded_buffer, uint8_t size)
 {
   struct tmeter_data data;
@@ -1076,6 +1140,8 @@ struct tmeter_data parse_meter_report(uint8_t *decoded_buffer, uint8_t size)
     snprintf(data.meter_time, sizeof(data.meter_time), "20%02u-%02u-%02u %02u:%02u:%02u",
              primary.clock_year, primary.clock_month, primary.clock_day,
              primary.clock_hour, primary.clock_minute, primary.clock_second);
+    data.meter_clock_epoch = meterClockToEpoch(2000 + primary.clock_year, primary.clock_month, primary.clock_day,
+                                               primary.clock_hour, primary.clock_minute, primary.clock_second);
   }
   snprintf(data.meter_type, sizeof(data.meter_type), "%s", primary.meter_type);
 
@@ -1404,7 +1470,8 @@ uint8_t decode_4bitpbit_serial(uint8_t *rxBuffer, int l_total_byte, uint8_t *dec
    Note: The received data is 4x larger than the decoded size due to oversampling
    and needs to be processed by decode_4bitpbit_serial() to extract actual data.
 */
-int receive_radian_frame(int size_byte, int rx_tmo_ms, uint8_t *rxBuffer, int rxBuffer_size)
+int receive_radian_frame(int size_byte, int rx_tmo_ms, uint8_t *rxBuffer, int rxBuffer_size,
+                         ReadPhase syncPhase, ReadPhase payloadPhase)
 {
   uint8_t l_byte_in_rx = 0;
   uint16_t l_total_byte = 0;
@@ -1454,6 +1521,7 @@ int receive_radian_frame(int size_byte, int rx_tmo_ms, uint8_t *rxBuffer, int rx
   }
   else
   {
+    s_read_timeline->mark(syncPhase, micros());
     echo_debug(debug_out, "[RX] No sync detected before timeout (meter may be asleep/out of range/wrong config)\n");
     return 0;
   }
@@ -1537,6 +1605,7 @@ int receive_radian_frame(int size_byte, int rx_tmo_ms, uint8_t *rxBuffer, int rx
     if (l_tmo % 50 == 0)
       FEED_WDT(); // Feed watchdog every 50ms
   }
+  s_read_timeline->mark(syncPhase, micros());
   if (l_tmo < rx_tmo_ms)
   {
     echo_debug(debug_out, "[CC1101] GDO0 triggered for frame start at %dms\n", l_tmo);
@@ -1585,6 +1654,7 @@ int receive_radian_frame(int size_byte, int rx_tmo_ms, uint8_t *rxBuffer, int rx
     }
   }
 
+  s_read_timeline->mark(payloadPhase, micros());
   if (l_tmo < rx_tmo_ms && l_total_byte > 0)
   {
     echo_debug(debug_out, "[CC1101] Frame received successfully (%d bytes)\n", l_total_byte);
@@ -1713,6 +1783,18 @@ struct tmeter_data get_meter_data_for_meter(uint8_t meter_year, uint32_t meter_s
   echo_debug(1, "[METER] Transmitting wake-up + interrogation (Year=%d, Serial=%lu)...\n",
              meter_year, (unsigned long)meter_serial);
 
+  // From here to the end of the data frame capture, echo_debug() only records
+  // its arguments: formatting and printing a line inside the TX feed or RX
+  // loops costs more than the FIFO margin. Flushed below once the frame is in.
+  const bool wasDeferred = g_echo_debug_deferred;
+  g_echo_debug_deferred = true;
+
+  // Phase boundaries from here on are timed into the read timeline; the
+  // caller commits the trace once the reading is published (or has failed).
+  // The SPI counters likewise cover this read only.
+  s_read_timeline->begin(micros());
+  s_spi_stats->reset();
+
   // === Critical: Reset radio state before TX ===
   // If the radio is stuck in RXFIFO_OVERFLOW (0x11) or any non-IDLE state from
   // a previous cycle, STX will be ignored. Force IDLE and flush both FIFOs.
@@ -1746,6 +1828,7 @@ struct tmeter_data get_meter_data_for_meter(uint8_t meter_year, uint32_t meter_s
 
   halRfWriteReg(MDMCFG2, MDMCFG2_NO_PREAMBLE_SYNC);  // No preamble/sync for WUP
   halRfWriteReg(PKTCTRL0, PKTCTRL0_INFINITE_LENGTH); // Infinite packet length
+  s_read_timeline->mark(ReadPhase::PreTxReset, micros());
 
   // Pre-fill FIFO to near capacity before starting TX.
   // A fuller FIFO provides much larger buffer (~186ms vs ~27ms) against
@@ -1777,6 +1860,8 @@ struct tmeter_data get_meter_data_for_meter(uint8_t meter_year, uint32_t meter_s
       spin++;
     }
   }
+  s_read_timeline->mark(ReadPhase::WupPrefill, micros());
+  bool wup_feed_done = false;
   while ((CC1101_status_state == 0x02) && (tmo < TX_LOOP_OUT)) // in TX
   {
     // Feed watchdog to prevent reset during long operations (every ~10ms in this loop)
@@ -1829,6 +1914,11 @@ struct tmeter_data get_meter_data_for_meter(uint8_t meter_year, uint32_t meter_s
     }
     else
     {
+      if (!wup_feed_done)
+      {
+        s_read_timeline->mark(ReadPhase::WupFeed, micros());
+        wup_feed_done = true;
+      }
       // Wait for TX FIFO to drain enough to fit the 39-byte interrogation frame.
       // Only write when FIFO space is confirmed; skip and retry the outer TX loop if
       // the safety limit fires before the FIFO drains (avoids write with no headroom).
@@ -1891,6 +1981,7 @@ struct tmeter_data get_meter_data_for_meter(uint8_t meter_year, uint32_t meter_s
       if (fifo_ready)
       {
         SPIWriteBurstReg(TX_FIFO_ADDR, txbuffer, 39);
+        s_read_timeline->mark(ReadPhase::InterrogationWrite, micros());
         if (debug_out && 0)
         {
           echo_debug(debug_out, "txbuffer:\n");
@@ -1924,6 +2015,7 @@ struct tmeter_data get_meter_data_for_meter(uint8_t meter_year, uint32_t meter_s
   // Reaching this point says nothing about whether the meter replied - that is
   // determined below by the ACK/data frames, so any "meter asleep / out of
   // range / run a scan" guidance is deferred until a read actually fails.
+  s_read_timeline->mark(ReadPhase::TxDrain, micros());
   bool tx_fifo_drained = ((marcstate & 0x1F) == 0x16);
   if (tx_fifo_drained)
   {
@@ -1943,7 +2035,7 @@ struct tmeter_data get_meter_data_for_meter(uint8_t meter_year, uint32_t meter_s
   // delay(30); //43ms de bruit
   /*34ms 0101...01  14.25ms 000...000  14ms 1111...11111  83.5ms de data acquitement*/
   echo_debug(1, "[METER] Waiting for ACK frame (18-byte frame, 150ms timeout)...\n");
-  if (!receive_radian_frame(0x12, 150, rxBuffer, sizeof(rxBuffer)))
+  if (!receive_radian_frame(0x12, 150, rxBuffer, sizeof(rxBuffer), ReadPhase::AckSyncWait, ReadPhase::AckPayload))
   {
     echo_debug(1, "[METER] No ACK frame received (meter may be asleep/out of range)\n");
     echo_debug(debug_out, "[METER] Meter acknowledgement frame timeout\n");
@@ -1955,7 +2047,11 @@ struct tmeter_data get_meter_data_for_meter(uint8_t meter_year, uint32_t meter_s
   // delay(30); //50ms de 111111  , mais on a 7+3ms de printf et xxms calculs
   /*34ms 0101...01  14.25ms 000...000  14ms 1111...11111  582ms de data avec l'index */
   echo_debug(1, "[METER] Waiting for data frame (124-byte frame, 1000ms timeout)...\n");
-  rxBuffer_size = receive_radian_frame(0x7C, 1000, rxBuffer, sizeof(rxBuffer));
+  rxBuffer_size = receive_radian_frame(0x7C, 1000, rxBuffer, sizeof(rxBuffer), ReadPhase::DataSyncWait, ReadPhase::Capture);
+  g_echo_debug_deferred = wasDeferred;
+  if (!wasDeferred)
+    echo_debug_flush();
+  s_read_timeline->skip(micros()); // Printing the deferred lines is not part of the read
   if (rxBuffer_size)
   {
     echo_debug(1, "[METER] Data frame received - decoding %d raw bytes...\n", rxBuffer_size);
@@ -1967,7 +2063,9 @@ struct tmeter_data get_meter_data_for_meter(uint8_t meter_year, uint32_t meter_s
       show_in_hex_array(rxBuffer, rxBuffer_size);
     }
 
+    s_read_timeline->skip(micros());
     meter_data_size = decode_4bitpbit_serial(rxBuffer, rxBuffer_size, meter_data);
+    s_read_timeline->mark(ReadPhase::Decode, micros());
     // If debug enabled, print the decoded (post-serial-decoding) meter data so we can inspect fields (timestamp etc.)
     echo_debug(1, "[METER] Decoded %d bytes from %d raw bytes\n", meter_data_size, rxBuffer_size);
 
@@ -1992,9 +2090,10 @@ struct tmeter_data get_meter_data_for_meter(uint8_t meter_year, uint32_t meter_s
       }
       echo_debug(debug_out, "Note: Bytes [18-21]=volume, [31]=battery, [44-45]=wake/sleep, [66-117]=history\n");
     }
-    else
+    else if (EVERBLU_LOG_ENABLED(EVERBLU_LOG_LEVEL_DEBUG, EVERBLU_LOG_TAG_METER))
     {
       // Even without debug_cc1101, show first 32 bytes for basic troubleshooting
+      // (the hex line is LOG_D, so builds below DEBUG drop the whole block)
       echo_debug(1, "[METER] First 32 bytes (header + volume field): ");
       show_in_hex_one_line(meter_data, (meter_data_size < 32) ? meter_data_size : 32);
     }
@@ -2008,10 +2107,15 @@ struct tmeter_data get_meter_data_for_meter(uint8_t meter_year, uint32_t meter_s
     // Read RSSI now while the channel is still active so we can use it to
     // diagnose the cause of a CRC failure (saturation vs. weak signal).
     int8_t frame_rssi_dbm = cc1100_rssi_convert2dbm(halRfReadReg(RSSI_ADDR));
-    if (validate_radian_crc(meter_data, meter_data_size))
+    s_read_timeline->skip(micros());
+    const bool crc_ok = validate_radian_crc(meter_data, meter_data_size);
+    s_read_timeline->mark(ReadPhase::Crc, micros());
+    if (crc_ok)
     {
       echo_debug(1, "[METER] CRC valid - parsing meter data\n");
+      s_read_timeline->skip(micros());
       sdata = parse_meter_report(meter_data, meter_data_size);
+      s_read_timeline->mark(ReadPhase::Parse, micros());
     }
     else
     {
@@ -2046,6 +2150,10 @@ struct tmeter_data get_meter_data_for_meter(uint8_t meter_year, uint32_t meter_s
   sdata.rssi_dbm = cc1100_rssi_convert2dbm(halRfReadReg(RSSI_ADDR)); // Read RSSI value from CC1101 and convert to dBm
   sdata.lqi = halRfReadReg(LQI_ADDR) & 0x7F;                         // Read LQI value from CC1101 (mask bit 7 = CRC_OK; bits 6:0 are the LQI)
   sdata.freqest = (int8_t)halRfReadReg(FREQEST_ADDR);                // Read frequency offset estimate for adaptive tracking
+#if CC1101_SPI_STATS
+  echo_debug(debug_out, "[SPI] %lu transactions, %lu us in transfers this read\n",
+             (unsigned long)s_spi_stats->totalCount(), (unsigned long)s_spi_stats->totalUs());
+#endif
   return sdata;
 }
 
@@ -82,6 +82,49 @@ void cc1101_set_rx_attenuation(int db);
  */
 uint32_t cc1101_get_gdo2_timeout_count(void);
 
+class ReadTimeline;
+
+/**
+ * @brief Per-phase timing of recent meter reads (see services/read_timeline.h)
+ *
+ * get_meter_data_for_meter() begins a trace and marks the radio and decode
+ * phases. The caller marks ReadPhase::Publish and calls commit() so the read
+ * enters the p50/p95/max statistics; a trace left open (e.g. by a frequency
+ * scan) is discarded by the next read.
+ *
+ * @return The timeline selected by cc1101_set_read_stats(), by default the driver's own
+ */
+ReadTimeline &cc1101_get_read_timeline(void);
+
+class SpiStats;
+
+/**
+ * @brief SPI transaction counts and latency histograms of the last read
+ *
+ * Every transfer through wiringPiSPIDataRW() is counted by type (single
+ * read/write, burst read/write, strobe) with its duration; the counters are
+ * reset when get_meter_data_for_meter() starts a read. Always zero when built
+ * with CC1101_SPI_STATS 0.
+ *
+ * @return The counters selected by cc1101_set_read_stats(), by default the
+ *         driver's own (see services/spi_stats.h)
+ */
+const SpiStats &cc1101_get_spi_stats(void);
+
+#ifdef USE_ESPHOME
+/**
+ * @brief Select the timeline and SPI counters the driver records into
+ *
+ * The driver is shared by every everblu_meter instance on one radio. Each
+ * instance binds its own statistics with the rest of its radio context, so
+ * one meter's reads never show up in another's diagnostics.
+ *
+ * @param timeline Timeline to record into, or nullptr for the driver's own
+ * @param spi_stats SPI counters to record into, or nullptr for the driver's own
+ */
+void cc1101_set_read_stats(ReadTimeline *timeline, SpiStats *spi_stats);
+#endif
+
 /**
  * @struct tmeter_data
  * @brief Meter data structure containing current readings and metadata
@@ -104,6 +147,7 @@ struct tmeter_data
   uint32_t history[13];   // Monthly historical readings (13 months), index 0 = oldest, 12 = most recent
   bool history_available; // True if historical data was successfully extracted
   char meter_time[32];    // Meter real-time clock "YYYY-MM-DD HH:MM:SS" (empty if not decoded)
+  uint32_t meter_clock_epoch; // Same clock as seconds since 1970 in the meter's own time base (0 if not decoded)
   char meter_type[12];    // Meter type/identifier ASCII string, e.g. "133290AL02" (empty if not decoded)
 };
 
@@ -40,11 +40,41 @@
  *
  * Usage: LOG_I("everblu_meter", "Message: %d", value);
  * - ESPHome: Expands to ESP_LOGI → WiFi + USB logs
- * - MQTT: Expands to Serial.printf → USB logs only
+ * - MQTT: Expands to the WiFiSerial log sink → USB logs and the telnet monitor
+ *
+ * COMPILE-TIME FILTERING:
+ * =======================
+ * EVERBLU_LOG_LEVEL (a build flag, e.g. in platformio.ini) sets the most
+ * verbose level compiled in: 0 NONE, 1 ERROR, 2 WARN, 3 INFO, 4 DEBUG,
+ * 5 VERBOSE (default; under ESPHome it follows the logger's level). Calls
+ * above it are removed by the compiler with their format strings and arguments.
+ *
+ * EVERBLU_LOG_TAGS is a mask of EVERBLU_LOG_TAG_* bits selecting which INFO
+ * and DEBUG lines stay, by the leading "[TAG]" of the message: echo_debug(),
+ * TS_PRINTF(), TS_PRINTLN() and LOG_*(). Lines tagged [ERROR], [WARN] or
+ * [WARNING] are kept whenever the level allows. Untagged lines have their own
+ * bit, which stays on whatever EVERBLU_LOG_TAGS says unless EVERBLU_LOG_UNTAGGED
+ * is 0. Example, errors and meter progress only:
+ *   -D EVERBLU_LOG_LEVEL=3 -D EVERBLU_LOG_TAGS=EVERBLU_LOG_TAG_METER -D EVERBLU_LOG_UNTAGGED=0
  */
 
 #pragma once
 
+#define EVERBLU_LOG_LEVEL_NONE 0
+#define EVERBLU_LOG_LEVEL_ERROR 1
+#define EVERBLU_LOG_LEVEL_WARN 2
+#define EVERBLU_LOG_LEVEL_INFO 3
+#define EVERBLU_LOG_LEVEL_DEBUG 4
+#define EVERBLU_LOG_LEVEL_VERBOSE 5
+
+#define EVERBLU_LOG_TAG_METER 0x01 // [METER]
+#define EVERBLU_LOG_TAG_CC1101 0x02 // [CC1101], [RX], [CRC-SCAN]
+#define EVERBLU_LOG_TAG_FREQ 0x04 // [FREQ]
+#define EVERBLU_LOG_TAG_MQTT 0x08 // [MQTT]
+#define EVERBLU_LOG_TAG_OTHER 0x10 // Any other tag ([WIFI], [OTA], [STATUS], ...)
+#define EVERBLU_LOG_TAG_UNTAGGED 0x20 // No leading tag (most LOG_*() lines, register dumps)
+#define EVERBLU_LOG_TAG_ALL 0x3F
+
 #if defined(USE_ESPHOME) || (__has_include("esphome/core/log.h"))
 // ============================================================================
 // ESPHOME MODE (or esphome headers available): Use ESPHome logger
@@ -65,8 +95,26 @@
 // schedule_manager.cpp), so provide ESPHome-mode equivalents that route through
 // the ESPHome logger. Without these the shared files fail to compile in ESPHome
 // mode. ESPHome supplies its own timestamp/level prefix and trailing newline.
-#define TS_PRINTLN(msg) ESP_LOGI("everblu_meter", "%s", msg)
-#define TS_PRINTF(fmt, ...) ESP_LOGI("everblu_meter", fmt, ##__VA_ARGS__)
+#define TS_PRINTLN(msg) do { if (everblu_log_line_enabled(msg)) ESP_LOGI("everblu_meter", "%s", msg); } while (0)
+#define TS_PRINTF(fmt, ...) do { if (everblu_log_line_enabled(fmt)) ESP_LOGI("everblu_meter", fmt, ##__VA_ARGS__); } while (0)
+
+// Follow the ESPHome logger level unless EVERBLU_LOG_LEVEL is set explicitly,
+// so echo_debug() lines the logger would discard are not formatted either
+#if !defined(EVERBLU_LOG_LEVEL) && defined(ESPHOME_LOG_LEVEL)
+#if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_VERBOSE
+#define EVERBLU_LOG_LEVEL EVERBLU_LOG_LEVEL_VERBOSE
+#elif ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_DEBUG
+#define EVERBLU_LOG_LEVEL EVERBLU_LOG_LEVEL_DEBUG
+#elif ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_INFO
+#define EVERBLU_LOG_LEVEL EVERBLU_LOG_LEVEL_INFO
+#elif ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_WARN
+#define EVERBLU_LOG_LEVEL EVERBLU_LOG_LEVEL_WARN
+#elif ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_ERROR
+#define EVERBLU_LOG_LEVEL EVERBLU_LOG_LEVEL_ERROR
+#else
+#define EVERBLU_LOG_LEVEL EVERBLU_LOG_LEVEL_NONE
+#endif
+#endif
 
 // Component TAG should be defined as: static const char *const TAG = "everblu_meter";
 // This ensures all logs appear under the "everblu_meter" component in ESPHome logs
@@ -179,15 +227,94 @@ inline const char *everblu_log_timestamp()
 	return buf;
 }
 
-// Timestamped Serial output helpers for tagged log lines (MQTT mode only).
+// Log sink. On the device every line goes to the WiFiSerial stream
+// (core/wifi_serial.cpp) through these functions rather than through the
+// Serial remap of whichever file logs, so all lines share one ordered path:
+// the buffered UART ring with its drop counters and the telnet mirror. Host
+// builds (native tests, tools) have no such stream and print to Serial.
+#if defined(ARDUINO)
+void everblu_log_print(const char *text);
+void everblu_log_printf(const char *format, ...) __attribute__((format(printf, 1, 2)));
+#define EVB_LOG_PRINT(text) everblu_log_print(text)
+#define EVB_LOG_PRINTF(...) everblu_log_printf(__VA_ARGS__)
+#else
+#define EVB_LOG_PRINT(text) Serial.print(text)
+#define EVB_LOG_PRINTF(...) Serial.printf(__VA_ARGS__)
+#endif
+
+// Timestamped output helpers for tagged log lines (MQTT mode only).
 // Use TS_PRINTLN / TS_PRINTF in place of direct Serial.println / Serial.printf
 // for lines that carry a [TAG] prefix, so the output matches ESPHome log style.
-#define TS_PRINTLN(msg) do { Serial.print(everblu_log_timestamp()); Serial.println(msg); } while (0)
-#define TS_PRINTF(fmt, ...) do { Serial.print(everblu_log_timestamp()); Serial.printf(fmt, ##__VA_ARGS__); } while (0)
-
-#define LOG_D(tag, format, ...) Serial.printf("%s" EVB_ANSI_GRAY "[D][%s]" EVB_ANSI_RESET " " format "\n", everblu_log_timestamp(), tag, ##__VA_ARGS__)
-#define LOG_I(tag, format, ...) Serial.printf("%s" EVB_ANSI_GREEN "[I]" EVB_ANSI_RESET "[%s] " format "\n", everblu_log_timestamp(), tag, ##__VA_ARGS__)
-#define LOG_W(tag, format, ...) Serial.printf("%s" EVB_ANSI_YELLOW "[W][%s] " format EVB_ANSI_RESET "\n", everblu_log_timestamp(), tag, ##__VA_ARGS__)
-#define LOG_E(tag, format, ...) Serial.printf("%s" EVB_ANSI_RED "[E][%s] " format EVB_ANSI_RESET "\n", everblu_log_timestamp(), tag, ##__VA_ARGS__)
-#define LOG_V(tag, format, ...) Serial.printf("%s" EVB_ANSI_GRAY "[V][%s] " format EVB_ANSI_RESET "\n", everblu_log_timestamp(), tag, ##__VA_ARGS__)
+// Lines filtered out by EVERBLU_LOG_LEVEL / EVERBLU_LOG_TAGS are compiled out.
+#define TS_PRINTLN(msg) do { if (everblu_log_line_enabled(msg)) { EVB_LOG_PRINT(everblu_log_timestamp()); EVB_LOG_PRINT(msg); EVB_LOG_PRINT("\r\n"); } } while (0)
+#define TS_PRINTF(fmt, ...) do { if (everblu_log_line_enabled(fmt)) { EVB_LOG_PRINT(everblu_log_timestamp()); EVB_LOG_PRINTF(fmt, ##__VA_ARGS__); } } while (0)
+
+// The level and the tag of the message format decide, as for TS_PRINTF. A
+// constant false condition keeps the arguments type-checked and "used" while
+// the compiler drops the call and its strings.
+#define EVB_LOG_AT(level, format, ...) do { if (EVERBLU_LOG_ENABLED((level), everblu_log_line_tag(format))) EVB_LOG_PRINTF(__VA_ARGS__); } while (0)
+
+#define LOG_D(tag, format, ...) EVB_LOG_AT(EVERBLU_LOG_LEVEL_DEBUG, format, "%s" EVB_ANSI_GRAY "[D][%s]" EVB_ANSI_RESET " " format "\n", everblu_log_timestamp(), tag, ##__VA_ARGS__)
+#define LOG_I(tag, format, ...) EVB_LOG_AT(EVERBLU_LOG_LEVEL_INFO, format, "%s" EVB_ANSI_GREEN "[I]" EVB_ANSI_RESET "[%s] " format "\n", everblu_log_timestamp(), tag, ##__VA_ARGS__)
+#define LOG_W(tag, format, ...) EVB_LOG_AT(EVERBLU_LOG_LEVEL_WARN, format, "%s" EVB_ANSI_YELLOW "[W][%s] " format EVB_ANSI_RESET "\n", everblu_log_timestamp(), tag, ##__VA_ARGS__)
+#define LOG_E(tag, format, ...) EVB_LOG_AT(EVERBLU_LOG_LEVEL_ERROR, format, "%s" EVB_ANSI_RED "[E][%s] " format EVB_ANSI_RESET "\n", everblu_log_timestamp(), tag, ##__VA_ARGS__)
+#define LOG_V(tag, format, ...) EVB_LOG_AT(EVERBLU_LOG_LEVEL_VERBOSE, format, "%s" EVB_ANSI_GRAY "[V][%s] " format EVB_ANSI_RESET "\n", everblu_log_timestamp(), tag, ##__VA_ARGS__)
 #endif
+
+// ============================================================================
+// COMPILE-TIME FILTERING (both modes)
+// ============================================================================
+#ifndef EVERBLU_LOG_LEVEL
+#define EVERBLU_LOG_LEVEL EVERBLU_LOG_LEVEL_VERBOSE
+#endif
+
+#ifndef EVERBLU_LOG_TAGS
+#define EVERBLU_LOG_TAGS EVERBLU_LOG_TAG_ALL
+#endif
+
+// Untagged lines are kept by default, so a mask chosen for tagged subsystems
+// does not drop them as a side effect
+#ifndef EVERBLU_LOG_UNTAGGED
+#define EVERBLU_LOG_UNTAGGED 1
+#endif
+
+#define EVERBLU_LOG_TAG_MASK ((EVERBLU_LOG_TAGS) | ((EVERBLU_LOG_UNTAGGED) ? EVERBLU_LOG_TAG_UNTAGGED : 0))
+
+// True if a block logging at level for tag would produce output. Usable in #if
+// and in plain if() around work that only feeds log lines (e.g. hex dumps).
+#define EVERBLU_LOG_ENABLED(level, tag) \
+	((level) <= EVERBLU_LOG_LEVEL && ((level) <= EVERBLU_LOG_LEVEL_WARN || (EVERBLU_LOG_TAG_MASK & (tag)) != 0))
+
+constexpr bool everblu_log_starts_with(const char *s, const char *prefix)
+{
+	return *prefix == '\0' || (*s == *prefix && everblu_log_starts_with(s + 1, prefix + 1));
+}
+
+// Level of a free-form line from its leading tag: [ERROR] and [WARN]/[WARNING]
+// keep their severity, anything else is INFO.
+constexpr int everblu_log_line_level(const char *msg)
+{
+	return everblu_log_starts_with(msg, "[ERROR]") ? EVERBLU_LOG_LEVEL_ERROR
+		: everblu_log_starts_with(msg, "[WARN") ? EVERBLU_LOG_LEVEL_WARN
+		: EVERBLU_LOG_LEVEL_INFO;
+}
+
+constexpr int everblu_log_line_tag(const char *msg)
+{
+	return everblu_log_starts_with(msg, "[METER]") ? EVERBLU_LOG_TAG_METER
+		: everblu_log_starts_with(msg, "[CC1101]") ? EVERBLU_LOG_TAG_CC1101
+		: everblu_log_starts_with(msg, "[RX]") ? EVERBLU_LOG_TAG_CC1101
+		: everblu_log_starts_with(msg, "[CRC-SCAN]") ? EVERBLU_LOG_TAG_CC1101
+		: everblu_log_starts_with(msg, "[FREQ]") ? EVERBLU_LOG_TAG_FREQ
+		: everblu_log_starts_with(msg, "[MQTT]") ? EVERBLU_LOG_TAG_MQTT
+		: (*msg == '[') ? EVERBLU_LOG_TAG_OTHER
+		: EVERBLU_LOG_TAG_UNTAGGED;
+}
+
+// Whether a tagged line survives EVERBLU_LOG_LEVEL / EVERBLU_LOG_TAGS. Written
+// as one constexpr expression so a string literal argument folds to a constant
+// and a disabled call is removed with its format string.
+constexpr bool everblu_log_line_enabled(const char *msg)
+{
+	return EVERBLU_LOG_ENABLED(everblu_log_line_level(msg), everblu_log_line_tag(msg));
+}
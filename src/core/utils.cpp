@@ -13,6 +13,8 @@
 #include "cc1101.h"		 // For tmeter_data struct
 #include "wifi_serial.h" // Mirror Serial to WiFi
 #include "logging.h"	 // Cross-platform logging
+#include "../services/schedule_manager.h"
+#include "../services/deferred_log.h"
 #if !defined(USE_ESPHOME)
 #if defined(__has_include)
 #if __has_include("private.h")
@@ -28,10 +30,20 @@
 // When true, echo_debug() output is suppressed (see utils.h).
 bool g_echo_debug_quiet = false;
 
+// When true, echo_debug() records are captured unformatted (see utils.h).
+bool g_echo_debug_deferred = false;
+static DeferredLog s_echo_debug_ring;
+
 // Consolidated hex display function with optional formatting
 // mode: 0=16 per line with newlines, 1=array format, 2=single line, 3=single line with 'S' separator
 void show_in_hex_formatted(const uint8_t *buffer, size_t len, int mode)
 {
+#if EVERBLU_LOG_LEVEL < EVERBLU_LOG_LEVEL_DEBUG
+	// LOG_D is compiled out, so the dump would format bytes for nothing
+	(void)buffer;
+	(void)len;
+	(void)mode;
+#else
 	size_t i = 0;
 	char line_buf[256];
 	int line_pos = 0;
@@ -83,6 +95,7 @@ void show_in_hex_formatted(const uint8_t *buffer, size_t len, int mode)
 		line_buf[line_pos] = '\0';
 		LOG_D("everblu_meter", "%s", line_buf);
 	}
+#endif
 }
 
 // Legacy function wrappers for backwards compatibility
@@ -108,6 +121,10 @@ void show_in_hex_one_line_GET(const uint8_t *buffer, size_t len)
 
 void show_in_bin(const uint8_t *buffer, size_t len)
 {
+#if EVERBLU_LOG_LEVEL < EVERBLU_LOG_LEVEL_DEBUG
+	(void)buffer;
+	(void)len;
+#else
 	const uint8_t *ptr;
 	uint8_t mask;
 	char bin_buf[512];
@@ -131,6 +148,7 @@ void show_in_bin(const uint8_t *buffer, size_t len)
 		bin_buf[bin_pos] = '\0';
 		LOG_D("everblu_meter", "%s", bin_buf);
 	}
+#endif
 }
 
 int calculateMeterdBmToPercentage(int rssi_dbm)
@@ -151,6 +169,12 @@ int calculateLQIToPercentage(int lqi)
 }
 void printMeterDataSummary(const struct tmeter_data *meter_data, bool isMeterGas, int volumeDivisor)
 {
+#if !EVERBLU_LOG_ENABLED(EVERBLU_LOG_LEVEL_INFO, EVERBLU_LOG_TAG_METER)
+	// Every line below is compiled out; skip the formatting as well
+	(void)meter_data;
+	(void)isMeterGas;
+	(void)volumeDivisor;
+#else
 	if (!meter_data)
 		return;
 
@@ -187,18 +211,13 @@ void printMeterDataSummary(const struct tmeter_data *meter_data, bool isMeterGas
 	LOG_I("everblu_meter", "%-25s: %s", "Time window start", timeStartFormatted);
 	LOG_I("everblu_meter", "%-25s: %s", "Time window end", timeEndFormatted);
 	LOG_I("everblu_meter", "==================");
+#endif
 }
-void echo_debug(bool l_flag, const char *fmt, ...)
-{
-	if (!l_flag || g_echo_debug_quiet)
-		return;
-
-	va_list args;
-	va_start(args, fmt);
-
-	char buf[256];
-	vsnprintf(buf, sizeof(buf), fmt, args);
 
+// Writes one formatted echo_debug() line. offset ("" for a live line) is the
+// capture offset of a deferred one; buf may be modified (trailing newline).
+static void echo_debug_emit(char *buf, const char *offset)
+{
 #if defined(USE_ESPHOME)
 	// ESPHome mode: Route through LOG system for WiFi-visible logs
 	// Strip trailing newline if present (LOG_* adds it automatically)
@@ -206,7 +225,7 @@ void echo_debug(bool l_flag, const char *fmt, ...)
 	if (len > 0 && buf[len - 1] == '\n')
 		buf[len - 1] = '\0';
 	// Use INFO level so messages are always visible in WiFi logs
-	LOG_I("everblu_meter", "%s", buf);
+	LOG_I("everblu_meter", "%s%s", offset, buf);
 #else
 	// MQTT mode: Route through WiFiSerial for USB + WiFi visibility.
 	// Colourise based on the leading "[TAG]" token (e.g. [METER], [FREQ]) so
@@ -221,6 +240,7 @@ void echo_debug(bool l_flag, const char *fmt, ...)
 		if (hasNewline)
 			buf[len - 1] = '\0';
 		WiFiSerial.print(ts);
+		WiFiSerial.print(offset);
 		WiFiSerial.print(col);
 		WiFiSerial.print(buf);
 		WiFiSerial.print(EVB_ANSI_RESET);
@@ -230,11 +250,76 @@ void echo_debug(bool l_flag, const char *fmt, ...)
 	else
 	{
 		WiFiSerial.print(ts);
+		WiFiSerial.print(offset);
 		WiFiSerial.print(buf);
 	}
 #endif
+}
 
+void echo_debug_write(const char *fmt, ...)
+{
+	if (g_echo_debug_quiet)
+		return;
+
+	va_list args;
+	va_start(args, fmt);
+
+	// Deferred: keep the raw arguments and format from echo_debug_flush().
+	// A full ring drops the line (reported at flush) rather than stall the
+	// radio; a call whose arguments do not fit a record is printed now.
+	if (g_echo_debug_deferred && (s_echo_debug_ring.capture(fmt, args) || s_echo_debug_ring.isFull()))
+	{
+		va_end(args);
+		return;
+	}
+
+	char buf[256];
+	vsnprintf(buf, sizeof(buf), fmt, args);
 	va_end(args);
+
+	echo_debug_emit(buf, "");
+}
+
+void echo_debug_flush(void)
+{
+	DeferredLogRecord record;
+#if !defined(ECHO_DEBUG_BINARY)
+	uint32_t firstUs = 0;
+	bool first = true;
+#endif
+	while (s_echo_debug_ring.pop(record))
+	{
+#if defined(ECHO_DEBUG_BINARY)
+		// Hex-encoded binary records for tools/deferred_log_decoder.py; skips
+		// formatting on the device entirely.
+		uint8_t bin[DeferredLog::MAX_EXPORT_SIZE];
+		size_t binLen = DeferredLog::exportRecord(record, bin, sizeof(bin));
+		char hex[2 * DeferredLog::MAX_EXPORT_SIZE + 1];
+		for (size_t i = 0; i < binLen; i++)
+			snprintf(hex + 2 * i, 3, "%02X", bin[i]);
+		hex[2 * binLen] = '\0';
+		LOG_I("everblu_meter", "[DLOG] %s", hex);
+#else
+		// Prefix each line with its capture offset inside the deferred window,
+		// which is the timing that matters when debugging the radio phases.
+		if (first)
+		{
+			firstUs = record.timestampUs;
+			first = false;
+		}
+		char offset[24];
+		uint32_t offsetUs = record.timestampUs - firstUs;
+		snprintf(offset, sizeof(offset), "[+%lu.%03lums] ",
+				 (unsigned long)(offsetUs / 1000), (unsigned long)(offsetUs % 1000));
+		char buf[256];
+		DeferredLog::format(record, buf, sizeof(buf));
+		echo_debug_emit(buf, offset);
+#endif
+	}
+
+	uint32_t dropped = s_echo_debug_ring.takeDropped();
+	if (dropped > 0)
+		LOG_W("everblu_meter", "[DEBUG] %lu deferred debug lines dropped (ring full)", (unsigned long)dropped);
 }
 
 void print_time(void)
@@ -374,28 +459,6 @@ bool isValidReadingSchedule(const char *schedule)
 		return false;
 	}
 
-	// Allowed values based on unit tests
-	if (strcmp(schedule, "Monday-Friday") == 0)
-		return true;
-	if (strcmp(schedule, "Monday-Saturday") == 0)
-		return true;
-	if (strcmp(schedule, "Monday-Sunday") == 0)
-		return true;
-	if (strcmp(schedule, "Monday") == 0)
-		return true;
-	if (strcmp(schedule, "Tuesday") == 0)
-		return true;
-	if (strcmp(schedule, "Wednesday") == 0)
-		return true;
-	if (strcmp(schedule, "Thursday") == 0)
-		return true;
-	if (strcmp(schedule, "Friday") == 0)
-		return true;
-	if (strcmp(schedule, "Saturday") == 0)
-		return true;
-	if (strcmp(schedule, "Sunday") == 0)
-		return true;
-
-	// Everything else is considered invalid for now
-	return false;
+	// ScheduleManager owns the schedule grammar (presets, day names, Nth weekday)
+	return ScheduleManager::isValidSchedule(schedule);
 }
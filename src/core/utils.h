@@ -10,6 +10,7 @@
 
 #include <Arduino.h>
 #include "crc_kermit.h"
+#include "logging.h" // echo_debug() compile-time filter
 
 /**
  * @brief Display buffer contents in hexadecimal format (multi-line)
@@ -47,12 +48,28 @@ void show_in_hex_one_line_GET(const uint8_t *buffer, size_t len);
 void show_in_bin(const uint8_t *buffer, size_t len);
 
 /**
- * @brief Conditional debug output with printf-style formatting
- * @param l_flag Boolean flag controlling whether to print (true = print)
+ * @brief Unconditional debug output with printf-style formatting
+ *
+ * Call through echo_debug(), which applies the flag and the compile-time
+ * EVERBLU_LOG_LEVEL / EVERBLU_LOG_TAGS filter.
+ *
  * @param fmt Format string (printf-style)
  * @param ... Variable arguments for format string
  */
-void echo_debug(bool l_flag, const char *fmt, ...);
+void echo_debug_write(const char *fmt, ...);
+
+/**
+ * @brief Conditional debug output with printf-style formatting
+ *
+ * A line whose leading "[TAG]" is filtered out at compile time (see logging.h),
+ * or whose flag is a constant false such as debug_out without DEBUG_CC1101,
+ * is removed along with its format string and argument evaluation.
+ *
+ * @param flag Boolean flag controlling whether to print (true = print)
+ * @param fmt Format string literal (printf-style)
+ * @param ... Variable arguments for format string
+ */
+#define echo_debug(flag, fmt, ...) do { if (everblu_log_line_enabled(fmt) && (flag)) echo_debug_write(fmt, ##__VA_ARGS__); } while (0)
 
 /**
  * @brief When true, echo_debug() output is suppressed.
@@ -81,6 +98,25 @@ struct EchoDebugQuietGuard
 	EchoDebugQuietGuard &operator=(const EchoDebugQuietGuard &) = delete;
 };
 
+/**
+ * @brief When true, echo_debug() stores its arguments unformatted.
+ *
+ * Set around the radio TX feed and frame capture, where formatting and
+ * printing each line (several ms for a long one) would delay FIFO servicing.
+ * The lines are formatted later by echo_debug_flush(), prefixed with their
+ * capture offset. Build with -DECHO_DEBUG_BINARY to print them as hex records
+ * for tools/deferred_log_decoder.py instead.
+ */
+extern bool g_echo_debug_deferred;
+
+/**
+ * @brief Format and print echo_debug() lines captured while deferred
+ *
+ * Called once the time-critical phase is over and from the main loop; a
+ * no-op when nothing is pending.
+ */
+void echo_debug_flush(void);
+
 /**
  * @brief Print current timestamp for debugging
  */
@@ -150,8 +186,9 @@ int calculateLQIToPercentage(int lqi);
  * @brief Validate reading schedule string
  *
  * @param schedule Schedule string to validate
- * @return true if schedule is one of: presets ("Monday-Friday", "Monday-Saturday", "Monday-Sunday")
- *         or a specific day ("Monday" through "Sunday")
+ * @return true if schedule is one of: presets ("Monday-Friday", "Monday-Saturday", "Monday-Sunday"),
+ *         a specific day ("Monday" through "Sunday") or an Nth weekday of the month
+ *         ("First-Monday" through "Fourth-Sunday", "Last-Monday" through "Last-Sunday")
  */
 bool isValidReadingSchedule(const char *schedule);
 
@@ -25,7 +25,7 @@
 // TCP server on configured port
 #if WIFI_SERIAL_HAS_WIFI
 static WiFiServer wifiSerialServer(WIFI_SERIAL_PORT);
-static WiFiClient wifiSerialClient;
+static WiFiClient wifiSerialClients[WIFI_SERIAL_MAX_CLIENTS];
 #endif
 static bool serverStarted = false;
 
@@ -49,15 +49,15 @@ void WifiSerialStream::beginServer()
     wifiSerialServer.setNoDelay(true); // Lower latency for logs
     serverStarted = true;
 
-    _usb.printf("[WiFi Serial] Server started on port %d\n", WIFI_SERIAL_PORT);
-    _usb.printf("[WiFi Serial] Connect using: telnet %s %d\n",
+    _uartPrintf("[WiFi Serial] Server started on port %d\n", WIFI_SERIAL_PORT);
+    _uartPrintf("[WiFi Serial] Connect using: telnet %s %d\n",
                 WiFi.localIP().toString().c_str(), WIFI_SERIAL_PORT);
     // NOTE: This server is unauthenticated and unencrypted. Any device on your local network
     // can connect and view serial output, which may include WiFi/MQTT credentials and internal state.
 #else
     if (!serverStarted)
     {
-        _usb.println("[WiFi Serial] WiFi headers unavailable in this build; TCP serial disabled");
+        _uartPrintf("[WiFi Serial] WiFi headers unavailable in this build; TCP serial disabled\n");
         serverStarted = true;
     }
 #endif
@@ -65,6 +65,20 @@ void WifiSerialStream::beginServer()
 
 void WifiSerialStream::loop()
 {
+    _uartPump();
+
+#if WIFI_SERIAL_UART_BUF_SIZE > 0
+    // Report UART drops once the ring has room for the notice again
+    if (_uartDropped != _uartDroppedReported &&
+        (WIFI_SERIAL_UART_BUF_SIZE - 1) - _uartPending() >= 128)
+    {
+        uint32_t snap = _uartDropped;
+        _uartPrintf("[WiFi Serial] %lu bytes of serial output dropped (UART stalled, longest wait %lu us)\n",
+                    (unsigned long)(snap - _uartDroppedReported), (unsigned long)_maxStallUs);
+        _uartDroppedReported = snap;
+    }
+#endif
+
 #if WIFI_SERIAL_HAS_WIFI
     if (!serverStarted || WiFi.status() != WL_CONNECTED)
     {
@@ -73,133 +87,230 @@ void WifiSerialStream::loop()
 
     if (wifiSerialServer.hasClient())
     {
-        if (wifiSerialClient && wifiSerialClient.connected())
+        WiFiClient incoming = wifiSerialServer.accept();
+        int slot = -1;
+        for (uint8_t i = 0; i < WIFI_SERIAL_MAX_CLIENTS; i++)
         {
-            _usb.println("[WiFi Serial] New client connecting - disconnecting existing client");
-            wifiSerialClient.stop();
+            if (!_attached[i])
+            {
+                slot = i;
+                break;
+            }
         }
-
-        wifiSerialClient = wifiSerialServer.accept();
-        if (wifiSerialClient)
+        if (incoming && slot < 0 && WIFI_SERIAL_MAX_CLIENTS > 1)
         {
-            _usb.printf("[WiFi Serial] Client connected from %s\n",
-                        wifiSerialClient.remoteIP().toString().c_str());
-            wifiSerialClient.setNoDelay(true);
+            _uartPrintf("[WiFi Serial] Client from %s refused: all %d slots in use\n",
+                        incoming.remoteIP().toString().c_str(), WIFI_SERIAL_MAX_CLIENTS);
+            incoming.println("[WiFi Serial] Too many clients connected, try again later");
+            incoming.stop();
+        }
+        else if (incoming)
+        {
+            // Single-client mode: a valid new connection replaces the old one
+            if (slot < 0)
+            {
+                _uartPrintf("[WiFi Serial] New client connecting - disconnecting existing client\n");
+                _detach(0);
+                slot = 0;
+            }
+            wifiSerialClients[slot] = incoming;
+            _uartPrintf("[WiFi Serial] Client connected from %s\n",
+                        incoming.remoteIP().toString().c_str());
+            wifiSerialClients[slot].setNoDelay(true);
+            _attach((uint8_t)slot);
+        }
+    }
 
-            // Reset ring buffer so the new client starts from fresh output,
-            // not stale data accumulated before it connected.
-            _head = _tail = 0;
-            _dropped = 0;
-            _lastSendMs = millis(); // banner counts as first send; restart keepalive timer
-
-            // Send welcome banner to new client
-            wifiSerialClient.println("\n=====================================");
-            wifiSerialClient.println("WiFi Serial Monitor Connected");
-            wifiSerialClient.println("=====================================");
-            wifiSerialClient.println("Everblu Meters ESP8266/ESP32");
-            wifiSerialClient.printf("Firmware Version: %s\n", EVERBLU_FW_VERSION);
-            wifiSerialClient.println("Water/Gas usage data for Home Assistant");
-            wifiSerialClient.println("https://github.com/genestealer/everblu-meters-esp8266-improved");
-            wifiSerialClient.println();
-            wifiSerialClient.printf("Device IP: %s\n", WiFi.localIP().toString().c_str());
-            wifiSerialClient.printf("WiFi SSID: %s\n", WiFi.SSID().c_str());
-            wifiSerialClient.printf("WiFi RSSI: %d dBm\n", WiFi.RSSI());
-            wifiSerialClient.printf("Uptime: %lu seconds\n", millis() / 1000);
-#if defined(ESP8266)
-            wifiSerialClient.printf("Reset reason: %s\n", ESP.getResetReason().c_str());
-#endif
-            wifiSerialClient.println("=====================================");
-            wifiSerialClient.println();
+    for (uint8_t i = 0; i < WIFI_SERIAL_MAX_CLIENTS; i++)
+    {
+        if (_attached[i] && !wifiSerialClients[i].connected())
+        {
+            _uartPrintf("[WiFi Serial] Client disconnected\n");
+            _detach(i);
         }
     }
 
-    if (wifiSerialClient && !wifiSerialClient.connected())
+    if (_txBuf == nullptr)
     {
-        _usb.println("[WiFi Serial] Client disconnected");
-        wifiSerialClient.stop();
-        _head = _tail = 0; // Discard buffered output for gone client
+        return;
     }
 
-    // Drain the async ring buffer to the TCP client.
-    // Loop until the buffer is empty or TCP write returns 0 (send buffer full).
-    // Using write()'s return value instead of availableForWrite(), which is
-    // unreliable on ESP8266 WiFiClient.
-    if (wifiSerialClient && wifiSerialClient.connected())
+    for (uint8_t i = 0; i < WIFI_SERIAL_MAX_CLIENTS; i++)
     {
-        // Drain all pending bytes in one shot (multiple contiguous chunks).
-        // Cast the delta to uint16_t before masking so wraparound is well-defined
-        // (the subtraction is otherwise promoted to signed int).
-        uint16_t pending = (uint16_t)(_head - _tail) & (WIFI_SERIAL_TX_BUF_SIZE - 1);
-        while (pending > 0)
+        if (!_attached[i])
+            continue;
+        _drain(i);
+        if (_pending(i) > 0 && millis() - _lastProgressMs[i] > WIFI_SERIAL_CLIENT_STALL_MS)
         {
-            uint16_t tailIdx = _tail & (WIFI_SERIAL_TX_BUF_SIZE - 1);
-            // Use size_t to avoid uint16_t truncation when WIFI_SERIAL_TX_BUF_SIZE
-            // equals 65536 and tailIdx is 0 (65536 wraps to 0 in uint16_t).
-            size_t contiguous = WIFI_SERIAL_TX_BUF_SIZE - tailIdx;
-            size_t toSend = (pending < contiguous) ? (size_t)pending : contiguous;
-            size_t sent = wifiSerialClient.write(&_txBuf[tailIdx], toSend);
-            if (sent == 0)
-                break; // TCP send buffer full; retry next loop() call
-            _tail += (uint16_t)sent;
-            _lastSendMs = millis();
-            pending = (uint16_t)(_head - _tail) & (WIFI_SERIAL_TX_BUF_SIZE - 1);
+            _uartPrintf("[WiFi Serial] Client stalled for %lu ms with output pending - disconnecting\n",
+                        (unsigned long)WIFI_SERIAL_CLIENT_STALL_MS);
+            _detach(i);
         }
+    }
+    if (_txBuf == nullptr)
+    {
+        return; // The last client stalled out
+    }
 
-        // Keepalive: if no data has been sent for 20 seconds, enqueue a small
-        // marker line so NAT routers don't expire the idle TCP session.
-        // Enqueued (not written directly) to keep all TCP writes non-blocking.
-        if (millis() - _lastSendMs > 20000UL)
-        {
-            const char *ka = "# [WiFi Serial] alive\n";
-            for (size_t i = 0; ka[i] != '\0'; i++)
-                _enqueue((uint8_t)ka[i]);
-            _lastSendMs = millis();
-        }
+    // Keepalive: if no data has been sent for 20 seconds, enqueue a small
+    // marker line so NAT routers don't expire the idle TCP session.
+    // Enqueued (not written directly) to keep all TCP writes non-blocking.
+    if (millis() - _lastSendMs > 20000UL)
+    {
+        const char *ka = "# [WiFi Serial] alive\n";
+        _enqueue(reinterpret_cast<const uint8_t *>(ka), strlen(ka));
+        _lastSendMs = millis();
+    }
 
-        if (_dropped > 0)
+    if (_dropped > 0)
+    {
+        // Snapshot the counter and format the notice, then enqueue only if
+        // the full notice fits.  Only clear _dropped after a successful
+        // complete enqueue so partial failures don't silently hide drops.
+        char notice[48];
+        uint32_t snap = _dropped;
+        int nlen = snprintf(notice, sizeof(notice), "[WiFi Serial] %lu bytes dropped\n",
+                            (unsigned long)snap);
+        if (nlen > 0 && _free() >= (uint16_t)nlen)
         {
-            // Snapshot the counter and format the notice, then enqueue only if
-            // the full notice fits.  Only clear _dropped after a successful
-            // complete enqueue so partial failures don't silently hide drops.
-            char notice[48];
-            uint32_t snap = _dropped;
-            int nlen = snprintf(notice, sizeof(notice), "[WiFi Serial] %lu bytes dropped\n",
-                                (unsigned long)snap);
-            if (nlen > 0 && _free() >= (uint16_t)nlen)
-            {
-                for (int i = 0; i < nlen; i++)
-                    _enqueue((uint8_t)notice[i]);
-                _dropped = 0;
-            }
+            _enqueue(reinterpret_cast<const uint8_t *>(notice), (size_t)nlen);
+            _dropped = 0;
         }
     }
 #endif
 }
 
-size_t WifiSerialStream::write(uint8_t c)
+bool WifiSerialStream::_allocTxBuf()
 {
-    _usb.write(c);
 #if WIFI_SERIAL_HAS_WIFI
-    // Non-blocking: enqueue into ring buffer; loop() drains to TCP client.
-    if (wifiSerialClient && wifiSerialClient.connected())
+    // Largest power of two the heap can spare while keeping the reserve
+    for (uint32_t size = WIFI_SERIAL_TX_BUF_SIZE; size >= WIFI_SERIAL_TX_BUF_MIN; size >>= 1)
     {
-        _enqueue(c);
+        if (ESP.getFreeHeap() < size + WIFI_SERIAL_HEAP_RESERVE)
+            continue;
+        uint8_t *buf = static_cast<uint8_t *>(malloc(size));
+        if (buf == nullptr)
+            continue;
+        _txBuf = buf;
+        _txSize = size;
+        _txMask = (uint16_t)(size - 1);
+        _head = 0;
+        _dropped = 0;
+        _uartPrintf("[WiFi Serial] %lu byte output buffer allocated (%lu bytes heap free)\n",
+                    (unsigned long)size, (unsigned long)ESP.getFreeHeap());
+        return true;
     }
+    _uartPrintf("[WiFi Serial] Not enough heap for an output buffer (%lu bytes free)\n",
+                (unsigned long)ESP.getFreeHeap());
 #endif
-    return 1;
+    return false;
 }
 
-size_t WifiSerialStream::write(const uint8_t *buffer, size_t size)
+void WifiSerialStream::_attach(uint8_t slot)
 {
-    _usb.write(buffer, size);
 #if WIFI_SERIAL_HAS_WIFI
-    // Non-blocking: enqueue into ring buffer; loop() drains to TCP client.
-    if (wifiSerialClient && wifiSerialClient.connected())
+    WiFiClient &client = wifiSerialClients[slot];
+    if (_txBuf == nullptr && !_allocTxBuf())
     {
-        for (size_t i = 0; i < size; i++)
-            _enqueue(buffer[i]);
+        client.println("[WiFi Serial] Device is low on memory, try again later");
+        client.stop();
+        return;
     }
+
+    // The new client starts from fresh output, not data already queued
+    // for the others.
+    _tails[slot] = _head;
+    _attached[slot] = true;
+    _lastProgressMs[slot] = millis();
+    _lastSendMs = millis(); // banner counts as first send; restart keepalive timer
+
+    // Send welcome banner to new client
+    client.println("\n=====================================");
+    client.println("WiFi Serial Monitor Connected");
+    client.println("=====================================");
+    client.println("Everblu Meters ESP8266/ESP32");
+    client.printf("Firmware Version: %s\n", EVERBLU_FW_VERSION);
+    client.println("Water/Gas usage data for Home Assistant");
+    client.println("https://github.com/genestealer/everblu-meters-esp8266-improved");
+    client.println();
+    client.printf("Device IP: %s\n", WiFi.localIP().toString().c_str());
+    client.printf("WiFi SSID: %s\n", WiFi.SSID().c_str());
+    client.printf("WiFi RSSI: %d dBm\n", WiFi.RSSI());
+    client.printf("Uptime: %lu seconds\n", millis() / 1000);
+#if defined(ESP8266)
+    client.printf("Reset reason: %s\n", ESP.getResetReason().c_str());
+#endif
+    client.println("=====================================");
+    client.println();
+#else
+    (void)slot;
 #endif
+}
+
+void WifiSerialStream::_detach(uint8_t slot)
+{
+#if WIFI_SERIAL_HAS_WIFI
+    wifiSerialClients[slot].stop();
+#endif
+    _attached[slot] = false;
+
+    for (uint8_t i = 0; i < WIFI_SERIAL_MAX_CLIENTS; i++)
+    {
+        if (_attached[i])
+            return;
+    }
+    // Last client gone: discard its buffered output and give the heap back
+    free(_txBuf);
+    _txBuf = nullptr;
+    _txSize = 0;
+    _txMask = 0;
+    _head = 0;
+}
+
+void WifiSerialStream::_drain(uint8_t slot)
+{
+#if WIFI_SERIAL_HAS_WIFI
+    // Drain all pending bytes for this client in one shot (multiple
+    // contiguous chunks), until the ring is empty for it or TCP write
+    // returns 0 (send buffer full).  Using write()'s return value instead of
+    // availableForWrite(), which is unreliable on ESP8266 WiFiClient.
+    WiFiClient &client = wifiSerialClients[slot];
+    uint16_t pending = _pending(slot);
+    while (pending > 0)
+    {
+        uint16_t tailIdx = _tails[slot] & _txMask;
+        // Use size_t to avoid uint16_t truncation when the ring is 65536
+        // bytes and tailIdx is 0 (65536 wraps to 0 in uint16_t).
+        size_t contiguous = _txSize - tailIdx;
+        size_t toSend = (pending < contiguous) ? (size_t)pending : contiguous;
+        size_t sent = client.write(&_txBuf[tailIdx], toSend);
+        if (sent == 0)
+            break; // TCP send buffer full; retry next loop() call
+        _tails[slot] += (uint16_t)sent;
+        _tcpBytesSent += (uint32_t)sent;
+        _lastProgressMs[slot] = millis();
+        _lastSendMs = millis();
+        pending = _pending(slot);
+    }
+#else
+    (void)slot;
+#endif
+}
+
+size_t WifiSerialStream::write(uint8_t c)
+{
+    return write(&c, 1);
+}
+
+size_t WifiSerialStream::write(const uint8_t *buffer, size_t size)
+{
+    _uartWrite(buffer, size);
+    // Non-blocking: enqueue into the broadcast ring (allocated only while a
+    // client is connected); loop() drains it to every client.
+    if (_txBuf != nullptr)
+    {
+        _enqueue(buffer, size);
+    }
     return size;
 }
 
@@ -208,6 +319,15 @@ size_t WifiSerialStream::write(const uint8_t *buffer, size_t size)
 #define WIFI_SERIAL_PRINTF_BUFFER_SIZE 1024
 
 size_t WifiSerialStream::printf(const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    size_t written = vprintf(format, args);
+    va_end(args);
+    return written;
+}
+
+size_t WifiSerialStream::vprintf(const char *format, va_list args)
 {
     // PRECONDITION: this buffer is static to avoid stack pressure on ESP8266
     // (81920 bytes RAM total), which REQUIRES that WifiSerialStream is only ever
@@ -216,15 +336,12 @@ size_t WifiSerialStream::printf(const char *format, ...)
     // (e.g. a FreeRTOS task on ESP32) a concurrent caller would re-enter this
     // function and corrupt the shared buffer. Do not call from ISRs or tasks.
     static char buffer[WIFI_SERIAL_PRINTF_BUFFER_SIZE];
-    va_list args;
-    va_start(args, format);
     int len = vsnprintf(buffer, sizeof(buffer), format, args);
-    va_end(args);
 
     bool truncated = (len < 0) || (len >= static_cast<int>(sizeof(buffer)));
     if (truncated)
     {
-        _usb.printf("[WiFi Serial] Warning: printf output truncated (buffer %d bytes)\n", WIFI_SERIAL_PRINTF_BUFFER_SIZE);
+        _uartPrintf("[WiFi Serial] Warning: printf output truncated (buffer %d bytes)\n", WIFI_SERIAL_PRINTF_BUFFER_SIZE);
     }
 
     return write(reinterpret_cast<uint8_t *>(buffer), strlen(buffer));
@@ -232,30 +349,139 @@ size_t WifiSerialStream::printf(const char *format, ...)
 
 void WifiSerialStream::flush()
 {
+#if WIFI_SERIAL_UART_BUF_SIZE > 0
+    // Serial.flush() promises the output is on the wire (e.g. before a
+    // restart), so hand everything still in the UART ring over, blocking.
+    uint16_t uartPending = _uartPending();
+    while (uartPending > 0)
+    {
+        uint16_t tailIdx = _uartTail & (WIFI_SERIAL_UART_BUF_SIZE - 1);
+        size_t contiguous = WIFI_SERIAL_UART_BUF_SIZE - tailIdx;
+        size_t toSend = (uartPending < contiguous) ? (size_t)uartPending : contiguous;
+        size_t sent = _usb.write(&_uartBuf[tailIdx], toSend);
+        if (sent == 0)
+            break;
+        _uartTail += (uint16_t)sent;
+        uartPending = _uartPending();
+    }
+#endif
     _usb.flush();
-    // Drain pending bytes to the client, looping across the ring-buffer
-    // wraparound so a flush() spanning the buffer boundary fully empties it.
-    // Stays non-blocking: stops as soon as write() returns 0 (TCP send buffer
-    // full), leaving any remainder for the next loop() drain.
-#if WIFI_SERIAL_HAS_WIFI
-    if (wifiSerialClient && wifiSerialClient.connected())
+    // Drain pending bytes to every client, looping across the ring-buffer
+    // wraparound.  Stays non-blocking: stops as soon as a client's write()
+    // returns 0 (TCP send buffer full), leaving the remainder for loop().
+    if (_txBuf != nullptr)
     {
-        uint16_t pending = (uint16_t)(_head - _tail) & (WIFI_SERIAL_TX_BUF_SIZE - 1);
-        while (pending > 0)
+        for (uint8_t i = 0; i < WIFI_SERIAL_MAX_CLIENTS; i++)
         {
-            uint16_t tailIdx = _tail & (WIFI_SERIAL_TX_BUF_SIZE - 1);
-            // Use size_t to avoid uint16_t truncation when WIFI_SERIAL_TX_BUF_SIZE
-            // equals 65536 and tailIdx is 0 (65536 wraps to 0 in uint16_t).
-            size_t contiguous = WIFI_SERIAL_TX_BUF_SIZE - tailIdx;
-            size_t toSend = (pending < contiguous) ? (size_t)pending : contiguous;
-            size_t sent = wifiSerialClient.write(&_txBuf[tailIdx], toSend);
-            if (sent == 0)
-                break; // TCP send buffer full; retry next loop() call
-            _tail += (uint16_t)sent;
-            pending = (uint16_t)(_head - _tail) & (WIFI_SERIAL_TX_BUF_SIZE - 1);
+            if (_attached[i])
+                _drain(i);
         }
     }
+}
+
+WifiSerialStats WifiSerialStream::stats() const
+{
+    WifiSerialStats out;
+    out.uartDropped = _uartDropped;
+    out.tcpDropped = _tcpDroppedTotal;
+    out.maxStallUs = _maxStallUs;
+    out.uartHighWater = _uartHighWater;
+    out.tcpBytesSent = _tcpBytesSent;
+    out.tcpHighWater = _tcpHighWater;
+    out.tcpBufSize = _txSize;
+    out.tcpClients = 0;
+    for (uint8_t i = 0; i < WIFI_SERIAL_MAX_CLIENTS; i++)
+    {
+        if (_attached[i])
+            out.tcpClients++;
+    }
+    return out;
+}
+
+void WifiSerialStream::_uartWrite(const uint8_t *buffer, size_t size)
+{
+#if WIFI_SERIAL_UART_BUF_SIZE > 0
+    // Copy into the ring; wait for the FIFO only while the ring is full, and
+    // for at most WIFI_SERIAL_UART_STALL_LIMIT_US over the whole call. Once a
+    // wait has timed out, later writes drop straight away until the UART
+    // takes data again, so a stuck port costs one stall rather than one per line.
+    uint32_t stallUs = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        if (_uartPending() == WIFI_SERIAL_UART_BUF_SIZE - 1)
+        {
+            unsigned long waitStart = micros();
+            _uartPump();
+            while (!_uartStuck && _uartPending() == WIFI_SERIAL_UART_BUF_SIZE - 1 &&
+                   stallUs + (uint32_t)(micros() - waitStart) < WIFI_SERIAL_UART_STALL_LIMIT_US)
+            {
+                _uartPump();
+            }
+            stallUs += (uint32_t)(micros() - waitStart);
+            if (_uartPending() == WIFI_SERIAL_UART_BUF_SIZE - 1)
+            {
+                _uartStuck = true;
+                _uartDropped += (uint32_t)(size - i);
+                break;
+            }
+        }
+        _uartBuf[_uartHead & (WIFI_SERIAL_UART_BUF_SIZE - 1)] = buffer[i];
+        _uartHead++;
+    }
+
+    uint16_t pending = _uartPending();
+    if (pending > _uartHighWater)
+        _uartHighWater = pending;
+    _uartPump();
+#else
+    // Unbuffered: the UART write itself is the stall
+    unsigned long start = micros();
+    _usb.write(buffer, size);
+    uint32_t stallUs = (uint32_t)(micros() - start);
 #endif
+    if (stallUs > _maxStallUs)
+        _maxStallUs = stallUs;
+}
+
+void WifiSerialStream::_uartPump()
+{
+#if WIFI_SERIAL_UART_BUF_SIZE > 0
+    // Arduino cores expose no TX-empty callback, so pace on the free space in
+    // the UART FIFO instead: only ever write what it accepts without waiting.
+    uint16_t pending = _uartPending();
+    while (pending > 0)
+    {
+        int room = _usb.availableForWrite();
+        if (room <= 0)
+            break; // FIFO full; the next write() or loop() continues
+        uint16_t tailIdx = _uartTail & (WIFI_SERIAL_UART_BUF_SIZE - 1);
+        size_t contiguous = WIFI_SERIAL_UART_BUF_SIZE - tailIdx;
+        size_t toSend = (pending < contiguous) ? (size_t)pending : contiguous;
+        if (toSend > (size_t)room)
+            toSend = (size_t)room;
+        size_t sent = _usb.write(&_uartBuf[tailIdx], toSend);
+        if (sent == 0)
+            break;
+        _uartTail += (uint16_t)sent;
+        _uartStuck = false;
+        pending = _uartPending();
+    }
+#endif
+}
+
+void WifiSerialStream::_uartPrintf(const char *format, ...)
+{
+    // Sink status lines only; these go to the UART, not the TCP client
+    char buffer[128];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (len <= 0)
+        return;
+    if (len >= static_cast<int>(sizeof(buffer)))
+        len = sizeof(buffer) - 1;
+    _uartWrite(reinterpret_cast<const uint8_t *>(buffer), (size_t)len);
 }
 
 int WifiSerialStream::available()
@@ -297,6 +523,23 @@ void wifiSerialPrintln(const char *str)
     WiFiSerial.println(str);
 }
 
+// ------------------------------
+// Log sink for the LOG_* / TS_PRINT* macros (declared in logging.h)
+// ------------------------------
+
+void everblu_log_print(const char *text)
+{
+    WiFiSerial.print(text);
+}
+
+void everblu_log_printf(const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    WiFiSerial.vprintf(format, args);
+    va_end(args);
+}
+
 void wifiSerialPrintf(const char *format, ...)
 {
     char buffer[WIFI_SERIAL_PRINTF_BUFFER_SIZE];
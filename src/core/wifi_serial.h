@@ -10,6 +10,7 @@
 #define WIFI_SERIAL_H
 
 #include <Arduino.h>
+#include <stdarg.h>
 
 // Default TCP port for WiFi serial (Telnet default)
 #ifndef WIFI_SERIAL_PORT
@@ -22,16 +23,77 @@ extern WifiSerialStream WiFiSerial;
 
 /**
  * Combined USB + WiFi serial stream
- * Mirrors writes to both hardware Serial and the active WiFi client.
+ * Mirrors writes to both hardware Serial and the connected WiFi clients. Neither
+ * path blocks the caller: both are buffered and drained from loop().
  */
-// Async transmit ring-buffer size (bytes).  Must be a power of two.
-// 8192 gives ~8 KB of headroom to absorb a full meter read sequence
-// (WUP + RX + hex dump + 13-month history ≈ 3.5 KB) while loop() is
-// not being called during the CC1101 TX/RX phase.
-// Lowering saves RAM at the cost of more frequent drop events.
+// Async TCP transmit ring-buffer size (bytes).  Must be a power of two.
+// The ring is allocated from the heap when the first client connects and
+// freed when the last one leaves, so it costs nothing while nobody watches.
+// This is the largest size tried: 8192 gives ~8 KB of headroom to absorb a
+// full meter read sequence (WUP + RX + hex dump + 13-month history ≈ 3.5 KB)
+// while loop() is not being called during the CC1101 TX/RX phase.  If the
+// heap cannot spare it plus WIFI_SERIAL_HEAP_RESERVE, the size is halved down
+// to WIFI_SERIAL_TX_BUF_MIN (smaller rings drop more during a read).
 #ifndef WIFI_SERIAL_TX_BUF_SIZE
 #define WIFI_SERIAL_TX_BUF_SIZE 8192
 #endif
+#ifndef WIFI_SERIAL_TX_BUF_MIN
+#define WIFI_SERIAL_TX_BUF_MIN 1024
+#endif
+// Free heap (bytes) left for MQTT, TLS-free WiFi and the rest after the ring
+#ifndef WIFI_SERIAL_HEAP_RESERVE
+#define WIFI_SERIAL_HEAP_RESERVE 16384
+#endif
+
+// Telnet clients served at once (1-4).  All clients read the same broadcast
+// ring through their own cursor.  With 1, a new connection replaces the old
+// one; with more, connections beyond the limit are turned away.
+#ifndef WIFI_SERIAL_MAX_CLIENTS
+#define WIFI_SERIAL_MAX_CLIENTS 1
+#endif
+
+// A client that takes no data for this long while output is waiting for it
+// is disconnected, so it cannot hold the shared ring full for everyone (ms)
+#ifndef WIFI_SERIAL_CLIENT_STALL_MS
+#define WIFI_SERIAL_CLIENT_STALL_MS 10000UL
+#endif
+
+// Async UART transmit ring-buffer size (bytes).  Must be a power of two, or 0
+// to write straight to the UART as before.  Writes only copy into this ring
+// and top up the UART FIFO with as much as it accepts without waiting
+// (availableForWrite()); loop() drains the rest.  2048 bytes is ~180 ms of
+// output at 115200 baud, enough for everything logged during a radio read.
+// ESPHome never calls loop(), so the ring is off there by default.
+#ifndef WIFI_SERIAL_UART_BUF_SIZE
+#if defined(USE_ESPHOME)
+#define WIFI_SERIAL_UART_BUF_SIZE 0
+#else
+#define WIFI_SERIAL_UART_BUF_SIZE 2048
+#endif
+#endif
+
+// Longest one write may wait for UART space while the ring is full before the
+// rest of that write is dropped (microseconds).  A burst larger than the ring
+// just waits for the FIFO as before; a stuck port (e.g. USB CDC with no host)
+// costs each write at most this long.
+#ifndef WIFI_SERIAL_UART_STALL_LIMIT_US
+#define WIFI_SERIAL_UART_STALL_LIMIT_US 2000
+#endif
+
+/**
+ * Log sink counters, lifetime totals since boot
+ */
+struct WifiSerialStats
+{
+    uint32_t uartDropped;   // bytes lost because the UART stayed full
+    uint32_t tcpDropped;    // bytes lost because the TCP ring was full
+    uint32_t maxStallUs;    // longest time a single write waited for the UART
+    uint16_t uartHighWater; // most bytes ever pending in the UART ring
+    uint32_t tcpBytesSent;  // bytes written to TCP clients, summed over clients
+    uint16_t tcpHighWater;  // most bytes ever pending in the TCP ring
+    uint32_t tcpBufSize;    // current TCP ring allocation, 0 with no client
+    uint8_t tcpClients;     // clients connected now
+};
 
 class WifiSerialStream : public Print
 {
@@ -40,10 +102,27 @@ class WifiSerialStream : public Print
                   "WIFI_SERIAL_TX_BUF_SIZE must be a power of two");
     static_assert(WIFI_SERIAL_TX_BUF_SIZE <= 65536U,
                   "WIFI_SERIAL_TX_BUF_SIZE must fit within uint16_t arithmetic (max 65536)");
+    static_assert((WIFI_SERIAL_TX_BUF_MIN & (WIFI_SERIAL_TX_BUF_MIN - 1)) == 0 &&
+                      WIFI_SERIAL_TX_BUF_MIN >= 256 && WIFI_SERIAL_TX_BUF_MIN <= WIFI_SERIAL_TX_BUF_SIZE,
+                  "WIFI_SERIAL_TX_BUF_MIN must be a power of two between 256 and WIFI_SERIAL_TX_BUF_SIZE");
+    static_assert(WIFI_SERIAL_MAX_CLIENTS >= 1 && WIFI_SERIAL_MAX_CLIENTS <= 4,
+                  "WIFI_SERIAL_MAX_CLIENTS must be between 1 and 4");
+    static_assert((WIFI_SERIAL_UART_BUF_SIZE & (WIFI_SERIAL_UART_BUF_SIZE - 1)) == 0,
+                  "WIFI_SERIAL_UART_BUF_SIZE must be 0 or a power of two");
+    static_assert(WIFI_SERIAL_UART_BUF_SIZE <= 65536U,
+                  "WIFI_SERIAL_UART_BUF_SIZE must fit within uint16_t arithmetic (max 65536)");
 
 public:
     // Use Stream& to support HardwareSerial, HWCDC (ESP32-S3 USB), and other Serial types
-    explicit WifiSerialStream(Stream &usb) : _usb(usb), _head(0), _tail(0), _dropped(0), _lastSendMs(0) {}
+    explicit WifiSerialStream(Stream &usb)
+        : _usb(usb), _txBuf(nullptr), _txSize(0), _txMask(0), _head(0), _tails{}, _attached{}, _lastProgressMs{},
+          _dropped(0), _lastSendMs(0), _tcpBytesSent(0), _tcpHighWater(0),
+#if WIFI_SERIAL_UART_BUF_SIZE > 0
+          _uartHead(0), _uartTail(0), _uartStuck(false),
+#endif
+          _uartDropped(0), _uartDroppedReported(0), _tcpDroppedTotal(0), _maxStallUs(0), _uartHighWater(0)
+    {
+    }
 
     // Basic Serial-compatible API
     // Forward to the real global Serial so remapped Serial.begin() still
@@ -55,6 +134,7 @@ public:
     int read();
     int peek();
     size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+    size_t vprintf(const char *format, va_list args);
     using Print::write;
     size_t write(uint8_t c) override;
     size_t write(const uint8_t *buffer, size_t size) override;
@@ -64,38 +144,96 @@ public:
     void beginServer();
     void loop();
 
+    // Drop and stall counters for diagnostics
+    WifiSerialStats stats() const;
+
 private:
     Stream &_usb;
 
-    // Async ring buffer for WiFi TX (never blocks the caller)
-    uint8_t _txBuf[WIFI_SERIAL_TX_BUF_SIZE];
-    volatile uint16_t _head;   // write index (producer)
-    volatile uint16_t _tail;   // read  index (consumer, drained in loop())
+    // Async broadcast ring buffer for WiFi TX (never blocks the caller).
+    // Heap-allocated only while at least one client is attached.
+    uint8_t *_txBuf;
+    uint32_t _txSize;                                 // allocated size (power of two), 0 when none
+    uint16_t _txMask;                                 // _txSize - 1
+    volatile uint16_t _head;                          // write index (producer)
+    volatile uint16_t _tails[WIFI_SERIAL_MAX_CLIENTS]; // read index per client (drained in loop())
+    bool _attached[WIFI_SERIAL_MAX_CLIENTS];
+    unsigned long _lastProgressMs[WIFI_SERIAL_MAX_CLIENTS]; // millis() when the client last took data
     uint32_t _dropped;         // bytes silently dropped when buffer was full
-    unsigned long _lastSendMs; // millis() when data was last sent to client
+    unsigned long _lastSendMs; // millis() when data was last sent to a client
+    uint32_t _tcpBytesSent;
+    uint16_t _tcpHighWater;
 
-    // Returns number of free bytes in the ring buffer
-    inline uint16_t _free() const
+    // Bytes waiting for one client
+    inline uint16_t _pending(uint8_t slot) const
     {
         // Cast the head/tail delta to uint16_t before masking: the subtraction is
         // otherwise promoted to signed int and can be negative after wraparound,
         // which would make the bitwise AND rely on implementation-defined behaviour.
-        return (WIFI_SERIAL_TX_BUF_SIZE - 1) -
-               ((uint16_t)(_head - _tail) & (WIFI_SERIAL_TX_BUF_SIZE - 1));
+        return (uint16_t)(_head - _tails[slot]) & _txMask;
+    }
+
+    // Returns number of free bytes in the ring buffer (limited by the slowest client)
+    inline uint16_t _free() const
+    {
+        if (_txBuf == nullptr)
+            return 0;
+        uint16_t used = 0;
+        for (uint8_t i = 0; i < WIFI_SERIAL_MAX_CLIENTS; i++)
+        {
+            if (_attached[i] && _pending(i) > used)
+                used = _pending(i);
+        }
+        return (uint16_t)(_txMask - used);
     }
 
-    // Enqueue one byte; returns false and increments _dropped if full
-    inline bool _enqueue(uint8_t c)
+    // Enqueue as much as fits; the rest is counted in _dropped
+    inline void _enqueue(const uint8_t *data, size_t size)
     {
-        if (_free() == 0)
+        uint16_t room = _free();
+        size_t n = (size < room) ? size : room;
+        for (size_t i = 0; i < n; i++)
         {
-            _dropped++;
-            return false;
+            _txBuf[_head & _txMask] = data[i];
+            _head++;
         }
-        _txBuf[_head & (WIFI_SERIAL_TX_BUF_SIZE - 1)] = c;
-        _head++;
-        return true;
+        if (n < size)
+        {
+            _dropped += (uint32_t)(size - n);
+            _tcpDroppedTotal += (uint32_t)(size - n);
+        }
+        uint16_t used = (uint16_t)(_txMask - room + n);
+        if (used > _tcpHighWater)
+            _tcpHighWater = used;
     }
+
+    bool _allocTxBuf();
+    void _attach(uint8_t slot);
+    void _detach(uint8_t slot);
+    void _drain(uint8_t slot);
+
+#if WIFI_SERIAL_UART_BUF_SIZE > 0
+    // Async ring buffer for UART TX (drained into the FIFO, never waited on
+    // unless the ring itself is full)
+    uint8_t _uartBuf[WIFI_SERIAL_UART_BUF_SIZE];
+    volatile uint16_t _uartHead; // write index (producer)
+    volatile uint16_t _uartTail; // read  index (consumer, _uartPump())
+    bool _uartStuck;             // last full-ring wait timed out; drop until the UART moves
+
+    inline uint16_t _uartPending() const
+    {
+        return (uint16_t)(_uartHead - _uartTail) & (WIFI_SERIAL_UART_BUF_SIZE - 1);
+    }
+#endif
+    uint32_t _uartDropped;         // bytes dropped by _uartWrite()
+    uint32_t _uartDroppedReported; // _uartDropped at the last notice
+    uint32_t _tcpDroppedTotal;     // _dropped, but never reset
+    uint32_t _maxStallUs;
+    uint16_t _uartHighWater;
+
+    void _uartWrite(const uint8_t *buffer, size_t size);
+    void _uartPump();
+    void _uartPrintf(const char *format, ...) __attribute__((format(printf, 2, 3)));
 };
 
 // C-style helpers retained for minimal integration
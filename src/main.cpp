@@ -32,6 +32,19 @@
 #include "services/schedule_manager.h"  // Schedule management
 #include "services/meter_history.h"      // Shared historical data processing (JSON + serial)
 #include "services/frequency_manager.h" // Shared frequency calibration (scan/adaptive/storage)
+#include "services/read_slot_stats.h"   // Read outcome histogram for auto-align
+#include "services/meter_clock_tracker.h" // Meter RTC offset/drift for wake window edges
+#include "services/retry_policy.h"        // Retry backoff, attempt budget and cooldown
+#include "services/read_budget.h"         // Token bucket over read attempts and scans
+#include "services/json_writer.h"         // Allocation-free JSON for discovery and state payloads
+#include "services/reading_queue.h"       // Readings held while the broker is unreachable
+#include "services/publish_filter.h"      // Change-only publishing with periodic full refresh
+#include "services/reading_codec.h"       // Compact binary reading payload
+#include "services/storage_abstraction.h" // Persisted discovery hash
+#include "services/read_timeline.h"       // Per-phase read latency percentiles
+#include "services/spi_stats.h"           // SPI transaction counters of the last read
+#include "services/runtime_diagnostics.h" // Heap, stack high-water and loop-block telemetry
+#include "adapters/implementations/ntp_time_provider.h" // Non-blocking NTP sync state
 #if defined(ESP8266)
 #include <ESP8266WiFi.h> // Wi-Fi library for ESP8266
 #include <ESP8266mDNS.h> // mDNS library for ESP8266
@@ -141,6 +154,32 @@ static int g_readMinuteLocal = DEFAULT_READING_MINUTE_UTC;
 // Used to control whether auto-alignment should be applied to future scheduled reads
 static bool g_isScheduledRead = false;
 
+// Next scheduled read as an absolute UTC epoch (0 = none). Computed by
+// ScheduleManager and only recomputed when the reading time changes
+// (auto-align) or the clock steps backwards; onScheduled() just compares.
+static time_t g_nextScheduledReadUtc = 0;
+static ScheduleMask g_scheduleMask = {0, 0}; // Compiled by validateReadingSchedule()
+static time_t g_lastScheduledFireUtc = 0;
+static time_t g_lastScheduleCheckUtc = 0;
+static bool g_scheduleDirty = true;
+
+// Read outcomes by local hour and weekday, persisted so auto-align keeps
+// learning the best slot in the meter's wake window across reboots
+#define READ_SLOT_STATS_KEY "slot_hist"
+static ReadSlotStats g_readSlotStats;
+static int g_sessionHourLocal = -1; // Local-offset hour the current read session started, -1 = unknown
+static int g_sessionWeekday = 0;
+
+// Meter clock offset and drift, used to place reads clear of the wake window edges
+#define WINDOW_EDGE_GUARD_MIN 2
+static MeterClockTracker g_meterClock;
+static int g_meterWindowStart = -1; // Wake window from the last successful read (meter time base)
+static int g_meterWindowEnd = -1;
+
+// A missed deadline (blocked loop, cooldown) still fires if it is no older
+// than this; later than that the meter's wake window has likely passed.
+#define SCHEDULE_CATCH_UP_WINDOW_S (60 * 60)
+
 // Define a default meter frequency if missing from private.h.
 // RADIAN protocol nominal center frequency for EverBlu is 433.82 MHz.
 #ifndef FREQUENCY
@@ -165,7 +204,7 @@ bool cc1101RadioConnected = false; // Tracks whether the radio is detected and i
 // state now live in the shared FrequencyManager (src/services/frequency_manager.cpp),
 // which this build initializes in setup(). EEPROM_SIZE is retained only for the
 // optional CLEAR_EEPROM_ON_BOOT maintenance path below.
-#define EEPROM_SIZE 64
+#define EEPROM_SIZE 128
 bool autoScanEnabled = (AUTO_SCAN_ENABLED != 0);                     // Enable automatic scan on first boot if no offset found
 bool autoScanOnFailureEnabled = (AUTO_SCAN_ON_FAILURE_ENABLED != 0); // Enable automatic scan after max retries reached
 
@@ -260,13 +299,6 @@ EspMQTTClient mqtt(
 // Centralising this avoids repeating "everblu/cyble/" all over the code.
 // mqttBaseTopic is populated during setup() after parsing METER_CODE.
 
-const char jsonTemplate[] = "{ "
-                            "\"liters\": %d, "
-                            "\"counter\" : %d, "
-                            "\"battery\" : %d, "
-                            "\"rssi\" : %d, "
-                            "\"timestamp\" : \"%s\" }";
-
 // Define the default maximum retries if missing from the private.h file
 #ifndef MAX_RETRIES
 #define MAX_RETRIES 5 // Default: 5 retry attempts before cooldown
@@ -274,11 +306,54 @@ const char jsonTemplate[] = "{ "
 
 int _retry = 0;
 const int max_retries = MAX_RETRIES;          // Maximum number of retry attempts (configurable in private.h)
-unsigned long lastFailedAttempt = 0;          // Timestamp of last failed attempt
-const unsigned long RETRY_COOLDOWN = 3600000; // 1 hour cooldown in milliseconds
+const unsigned long RETRY_COOLDOWN = 3600000; // 1 hour cooldown in milliseconds, doubled per further failed session
+static RetryPolicy g_retryPolicy;             // Backoff with jitter, attempt budget and cooldown
 bool g_autoScanAfterFailureDone = false;      // Guards the failure-recovery frequency scan to once per failure streak
 bool g_postScanReadAttempted = false;         // Guards the single post-scan re-read to once per failure streak
 
+// A manual trigger within this many seconds of the last good read keeps that
+// reading (the retained MQTT topics already hold it) instead of waking the
+// meter, which costs meter battery. trigger_force always reads. 0 disables.
+#ifndef READ_CACHE_MAX_AGE_S
+#define READ_CACHE_MAX_AGE_S 60
+#endif
+static bool g_haveReading = false;
+static unsigned long g_lastReadingMs = 0; // millis() of the last successful read
+
+// Read budget: every read attempt costs a token and a frequency scan costs
+// ReadBudget::SCAN_COST. Scheduled reads may spend the last tokens; manual
+// reads and scans must leave MAX_RETRIES for the next scheduled session.
+#ifndef READ_BUDGET_PER_DAY
+#define READ_BUDGET_PER_DAY 24 // Tokens refilled per day (0 = unlimited)
+#endif
+#ifndef READ_BUDGET_BURST
+#define READ_BUDGET_BURST 10 // Bucket capacity
+#endif
+static ReadBudget g_readBudget;
+
+// Heap and stack are sampled around each read and with the Wi-Fi details; the
+// loop histogram counts the time between loop() entries, i.e. one pass plus
+// the core's own work (Wi-Fi stack, yield) in between
+static RuntimeDiagnostics g_diagnostics;
+static unsigned long g_lastLoopStartMs = 0;
+
+// Store-and-forward: a reading taken while Wi-Fi or the broker is down is kept
+// with its original timestamp and published, oldest first and paced, after the
+// next connect. PUBLISH_QUEUE_PERSIST 1 also keeps the newest queued readings
+// in flash so they survive the offline reboot (ESP32 only: the ESP8266 EEPROM
+// has a single record slot, used by the read slot statistics).
+#ifndef PUBLISH_QUEUE_PERSIST
+#define PUBLISH_QUEUE_PERSIST 0
+#endif
+#if PUBLISH_QUEUE_PERSIST && !defined(ESP32)
+#error "PUBLISH_QUEUE_PERSIST requires ESP32 (the ESP8266 storage slot is used by the read slot statistics)"
+#endif
+#define READING_QUEUE_KEY "rd_queue"
+static_assert(StorageAbstraction::keyFits(READING_QUEUE_KEY), "ESP32 NVS keys (with the _magic suffix) are limited to 15 characters");
+#define READING_QUEUE_DRAIN_INTERVAL_MS 1000
+static ReadingQueue g_readingQueue;
+static bool g_readingQueueDraining = false;
+
 // Global variable to store the reading schedule (default from private.h)
 const char *readingSchedule = DEFAULT_READING_SCHEDULE;
 
@@ -300,6 +375,17 @@ const char *readingSchedule = DEFAULT_READING_SCHEDULE;
 #define ENABLE_HA_DISCOVERY 1
 #endif
 
+// Discovery is retained by the broker, so a reconnect only republishes it when
+// its content changed (new firmware or settings) or Home Assistant restarted
+// (its birth message on homeassistant/status). The hash of the last published
+// set is persisted so a reboot does not republish it either.
+#define DISCOVERY_HASH_KEY "disc_hash"
+#define DISCOVERY_HASH_MAGIC 0xD15C
+static uint32_t g_discoveryPublishedHash = 0; // 0 = never published
+static uint32_t g_discoveryHash = 0;          // Accumulated by the current pass
+static bool g_discoveryHashOnly = false;      // Hash the payloads without publishing them
+static bool g_discoveryPublishFailed = false;
+
 // Buffer sizes for MQTT topics are intentionally conservative for future-proofing.
 // Current worst-case payloads are significantly smaller than these buffers.
 // Parsed at runtime from METER_CODE by parseMeterCode() called at the start of setup()
@@ -339,6 +425,143 @@ static void parseMeterCode()
 // Buffer size: 128 bytes provides 1.45x safety margin for topic construction
 #define MQTT_TOPIC_BUFFER_SIZE 128
 
+// Publish each reading as one retained JSON document on {base}/state instead of
+// one retained topic per value. Discovery then points every reading entity at
+// that topic with a value template. Default 0 keeps the per-value topics.
+#ifndef MQTT_CONSOLIDATED_STATE
+#define MQTT_CONSOLIDATED_STATE 0
+#endif
+
+// Compact binary payload for a local ingester (see src/services/reading_codec.h):
+// 1 also publishes each reading, with its history, in about 50 bytes on {base}/binary;
+// 2 publishes only that, dropping the per-value topics, /json, /state and the
+// history attributes, and with them the reading entities from discovery.
+// Default 0 publishes text only.
+#ifndef MQTT_BINARY_PAYLOAD
+#define MQTT_BINARY_PAYLOAD 0
+#endif
+#if MQTT_BINARY_PAYLOAD < 0 || MQTT_BINARY_PAYLOAD > 2
+#error "MQTT_BINARY_PAYLOAD must be 0, 1 or 2"
+#endif
+
+// Change-only publishing: a table topic whose value has not changed since it
+// was last published is skipped, except once every PUBLISH_FULL_REFRESH_S and
+// after every (re)connect. 0 publishes every value every time.
+#ifndef PUBLISH_FULL_REFRESH_S
+#define PUBLISH_FULL_REFRESH_S 3600
+#endif
+
+// Topics published on every read attempt and Wi-Fi update. They are built once
+// by buildTopicTable() so the publish burst formats no topic strings and does
+// not touch the heap.
+#define MQTT_READ_TOPICS(X)                                  \
+  X(TOPIC_LITERS, "/liters")                                 \
+  X(TOPIC_LITERS_ATTRIBUTES, "/liters_attributes")           \
+  X(TOPIC_COUNTER, "/counter")                               \
+  X(TOPIC_BATTERY, "/battery")                               \
+  X(TOPIC_RSSI_DBM, "/rssi_dbm")                             \
+  X(TOPIC_RSSI_PERCENTAGE, "/rssi_percentage")               \
+  X(TOPIC_LQI, "/lqi")                                       \
+  X(TOPIC_LQI_PERCENTAGE, "/lqi_percentage")                 \
+  X(TOPIC_TIME_START, "/time_start")                         \
+  X(TOPIC_TIME_END, "/time_end")                             \
+  X(TOPIC_TIMESTAMP, "/timestamp")                           \
+  X(TOPIC_METER_TIME, "/meter_time")                         \
+  X(TOPIC_METER_TYPE, "/meter_type")                         \
+  X(TOPIC_JSON, "/json")                                     \
+  X(TOPIC_STATE, "/state")                                   \
+  X(TOPIC_BINARY, "/binary")                                 \
+  X(TOPIC_ACTIVE_READING, "/active_reading")                 \
+  X(TOPIC_CC1101_STATE, "/cc1101_state")                     \
+  X(TOPIC_SUCCESSFUL_READS, "/successful_reads")             \
+  X(TOPIC_FAILED_READS, "/failed_reads")                     \
+  X(TOPIC_TOTAL_ATTEMPTS, "/total_attempts")                 \
+  X(TOPIC_LAST_ERROR, "/last_error")                         \
+  X(TOPIC_STATUS_MESSAGE, "/status_message")                 \
+  X(TOPIC_WIFI_IP, "/wifi_ip")                               \
+  X(TOPIC_WIFI_RSSI, "/wifi_rssi")                           \
+  X(TOPIC_WIFI_SIGNAL_PERCENTAGE, "/wifi_signal_percentage") \
+  X(TOPIC_MAC_ADDRESS, "/mac_address")                       \
+  X(TOPIC_WIFI_SSID, "/wifi_ssid")                           \
+  X(TOPIC_WIFI_BSSID, "/wifi_bssid")                         \
+  X(TOPIC_STATUS, "/status")                                 \
+  X(TOPIC_UPTIME, "/uptime")                                 \
+  X(TOPIC_READ_TIMELINE, "/read_timeline")                   \
+  X(TOPIC_SPI_STATS, "/spi_stats")                           \
+  X(TOPIC_DIAGNOSTICS, "/diagnostics")                       \
+  X(TOPIC_CC1101_AVAILABILITY, "/cc1101_availability")       \
+  X(TOPIC_FREQUENCY_OFFSET, "/frequency_offset")             \
+  X(TOPIC_TUNED_FREQUENCY, "/tuned_frequency")               \
+  X(TOPIC_FREQUENCY_ESTIMATE, "/frequency_estimate")         \
+  X(TOPIC_METER_YEAR, "/everblu_meter_year")                 \
+  X(TOPIC_METER_SERIAL, "/everblu_meter_serial")             \
+  X(TOPIC_READING_SCHEDULE, "/reading_schedule")             \
+  X(TOPIC_READING_TIME, "/reading_time")
+
+#define X_TOPIC_ID(id, suffix) id,
+enum MqttTopicId
+{
+  MQTT_READ_TOPICS(X_TOPIC_ID)
+  TOPIC_COUNT
+};
+#undef X_TOPIC_ID
+
+static PublishFilter g_publishFilter;
+static_assert(TOPIC_COUNT <= PublishFilter::MAX_ENTITIES, "Every table topic needs a publish filter slot");
+
+// History of the last frame, with its statistics and rendered attributes JSON
+static HistoryModel g_historyModel;
+
+// parseMeterCode() never produces a base topic longer than this
+#define MQTT_BASE_TOPIC_MAX_LEN (sizeof("everblu/cyble/4294967295") - 1)
+
+#define X_TOPIC_SIZE(id, suffix) (MQTT_BASE_TOPIC_MAX_LEN + sizeof(suffix)) +
+static char g_topicTable[MQTT_READ_TOPICS(X_TOPIC_SIZE) 0]; // Packed, NUL-separated topics
+#undef X_TOPIC_SIZE
+static const char *g_topics[TOPIC_COUNT] = {};
+
+// Build the topic table from mqttBaseTopic. Call once after parseMeterCode().
+static void buildTopicTable()
+{
+#define X_TOPIC_SUFFIX(id, suffix) suffix,
+  static const char *const suffixes[TOPIC_COUNT] = {MQTT_READ_TOPICS(X_TOPIC_SUFFIX)};
+#undef X_TOPIC_SUFFIX
+
+  char *next = g_topicTable;
+  size_t left = sizeof(g_topicTable);
+  for (int i = 0; i < TOPIC_COUNT; i++)
+  {
+    snprintf(next, left, "%s%s", mqttBaseTopic, suffixes[i]);
+    g_topics[i] = next;
+    const size_t used = strlen(next) + 1;
+    next += used;
+    left -= used;
+  }
+}
+
+// Publish a retained payload on a table topic without building a String.
+// Payloads unchanged since their last successful publish are skipped until
+// the next full refresh, unless force is set. Returns false only when the
+// client failed to send; a skipped payload is already on the broker.
+static bool publishRetained(MqttTopicId id, const uint8_t *payload, size_t length, bool force = false)
+{
+  if (!force && !g_publishFilter.shouldPublish(id, payload, length, millis()))
+  {
+    return true;
+  }
+  if (!mqtt.publish(g_topics[id], payload, length, true))
+  {
+    return false;
+  }
+  g_publishFilter.markPublished(id, payload, length);
+  return true;
+}
+
+static bool publishRetained(MqttTopicId id, const char *payload, bool force = false)
+{
+  return publishRetained(id, reinterpret_cast<const uint8_t *>(payload), strlen(payload), force);
+}
+
 // ============================================================================
 // Meter Type Configuration
 // ============================================================================
@@ -398,6 +621,10 @@ static void validateReadingSchedule()
     TS_PRINTF("[WARNING] Invalid reading schedule '%s'. Falling back to 'Monday-Friday'.\n", readingSchedule);
     readingSchedule = "Monday-Friday";
   }
+
+  // Compile once so each scheduler check is a bit test, not a string compare
+  ScheduleManager::compileSchedule(readingSchedule, g_scheduleMask);
+  g_scheduleDirty = true;
 }
 
 /**
@@ -417,6 +644,7 @@ static void updateResolvedScheduleFromLocal(int hourLocal, int minuteLocal)
     utcMin += 24 * 60;
   g_readHourUtc = utcMin / 60;
   g_readMinuteUtc = utcMin % 60;
+  g_scheduleDirty = true;
 }
 
 /**
@@ -436,8 +664,98 @@ static void updateResolvedScheduleFromUtc(int hourUtc, int minuteUtc)
     localMin += 24 * 60;
   g_readHourLocal = localMin / 60;
   g_readMinuteLocal = localMin % 60;
+  g_scheduleDirty = true;
 }
 
+/**
+ * @brief Remember the local-offset slot a new read session starts in
+ */
+static void beginReadSession()
+{
+  g_sessionHourLocal = -1;
+  time_t tnow = time(nullptr);
+  if (tnow < 1609459200) // No valid wall clock yet
+    return;
+
+  time_t local = tnow + (time_t)TIMEZONE_OFFSET_MINUTES * 60;
+  struct tm *ptm = gmtime(&local);
+  g_sessionHourLocal = ptm->tm_hour;
+  g_sessionWeekday = ptm->tm_wday;
+}
+
+/**
+ * @brief Record the finished read session in the slot histogram and persist it
+ */
+static void recordReadSession(int attempts, bool success)
+{
+  if (g_sessionHourLocal < 0)
+    return;
+
+  g_readSlotStats.recordSession(g_sessionHourLocal, g_sessionWeekday, attempts, success);
+  g_readSlotStats.save(READ_SLOT_STATS_KEY);
+  TS_PRINTF("[SCHEDULE] Read slot %02d:00 local: %d%% first-attempt over %u sessions\n", g_sessionHourLocal,
+            g_readSlotStats.getFirstAttemptPercent(g_sessionHourLocal), (unsigned)g_readSlotStats.getSessions(g_sessionHourLocal));
+  g_sessionHourLocal = -1;
+}
+
+#if AUTO_ALIGN_READING_TIME
+/**
+ * @brief Move the scheduled read to the best slot in the meter's wake window
+ *
+ * Called after each scheduled session (successful or failed) once a read has
+ * reported the window. The slot applies from the next local-offset day.
+ */
+static void alignReadTimeToMeterWindow(time_t tnow)
+{
+  // The window is in the meter's own time base; shift it onto local-offset hours
+  int shiftMinutes = g_meterClock.isValid() ? g_meterClock.getShiftMinutes(tnow, TIMEZONE_OFFSET_MINUTES) : 0;
+  int shiftHours = (shiftMinutes >= 0) ? (shiftMinutes + 30) / 60 : -((-shiftMinutes + 30) / 60);
+  int timeStart = ((g_meterWindowStart - shiftHours) % 24 + 24) % 24;
+  int timeEnd = ((g_meterWindowEnd - shiftHours) % 24 + 24) % 24;
+  int window = (timeEnd - timeStart + 24) % 24; // hours in window (0 means unknown/all-day)
+  if (window == 0)
+    return;
+
+#if AUTO_ALIGN_USE_MIDPOINT
+  int anchorHourLocal = (timeStart + (window / 2)) % 24; // midpoint (interpreted as local-offset time)
+#else
+  int anchorHourLocal = timeStart; // start of window (local-offset time)
+#endif
+  // Explore the window from the anchor, then settle on the hour where the
+  // meter answers first time most often (see ReadSlotStats)
+  int alignedHourLocal = g_readSlotStats.chooseHour(timeStart, timeEnd, anchorHourLocal, g_readHourLocal);
+  if (alignedHourLocal < 0)
+    return;
+
+  // Configured minute, nudged clear of the window edges predicted from the meter clock
+  int baseMinuteLocal = ((DEFAULT_READING_MINUTE_UTC + TIMEZONE_OFFSET_MINUTES) % 60 + 60) % 60;
+  int alignedMinuteOfDay = alignedHourLocal * 60 + baseMinuteLocal;
+  if (g_meterClock.isValid())
+  {
+    alignedMinuteOfDay = MeterClockTracker::guardReadMinute(alignedMinuteOfDay, g_meterWindowStart, g_meterWindowEnd,
+                                                            shiftMinutes, WINDOW_EDGE_GUARD_MIN);
+  }
+  if (alignedMinuteOfDay == g_readHourLocal * 60 + g_readMinuteLocal)
+    return;
+
+  updateResolvedScheduleFromLocal(alignedMinuteOfDay / 60, alignedMinuteOfDay % 60);
+
+  // Today's read is done: the new slot starts tomorrow
+  g_nextScheduledReadUtc = ScheduleManager::computeNextFireUtc(
+      ScheduleManager::startOfNextLocalDayUtc(tnow, TIMEZONE_OFFSET_MINUTES), g_scheduleMask,
+      g_readHourUtc, g_readMinuteUtc, TIMEZONE_OFFSET_MINUTES);
+  g_scheduleDirty = false;
+
+  // Publish updated reading_time HH:MM
+  char readingTimeFormatted2[6];
+  snprintf(readingTimeFormatted2, sizeof(readingTimeFormatted2), "%02d:%02d", g_readHourUtc, g_readMinuteUtc);
+  publishRetained(TOPIC_READING_TIME, readingTimeFormatted2);
+
+  TS_PRINTF("[SCHEDULE] Auto-aligned reading time to %02d:%02d local-offset (%02d:%02d UTC) (window %02d-%02d local)\n",
+            g_readHourLocal, g_readMinuteLocal, g_readHourUtc, g_readMinuteUtc, timeStart, timeEnd);
+}
+#endif
+
 // Note: isReadingDay() is now in ScheduleManager class
 
 // ============================================================================
@@ -475,6 +793,13 @@ static bool g_ledState = false;
 static bool g_prevWifiUp = false;
 static bool g_prevMqttUp = false;
 
+// NTP runs in the background: the connect callback only starts it, the
+// scheduler waits for isTimeSynced() and loop() reports the clock once set
+#define NTP_SYNC_WARN_MS 10000UL
+static NTPTimeProvider g_timeProvider;
+static bool g_timeSyncReported = false;
+static bool g_timeSyncWarned = false;
+
 // Helper: translate Wi-Fi wl_status_t to readable string
 static const char *wifiStatusToString(wl_status_t st)
 {
@@ -503,6 +828,292 @@ static const char *wifiStatusToString(wl_status_t st)
   }
 }
 
+// Function: publishTextReading
+// Description: Publishes the values of one reading as text. Topics come from the
+//              prebuilt table and payloads from stack buffers, so the burst
+//              allocates nothing and needs no pacing delays. A reading replayed
+//              from the store-and-forward queue has no meterTime/meterType; those
+//              topics keep their last value.
+static bool publishTextReading(const QueuedReading &reading, const char *meterTime, const char *meterType, bool force)
+{
+  // NOTE: reading.volume is the raw counter value from the meter (liters for water;
+  // for gas, this raw counter is converted to cubic meters using GAS_VOLUME_DIVISOR).
+  char volumeBuffer[32];
+
+  if (meterIsGas)
+  {
+    // Gas meters: publish value in m³ (volume / GAS_VOLUME_DIVISOR)
+    // Default divisor 100 = 0.01 m³ per unit (typical EverBlu Cyble gas module)
+    float cubicMeters = reading.volume / (float)GAS_VOLUME_DIVISOR;
+    snprintf(volumeBuffer, sizeof(volumeBuffer), "%.3f", cubicMeters);
+  }
+  else
+  {
+    // Water meters: publish value in liters
+    snprintf(volumeBuffer, sizeof(volumeBuffer), "%ld", (long)reading.volume);
+  }
+
+  char iso8601[24];
+  const time_t readTime = (time_t)reading.timestamp;
+  strftime(iso8601, sizeof iso8601, "%FT%TZ", gmtime(&readTime));
+
+  // Format the wake window hours as "HH:MM"
+  char timeStartFormatted[6];
+  char timeEndFormatted[6];
+  snprintf(timeStartFormatted, sizeof(timeStartFormatted), "%02d:00", reading.timeStart);
+  snprintf(timeEndFormatted, sizeof(timeEndFormatted), "%02d:00", reading.timeEnd);
+
+  bool ok = true;
+
+#if MQTT_CONSOLIDATED_STATE
+  // One retained document replaces the per-value topics; discovery reads each
+  // entity out of it with a value template (see writeStateTopic())
+  char stateJson[512];
+  JsonWriter state(stateJson, sizeof(stateJson));
+  state.beginObject();
+  state.key("liters");
+  state.raw(volumeBuffer);
+  state.field("counter", reading.readsCounter);
+  state.field("battery", reading.batteryMonths);
+  state.field("rssi", reading.rssi);
+  state.field("rssi_dbm", reading.rssiDbm);
+  state.field("rssi_percentage", calculateMeterdBmToPercentage(reading.rssiDbm));
+  state.field("lqi", reading.lqi);
+  state.field("lqi_percentage", calculateLQIToPercentage(reading.lqi));
+  state.field("time_start", timeStartFormatted);
+  state.field("time_end", timeEndFormatted);
+  state.field("timestamp", iso8601);
+  if (meterTime)
+    state.field("meter_time", meterTime);
+  if (meterType)
+    state.field("meter_type", meterType);
+  state.endObject();
+  ok &= publishRetained(TOPIC_STATE, stateJson, force);
+#else
+  char valueBuffer[16];
+
+  ok &= publishRetained(TOPIC_LITERS, volumeBuffer, force);
+
+  snprintf(valueBuffer, sizeof(valueBuffer), "%d", reading.readsCounter);
+  ok &= publishRetained(TOPIC_COUNTER, valueBuffer, force);
+
+  snprintf(valueBuffer, sizeof(valueBuffer), "%d", reading.batteryMonths);
+  ok &= publishRetained(TOPIC_BATTERY, valueBuffer, force);
+
+  snprintf(valueBuffer, sizeof(valueBuffer), "%d", reading.rssiDbm);
+  ok &= publishRetained(TOPIC_RSSI_DBM, valueBuffer, force);
+
+  snprintf(valueBuffer, sizeof(valueBuffer), "%d", calculateMeterdBmToPercentage(reading.rssiDbm));
+  ok &= publishRetained(TOPIC_RSSI_PERCENTAGE, valueBuffer, force);
+
+  snprintf(valueBuffer, sizeof(valueBuffer), "%d", reading.lqi);
+  ok &= publishRetained(TOPIC_LQI, valueBuffer, force);
+  ok &= publishRetained(TOPIC_TIME_START, timeStartFormatted, force);
+  ok &= publishRetained(TOPIC_TIME_END, timeEndFormatted, force);
+  ok &= publishRetained(TOPIC_TIMESTAMP, iso8601, force); // timestamp since epoch in UTC
+  if (meterTime)
+    ok &= publishRetained(TOPIC_METER_TIME, meterTime, force); // meter's own real-time clock
+  if (meterType)
+    ok &= publishRetained(TOPIC_METER_TYPE, meterType, force); // meter type/identifier string
+
+  snprintf(valueBuffer, sizeof(valueBuffer), "%d", calculateLQIToPercentage(reading.lqi));
+  ok &= publishRetained(TOPIC_LQI_PERCENTAGE, valueBuffer, force);
+
+  // Publish all data as a JSON message as well this is redundant but may be useful for some
+  char summaryJson[160];
+  JsonWriter summary(summaryJson, sizeof(summaryJson));
+  summary.beginObject();
+  summary.field("liters", (long)reading.volume);
+  summary.field("counter", reading.readsCounter);
+  summary.field("battery", reading.batteryMonths);
+  summary.field("rssi", reading.rssi);
+  summary.field("timestamp", iso8601);
+  summary.endObject();
+  ok &= publishRetained(TOPIC_JSON, summaryJson, force);
+#endif
+  return ok;
+}
+
+// Function: publishReadTimeline
+// Description: Publishes p50/p95/max of the whole read and of each phase over the
+//              recent reads (see services/read_timeline.h) on {base}/read_timeline.
+static void publishReadTimeline()
+{
+  const ReadTimeline &timeline = cc1101_get_read_timeline();
+  if (timeline.size() == 0)
+    return;
+
+  char timelineJson[640];
+  JsonWriter json(timelineJson, sizeof(timelineJson));
+  timeline.writeJson(json);
+  if (!json.ok())
+  {
+    TS_PRINTLN("[MQTT] [WARN] Read timeline JSON did not fit its buffer, not published");
+    return;
+  }
+  const ReadPhaseStats total = timeline.getTotalStats();
+  TS_PRINTF("[TIMING] Read duration over %u reads: p50 %lu ms, p95 %lu ms, max %lu ms\n",
+            (unsigned)timeline.size(), (unsigned long)(total.p50Us / 1000),
+            (unsigned long)(total.p95Us / 1000), (unsigned long)(total.maxUs / 1000));
+  publishRetained(TOPIC_READ_TIMELINE, timelineJson);
+}
+
+// Function: publishSpiStats
+// Description: Publishes the SPI transaction counts and log2 latency histograms of
+//              the last read (see services/spi_stats.h) on {base}/spi_stats.
+static void publishSpiStats()
+{
+  const SpiStats &spi = cc1101_get_spi_stats();
+  if (spi.totalCount() == 0)
+    return;
+
+  char spiJson[768];
+  JsonWriter json(spiJson, sizeof(spiJson));
+  spi.writeJson(json);
+  if (!json.ok())
+  {
+    TS_PRINTLN("[MQTT] [WARN] SPI stats JSON did not fit its buffer, not published");
+    return;
+  }
+  TS_PRINTF("[TIMING] SPI: %lu transactions, %lu us in transfers\n",
+            (unsigned long)spi.totalCount(), (unsigned long)spi.totalUs());
+  publishRetained(TOPIC_SPI_STATS, spiJson);
+}
+
+// Function: publishRuntimeDiagnostics
+// Description: Publishes the last memory sample, the lowest free heap and stack
+//              headroom, the loop-block histogram and the memory before and after
+//              the last read (see services/runtime_diagnostics.h) on {base}/diagnostics.
+static void publishRuntimeDiagnostics()
+{
+  char diagnosticsJson[512];
+  JsonWriter json(diagnosticsJson, sizeof(diagnosticsJson));
+  g_diagnostics.writeJson(json);
+  if (!json.ok())
+  {
+    TS_PRINTLN("[MQTT] [WARN] Runtime diagnostics JSON did not fit its buffer, not published");
+    return;
+  }
+  const MemorySnapshot &last = g_diagnostics.getLast();
+  TS_PRINTF("[MEM] Heap %lu B free (min %lu B), largest block %lu B (%u%% fragmented), stack %lu B free, longest loop %lu ms\n",
+            (unsigned long)last.freeHeap, (unsigned long)g_diagnostics.getMinFreeHeap(),
+            (unsigned long)last.largestFreeBlock, (unsigned)last.fragmentationPct,
+            (unsigned long)g_diagnostics.getMinStackFree(), (unsigned long)g_diagnostics.getMaxLoopMs());
+  publishRetained(TOPIC_DIAGNOSTICS, diagnosticsJson);
+}
+
+// Function: publishBinaryReading
+// Description: Publishes one reading, and its history when given, as the compact
+//              binary payload on {base}/binary.
+static bool publishBinaryReading(const QueuedReading &reading, const HistoryModel *history, bool force)
+{
+  CompactReading compact = {};
+  compact.timestamp = reading.timestamp;
+  compact.volume = reading.volume;
+  compact.rssiDbm = reading.rssiDbm;
+  compact.lqi = reading.lqi;
+  compact.readsCounter = reading.readsCounter;
+  compact.batteryMonths = reading.batteryMonths;
+  compact.timeStart = reading.timeStart;
+  compact.timeEnd = reading.timeEnd;
+  compact.isGas = meterIsGas;
+  compact.frequencyOffsetHz = reading.frequencyOffsetHz;
+  if (history)
+  {
+    compact.historyCount = (uint8_t)history->getStats().monthCount;
+    memcpy(compact.history, history->getHistory(), sizeof(compact.history));
+  }
+
+  uint8_t payload[ReadingCodec::MAX_ENCODED_SIZE];
+  const size_t length = ReadingCodec::encode(compact, payload, sizeof(payload));
+  TS_PRINTF("[MQTT] Publishing binary reading (%u bytes, %u months of history)\n",
+            (unsigned)length, (unsigned)compact.historyCount);
+  return publishRetained(TOPIC_BINARY, payload, length, force);
+}
+
+// Function: publishReading
+// Description: Publishes one reading in the formats selected by MQTT_BINARY_PAYLOAD.
+//              history may be null. A replay from the store-and-forward queue is sent
+//              even when the publish filter holds the same payloads. Returns false if
+//              any publish failed.
+static bool publishReading(const QueuedReading &reading, const char *meterTime, const char *meterType,
+                           const HistoryModel *history, bool replay)
+{
+  bool ok = true;
+#if MQTT_BINARY_PAYLOAD
+  ok &= publishBinaryReading(reading, history, replay);
+#else
+  (void)history;
+#endif
+#if MQTT_BINARY_PAYLOAD != 2
+  ok &= publishTextReading(reading, meterTime, meterType, replay);
+#else
+  (void)meterTime;
+  (void)meterType;
+#endif
+  return ok;
+}
+
+// Function: drainReadingQueue
+// Description: Publishes queued readings oldest first, one per
+//              READING_QUEUE_DRAIN_INTERVAL_MS, while the connection stays up.
+static void drainReadingQueue()
+{
+  if (!mqtt.isConnected())
+  {
+    g_readingQueueDraining = false; // Resumed by the next onConnectionEstablished()
+    return;
+  }
+
+  QueuedReading reading;
+  if (!g_readingQueue.peek(reading))
+  {
+    g_readingQueueDraining = false;
+    TS_PRINTLN("[MQTT] Queued readings published");
+#if PUBLISH_QUEUE_PERSIST
+    g_readingQueue.save(READING_QUEUE_KEY);
+#endif
+    return;
+  }
+
+  TS_PRINTF("[MQTT] Publishing queued reading from %ld s ago (%u left)\n",
+            (long)(time(nullptr) - (time_t)reading.timestamp), (unsigned)g_readingQueue.size() - 1);
+  if (!publishReading(reading, nullptr, nullptr, nullptr, true))
+  {
+    // Keep the reading at the head; the next connection resumes from it
+    g_readingQueueDraining = false;
+    TS_PRINTLN("[MQTT] [WARN] Queued reading not sent, kept for the next connection");
+    return;
+  }
+  g_readingQueue.pop();
+  mqtt.executeDelayed(READING_QUEUE_DRAIN_INTERVAL_MS, drainReadingQueue);
+}
+
+// Function: queueReading
+// Description: Keeps a reading that cannot be published now, and starts
+//              draining if the connection is up (readings already waiting
+//              must go out first).
+static void queueReading(const QueuedReading &reading)
+{
+  if (!g_readingQueue.push(reading))
+  {
+    TS_PRINTF("[MQTT] [WARN] Reading queue full, oldest reading dropped (%lu dropped so far)\n",
+              g_readingQueue.getDropped());
+  }
+  if (mqtt.isConnected())
+    TS_PRINTF("[MQTT] Reading queued behind older readings (%u waiting)\n", (unsigned)g_readingQueue.size());
+  else
+    TS_PRINTF("[MQTT] Broker unreachable, reading queued (%u waiting)\n", (unsigned)g_readingQueue.size());
+#if PUBLISH_QUEUE_PERSIST
+  g_readingQueue.save(READING_QUEUE_KEY);
+#endif
+  if (mqtt.isConnected() && !g_readingQueueDraining)
+  {
+    g_readingQueueDraining = true;
+    mqtt.executeDelayed(READING_QUEUE_DRAIN_INTERVAL_MS, drainReadingQueue);
+  }
+}
+
 // Function: onUpdateData
 // Description: Fetches data from the water and gas meter and publishes it to MQTT topics.
 //              Retries up to 10 times if data retrieval fails.
@@ -517,17 +1128,46 @@ void onUpdateData()
   TS_PRINTF("[STATUS] Reading schedule: %s\n", readingSchedule);
   TS_PRINTF("[STATUS] Scheduled read time: %02d:%02d UTC (%02d:%02d local-offset)\n", g_readHourUtc, g_readMinuteUtc, g_readHourLocal, g_readMinuteLocal);
 
+  // Every attempt, retries included, is paid for from the read budget
+  if (!g_readBudget.tryConsume(1, g_isScheduledRead ? ReadBudget::Priority::Scheduled : ReadBudget::Priority::Manual,
+                               millis()))
+  {
+    TS_PRINTF("[WARN] Read budget exhausted (%u/%u tokens, next in %lus), %s read not sent\n",
+              (unsigned)g_readBudget.getTokens(millis()), (unsigned)g_readBudget.getBurst(),
+              g_readBudget.getMsUntilNextToken(millis()) / 1000, g_isScheduledRead ? "scheduled" : "manual");
+    const bool midSession = _retry > 0;
+    _retry = 0;
+    g_sessionHourLocal = -1; // An unfinished session says nothing about the slot
+    g_isScheduledRead = false;
+    lastErrorMessage = "Read budget exhausted - protecting meter battery";
+    publishRetained(TOPIC_LAST_ERROR, lastErrorMessage);
+    publishRetained(TOPIC_STATUS_MESSAGE, "Read budget exhausted");
+    if (midSession)
+    {
+      publishRetained(TOPIC_ACTIVE_READING, "false");
+      publishRetained(TOPIC_CC1101_STATE, cc1101RadioConnected ? "Idle" : "unavailable");
+    }
+    return;
+  }
+
   // Increment total attempts counter
   totalReadAttempts++;
 
+  // A fresh session (not a retry or the post-scan re-read) starts a new slot sample
+  if (_retry == 0)
+    beginReadSession();
+
   // Indicate activity with LED
   digitalWrite(LED_BUILTIN, LOW); // Turn on LED to indicate activity
 
   // Notify MQTT that active reading has started
-  mqtt.publish(String(mqttBaseTopic) + "/active_reading", "true", true);
-  mqtt.publish(String(mqttBaseTopic) + "/cc1101_state", "Reading", true);
+  publishRetained(TOPIC_ACTIVE_READING, "true");
+  publishRetained(TOPIC_CC1101_STATE, "Reading");
 
+  g_diagnostics.snapshotBeforeRead();
   struct tmeter_data meter_data = get_meter_data(); // Fetch meter data
+  g_diagnostics.snapshotAfterRead();
+  ReadTimeline &timeline = cc1101_get_read_timeline();
 
   // Get current UTC time
   time_t tnow = time(nullptr);
@@ -535,50 +1175,78 @@ void onUpdateData()
   Serial.println();
   TS_PRINTF("[TIME] Current date (UTC): %04d/%02d/%02d %02d:%02d:%02d - %ld\n", ptm->tm_year + 1900, ptm->tm_mon + 1, ptm->tm_mday, ptm->tm_hour, ptm->tm_min, ptm->tm_sec, (long)tnow);
 
-  char iso8601[128];
-  strftime(iso8601, sizeof iso8601, "%FT%TZ", gmtime(&tnow));
-
   // Handle data retrieval failure (including first-layer protection rejecting
   // corrupted frames and returning zeros).
   if (meter_data.reads_counter == 0 || meter_data.volume == 0)
   {
-    TS_PRINTF("[ERROR] Unable to retrieve data from meter (attempt %d/%d)\n", _retry + 1, max_retries);
-
-    if (_retry < max_retries - 1)
+    timeline.commit(false);
+    publishReadTimeline();
+    publishSpiStats();
+    publishRuntimeDiagnostics();
+    const int attemptBudget = g_retryPolicy.getAttemptBudget();
+    TS_PRINTF("[ERROR] Unable to retrieve data from meter (attempt %d/%d)\n", _retry + 1, attemptBudget);
+
+    // Skip attempts that cannot succeed: the meter is asleep, or has missed
+    // several sessions in a row and is only probed until it answers again
+    const bool windowClosed = g_meterWindowStart >= 0 && tnow >= 1609459200 &&
+                              g_meterClock.isWindowClosed(tnow, g_meterWindowStart, g_meterWindowEnd);
+    const unsigned long retryDelay = g_retryPolicy.onAttemptFailed(_retry + 1, windowClosed, millis());
+
+    if (retryDelay > 0)
     {
       // Schedule retry using callback instead of recursion to prevent stack overflow
       _retry++;
       static char errorMsg[64];
-      snprintf(errorMsg, sizeof(errorMsg), "Retry %d/%d - No data received", _retry, max_retries);
+      snprintf(errorMsg, sizeof(errorMsg), "Retry %d/%d - No data received", _retry, attemptBudget);
       lastErrorMessage = errorMsg;
-      TS_PRINTF("[STATUS] Scheduling retry in 5 seconds... (next attempt %d/%d)\n", _retry + 1, max_retries);
+      TS_PRINTF("[STATUS] Scheduling retry in %lu ms... (next attempt %d/%d)\n", retryDelay, _retry + 1, attemptBudget);
       // Keep the "Active Reading" sensor true and the radio state as "Reading"
       // for the whole retry sequence so they don't flip to "Not running"/Idle
       // between attempts. They are cleared only on final success or after max
       // retries (see the else branch below).
-      mqtt.publish(String(mqttBaseTopic) + "/last_error", lastErrorMessage, true);
+      publishRetained(TOPIC_LAST_ERROR, lastErrorMessage);
       digitalWrite(LED_BUILTIN, HIGH); // Turn off LED
       // Use non-blocking callback instead of recursive call
-      mqtt.executeDelayed(5000, onUpdateData);
+      mqtt.executeDelayed(retryDelay, onUpdateData);
     }
     else
     {
-      // Max retries reached, enter cooldown period
-      lastFailedAttempt = millis();
+      // Max retries reached (or skipped), enter cooldown period
+      if (windowClosed && _retry + 1 < attemptBudget)
+      {
+        TS_PRINTF("[WARN] Meter wake window (%02d-%02d meter time) is closed, skipping remaining retries\n",
+                  g_meterWindowStart, g_meterWindowEnd);
+      }
+      else if (g_retryPolicy.isMeterUnresponsive())
+      {
+        TS_PRINTF("[WARN] Meter unresponsive for %u sessions, probing with %d attempt(s) per session\n",
+                  (unsigned)g_retryPolicy.getFailedStreak(), (int)RetryPolicy::UNRESPONSIVE_ATTEMPTS);
+      }
+      recordReadSession(_retry + 1, false);
+#if AUTO_ALIGN_READING_TIME
+      // A failed slot counts against its hour too; move on from it
+      if (g_isScheduledRead && g_meterWindowStart >= 0)
+        alignReadTimeToMeterWindow(time(nullptr));
+#endif
+      g_isScheduledRead = false; // Later triggers are manual until the scheduler fires again
       failedReads++;
       lastErrorMessage = "Max retries reached - cooling down";
-      TS_PRINTF("[ERROR] Max retries (%d) reached. Entering 1-hour cooldown period.\n", max_retries);
-      mqtt.publish(String(mqttBaseTopic) + "/active_reading", "false", true);
-      mqtt.publish(String(mqttBaseTopic) + "/cc1101_state", cc1101RadioConnected ? "Idle" : "unavailable", true);
-      mqtt.publish(String(mqttBaseTopic) + "/status_message", "Failed after max retries, cooling down for 1 hour", true);
-      mqtt.publish(String(mqttBaseTopic) + "/last_error", lastErrorMessage, true);
+      const unsigned long cooldownMin = g_retryPolicy.getCooldownMs() / 60000UL;
+      TS_PRINTF("[ERROR] Read session failed (%u in a row). Entering %lu-minute cooldown period.\n",
+                (unsigned)g_retryPolicy.getFailedStreak(), cooldownMin);
+      publishRetained(TOPIC_ACTIVE_READING, "false");
+      publishRetained(TOPIC_CC1101_STATE, cc1101RadioConnected ? "Idle" : "unavailable");
+      char statusMsg[64];
+      snprintf(statusMsg, sizeof(statusMsg), "Failed after max retries, cooling down for %lu min", cooldownMin);
+      publishRetained(TOPIC_STATUS_MESSAGE, statusMsg);
+      publishRetained(TOPIC_LAST_ERROR, lastErrorMessage);
 
       char buffer[16];
       snprintf(buffer, sizeof(buffer), "%lu", failedReads);
-      mqtt.publish(String(mqttBaseTopic) + "/failed_reads", buffer, true);
+      publishRetained(TOPIC_FAILED_READS, buffer);
 
       snprintf(buffer, sizeof(buffer), "%lu", totalReadAttempts);
-      mqtt.publish(String(mqttBaseTopic) + "/total_attempts", buffer, true);
+      publishRetained(TOPIC_TOTAL_ATTEMPTS, buffer);
       digitalWrite(LED_BUILTIN, HIGH); // Turn off LED
       _retry = 0;                      // Reset retry counter for next scheduled attempt
 
@@ -588,7 +1256,12 @@ void onUpdateData()
       // manual scan still get recalibrated. The guard is reset on the next
       // successful read so we don't burn power scanning on every cooldown when
       // the meter is genuinely unreachable (e.g. dead battery).
-      if (autoScanOnFailureEnabled && !g_autoScanAfterFailureDone)
+      const bool autoScanDue = autoScanOnFailureEnabled && !g_autoScanAfterFailureDone;
+      if (autoScanDue && !g_readBudget.tryConsume(ReadBudget::SCAN_COST, ReadBudget::Priority::Manual, millis()))
+      {
+        TS_PRINTLN("[FREQ] [WARN] Read budget too low for the automatic frequency scan, skipping it");
+      }
+      else if (autoScanDue)
       {
         g_autoScanAfterFailureDone = true;
         TS_PRINTLN("[FREQ] Max retries reached - running narrow frequency scan (±20 kHz) to re-tune after drift... (disable: AUTO_SCAN_ON_FAILURE_ENABLED 0 in private.h)");
@@ -599,15 +1272,15 @@ void onUpdateData()
         // Only re-read if the scan actually found and stored a *new* offset: the
         // carrier had drifted and the radio is now tuned to a frequency we have
         // not yet tried this streak, so an immediate read is worthwhile instead
-        // of waiting out the 1-hour cooldown. Attempt exactly ONE more read.
+        // of waiting out the cooldown. Attempt exactly ONE more read.
         // This cannot loop: g_autoScanAfterFailureDone (already set) blocks a
         // second scan and g_postScanReadAttempted (set here) blocks a second
         // re-read, so a still-failing re-read falls straight through to cooldown.
         if (offsetAfterScan != offsetBeforeScan && !g_postScanReadAttempted)
         {
           g_postScanReadAttempted = true;
-          lastFailedAttempt = 0;    // lift the cooldown for this single retry
-          _retry = max_retries - 1; // enter as the final attempt: one shot only
+          g_retryPolicy.clearCooldown(); // lift the cooldown for this single retry
+          _retry = max_retries - 1;      // enter as the final attempt: one shot only
           TS_PRINTF("[FREQ] New frequency offset found (%.3f -> %.3f kHz) - attempting one more read...\n",
                     offsetBeforeScan * 1000.0, offsetAfterScan * 1000.0);
           mqtt.executeDelayed(2000, onUpdateData);
@@ -621,60 +1294,33 @@ void onUpdateData()
     return;
   }
 
-  // Format int time_start and time_end as "HH:MM"
-  char timeStartFormatted[6];
-  char timeEndFormatted[6];
-  int timeStart = constrain(meter_data.time_start, 0, 23); // Ensure valid hour range
-  int timeEnd = constrain(meter_data.time_end, 0, 23);     // Ensure valid hour range
-  snprintf(timeStartFormatted, sizeof(timeStartFormatted), "%02d:00", timeStart);
-  snprintf(timeEndFormatted, sizeof(timeEndFormatted), "%02d:00", timeEnd);
-
   // Use shared utility function to print meter data
   printMeterDataSummary(&meter_data, meterIsGas, GAS_VOLUME_DIVISOR);
-
-  // Publish meter data to MQTT (using char buffers instead of String)
-  // NOTE: meter_data.volume is the raw counter value from the meter (liters for water;
-  // for gas, this raw counter is converted to cubic meters using GAS_VOLUME_DIVISOR).
-  char valueBuffer[32];
-
-  if (meterIsGas)
-  {
-    // Gas meters: publish value in m³ (volume / GAS_VOLUME_DIVISOR)
-    // Default divisor 100 = 0.01 m³ per unit (typical EverBlu Cyble gas module)
-    float cubicMeters = meter_data.volume / (float)GAS_VOLUME_DIVISOR;
-    snprintf(valueBuffer, sizeof(valueBuffer), "%.3f", cubicMeters);
-  }
-  else
-  {
-    // Water meters: publish value in liters
-    snprintf(valueBuffer, sizeof(valueBuffer), "%d", meter_data.volume);
-  }
-  mqtt.publish(String(mqttBaseTopic) + "/liters", valueBuffer, true);
-  delay(5);
+  timeline.skip(micros()); // The console summary is not part of the read
 
   // Publish historical data as JSON attributes for Home Assistant.
   // The 13-month history table, monthly-usage math and JSON formatting all live
   // in the shared MeterHistory service (src/services/meter_history.cpp) - the
   // SAME code the ESPHome build uses - so the published format stays
-  // single-sourced across both targets.
-  if (meter_data.history_available && MeterHistory::isHistoryValid(meter_data.history))
+  // single-sourced across both targets. The model takes one pass over the
+  // frame's history and only renders the JSON again when the history or the
+  // current volume changed since the last read.
+  g_historyModel.build(meter_data.history_available ? meter_data.history : nullptr,
+                       static_cast<uint32_t>(meter_data.volume));
+  if (g_historyModel.isValid())
   {
-    const uint32_t currentVolume = static_cast<uint32_t>(meter_data.volume);
-
     // Human-readable table to the serial console
-    MeterHistory::printToSerial(meter_data.history, currentVolume, "[HISTORY]");
+    g_historyModel.printToSerial("[HISTORY]");
 
-    // Build and publish the JSON attributes payload
-    char historyJson[1024];
-    int written = MeterHistory::generateHistoryJson(meter_data.history, currentVolume,
-                                                    historyJson, sizeof(historyJson));
+#if MQTT_BINARY_PAYLOAD != 2
+    // Publish the JSON attributes payload
+    const int written = g_historyModel.jsonLength();
     if (written > 0)
     {
-      TS_PRINTF("[MQTT] Publishing JSON attributes (%d bytes): %s\n\n", written, historyJson);
-      mqtt.publish(String(mqttBaseTopic) + "/liters_attributes", historyJson, true);
-      delay(5);
+      TS_PRINTF("[MQTT] Publishing JSON attributes (%d bytes): %s\n\n", written, g_historyModel.json());
+      publishRetained(TOPIC_LITERS_ATTRIBUTES, g_historyModel.json());
 
-      HistoryStats stats = MeterHistory::calculateStats(meter_data.history, currentVolume);
+      const HistoryStats &stats = g_historyModel.getStats();
       TS_PRINTF("[MQTT] Published %d months historical data (current month usage: %u L)\n",
                 stats.monthCount, stats.currentMonthUsage);
     }
@@ -682,87 +1328,69 @@ void onUpdateData()
     {
       TS_PRINTLN("[WARN] No historical data JSON generated - skipping history publish for this frame");
     }
+#endif
   }
 
-  snprintf(valueBuffer, sizeof(valueBuffer), "%d", meter_data.reads_counter);
-  mqtt.publish(String(mqttBaseTopic) + "/counter", valueBuffer, true);
-  delay(5);
-
-  snprintf(valueBuffer, sizeof(valueBuffer), "%d", meter_data.battery_left);
-  mqtt.publish(String(mqttBaseTopic) + "/battery", valueBuffer, true);
-  delay(5);
-
-  snprintf(valueBuffer, sizeof(valueBuffer), "%d", meter_data.rssi_dbm);
-  mqtt.publish(String(mqttBaseTopic) + "/rssi_dbm", valueBuffer, true);
-  delay(5);
-
-  snprintf(valueBuffer, sizeof(valueBuffer), "%d", calculateMeterdBmToPercentage(meter_data.rssi_dbm));
-  mqtt.publish(String(mqttBaseTopic) + "/rssi_percentage", valueBuffer, true);
-  delay(5);
-
-  snprintf(valueBuffer, sizeof(valueBuffer), "%d", meter_data.lqi);
-  mqtt.publish(String(mqttBaseTopic) + "/lqi", valueBuffer, true);
-  delay(5);
-  mqtt.publish(String(mqttBaseTopic) + "/time_start", timeStartFormatted, true);
-  delay(5);
-  mqtt.publish(String(mqttBaseTopic) + "/time_end", timeEndFormatted, true);
-  delay(5);
-  mqtt.publish(String(mqttBaseTopic) + "/timestamp", iso8601, true); // timestamp since epoch in UTC
-  delay(5);
-  mqtt.publish(String(mqttBaseTopic) + "/meter_time", meter_data.meter_time, true); // meter's own real-time clock
-  delay(5);
-  mqtt.publish(String(mqttBaseTopic) + "/meter_type", meter_data.meter_type, true); // meter type/identifier string
-  delay(5);
-
-  snprintf(valueBuffer, sizeof(valueBuffer), "%d", calculateLQIToPercentage(meter_data.lqi));
-  mqtt.publish(String(mqttBaseTopic) + "/lqi_percentage", valueBuffer, true);
-  delay(5);
+  // Publish the reading now, or keep it until the broker is back
+  QueuedReading reading = {};
+  reading.timestamp = (uint32_t)tnow;
+  reading.volume = meter_data.volume;
+  reading.rssi = (uint8_t)meter_data.rssi;
+  reading.rssiDbm = (int16_t)meter_data.rssi_dbm;
+  reading.readsCounter = (uint8_t)meter_data.reads_counter;
+  reading.batteryMonths = (uint8_t)meter_data.battery_left;
+  reading.lqi = (uint8_t)meter_data.lqi;
+  reading.timeStart = (uint8_t)constrain(meter_data.time_start, 0, 23);
+  reading.timeEnd = (uint8_t)constrain(meter_data.time_end, 0, 23);
+  reading.frequencyOffsetHz = (int32_t)lroundf(FrequencyManager::getOffset() * 1000000.0f);
+  if (!mqtt.isConnected() || !g_readingQueue.isEmpty() ||
+      !publishReading(reading, meter_data.meter_time, meter_data.meter_type,
+                      g_historyModel.isValid() ? &g_historyModel : nullptr, false))
+  {
+    queueReading(reading);
+  }
+  timeline.mark(ReadPhase::Publish, micros());
+  timeline.commit(true);
+  publishReadTimeline();
+  publishSpiStats();
+  publishRuntimeDiagnostics();
 
-  // Publish all data as a JSON message as well this is redundant but may be useful for some
-  char json[512];
-  sprintf(json, jsonTemplate, meter_data.volume, meter_data.reads_counter, meter_data.battery_left, meter_data.rssi, iso8601);
-  mqtt.publish(String(mqttBaseTopic) + "/json", json, true);
-  delay(5);
+  recordReadSession(_retry + 1, true);
+
+  // Track the meter clock against NTP (offset from UTC plus drift in ppm)
+  if (meter_data.meter_clock_epoch != 0 && tnow >= 1609459200)
+  {
+    if (!g_meterClock.addSample((time_t)meter_data.meter_clock_epoch, tnow))
+    {
+      TS_PRINTLN("[SCHEDULE] [WARN] Meter clock stepped, drift estimate restarted");
+    }
+    TS_PRINTF("[SCHEDULE] Meter clock offset %+ld s from UTC, drift %+.1f ppm\n",
+              (long)g_meterClock.getOffsetSeconds(tnow), g_meterClock.getDriftPpm());
+  }
+
+  // Wake window, also used to skip retries while the meter is asleep
+  g_meterWindowStart = constrain(meter_data.time_start, 0, 23);
+  g_meterWindowEnd = constrain(meter_data.time_end, 0, 23);
 
 #if AUTO_ALIGN_READING_TIME
   // Optionally auto-align the daily scheduled reading time to the meter's wake window
   // Only apply when this read was triggered by the scheduler, not by manual MQTT command
   if (g_isScheduledRead)
   {
-    int timeStart = constrain(meter_data.time_start, 0, 23);
-    int timeEnd = constrain(meter_data.time_end, 0, 23);
-    int window = (timeEnd - timeStart + 24) % 24; // hours in window (0 means unknown/all-day)
-
-    if (window > 0)
-    {
-#if AUTO_ALIGN_USE_MIDPOINT
-      int alignedHourLocal = (timeStart + (window / 2)) % 24; // midpoint (interpreted as local-offset time)
-#else
-      int alignedHourLocal = timeStart; // start of window (local-offset time)
-#endif
-      int alignedMinuteLocal = g_readMinuteLocal;
-      updateResolvedScheduleFromLocal(alignedHourLocal, alignedMinuteLocal);
-
-      // Publish updated reading_time HH:MM
-      char readingTimeFormatted2[6];
-      snprintf(readingTimeFormatted2, sizeof(readingTimeFormatted2), "%02d:%02d", g_readHourUtc, g_readMinuteUtc);
-      mqtt.publish(String(mqttBaseTopic) + "/reading_time", readingTimeFormatted2, true);
-      delay(5);
-
-      TS_PRINTF("[SCHEDULE] Auto-aligned reading time to %02d:%02d local-offset (%02d:%02d UTC) (window %02d-%02d local)\n",
-                    g_readHourLocal, g_readMinuteLocal, g_readHourUtc, g_readMinuteUtc, timeStart, timeEnd);
-    }
+    alignReadTimeToMeterWindow(tnow);
   }
 #endif
 
   // Notify MQTT that active reading has ended
-  mqtt.publish(String(mqttBaseTopic) + "/active_reading", "false", true);
-  mqtt.publish(String(mqttBaseTopic) + "/cc1101_state", cc1101RadioConnected ? "Idle" : "unavailable", true);
+  publishRetained(TOPIC_ACTIVE_READING, "false");
+  publishRetained(TOPIC_CC1101_STATE, cc1101RadioConnected ? "Idle" : "unavailable");
   digitalWrite(LED_BUILTIN, HIGH); // Turn off LED to indicate completion
 
-  // Reset retry counter and cooldown on successful read
+  // Reset retry counter, cooldown and failure streak on successful read
   _retry = 0;
-  lastFailedAttempt = 0;
+  g_retryPolicy.onSuccess();
+  g_haveReading = true;
+  g_lastReadingMs = millis();
   g_autoScanAfterFailureDone = false; // Allow a fresh auto-scan on the next failure streak
   g_postScanReadAttempted = false;    // Allow a fresh post-scan re-read on the next failure streak
   successfulReads++;
@@ -772,12 +1400,12 @@ void onUpdateData()
   char metricBuffer[16];
 
   snprintf(metricBuffer, sizeof(metricBuffer), "%lu", successfulReads);
-  mqtt.publish(String(mqttBaseTopic) + "/successful_reads", metricBuffer, true);
+  publishRetained(TOPIC_SUCCESSFUL_READS, metricBuffer);
 
   snprintf(metricBuffer, sizeof(metricBuffer), "%lu", totalReadAttempts);
-  mqtt.publish(String(mqttBaseTopic) + "/total_attempts", metricBuffer, true);
+  publishRetained(TOPIC_TOTAL_ATTEMPTS, metricBuffer);
 
-  mqtt.publish(String(mqttBaseTopic) + "/last_error", "None", true);
+  publishRetained(TOPIC_LAST_ERROR, "None");
 
   // Perform adaptive frequency tracking based on FREQEST register
   adaptiveFrequencyTracking(meter_data.freqest);
@@ -792,52 +1420,81 @@ void onUpdateData()
 }
 
 // Function: onScheduled
-// Function: onScheduled
-// Description: Schedules daily meter readings at the configured local-offset time.
+// Description: Fires the daily meter reading at the configured local-offset time.
+// The next deadline is precomputed as a UTC epoch, so each check is a single
+// compare and a late check (blocked loop) still catches up on the missed read.
 void onScheduled()
 {
   time_t tnow = time(nullptr);
-  // Compute local-offset time by adding offset minutes to UTC epoch
-  time_t tlocal = tnow + (time_t)TIMEZONE_OFFSET_MINUTES * 60;
-  struct tm *ptm = gmtime(&tlocal);
 
-  // Check if today is a valid reading day
-  const bool timeMatch = (ptm->tm_hour == g_readHourLocal && ptm->tm_min == g_readMinuteLocal);
+  // No valid wall clock yet (NTP pending): reschedule once it arrives
+  if (!g_timeProvider.isTimeSynced())
+  {
+    g_scheduleDirty = true;
+    mqtt.executeDelayed(500, onScheduled);
+    return;
+  }
 
-  if (ScheduleManager::isReadingDay(ptm) && timeMatch && ptm->tm_sec == 0)
+  if (g_scheduleDirty || tnow < g_lastScheduleCheckUtc)
   {
-    // Check if we're still in cooldown period after failed attempts
-    if (lastFailedAttempt > 0 && (millis() - lastFailedAttempt) < RETRY_COOLDOWN)
+    time_t fromUtc = tnow;
+    // After a small backwards clock correction don't fire the same deadline twice
+    if (g_lastScheduledFireUtc > tnow && g_lastScheduledFireUtc - tnow < 24 * 60 * 60)
     {
-      unsigned long remainingCooldown = (RETRY_COOLDOWN - (millis() - lastFailedAttempt)) / 1000;
+      fromUtc = g_lastScheduledFireUtc + 1;
+    }
+    g_nextScheduledReadUtc = ScheduleManager::computeNextFireUtc(fromUtc, g_scheduleMask, g_readHourUtc,
+                                                                 g_readMinuteUtc, TIMEZONE_OFFSET_MINUTES);
+    g_scheduleDirty = false;
+  }
+  g_lastScheduleCheckUtc = tnow;
+
+  if (g_nextScheduledReadUtc > 0 && tnow >= g_nextScheduledReadUtc)
+  {
+    // Check if we're still in cooldown period after failed attempts. The
+    // deadline is kept so the read catches up once the cooldown ends.
+    if (g_retryPolicy.isCoolingDown(millis()))
+    {
+      unsigned long remainingCooldown = g_retryPolicy.getCooldownRemainingMs(millis()) / 1000;
       TS_PRINTF("[WARN] Still in cooldown period. %lu seconds remaining.\n", remainingCooldown);
 
       char cooldownMsg[64];
       snprintf(cooldownMsg, sizeof(cooldownMsg), "Cooldown active, %lus remaining", remainingCooldown);
-      char topicBuffer[MQTT_TOPIC_BUFFER_SIZE];
-      snprintf(topicBuffer, sizeof(topicBuffer), "%s/status_message", mqttBaseTopic);
-      mqtt.publish(topicBuffer, cooldownMsg, true);
-      mqtt.executeDelayed(500, onScheduled);
+      publishRetained(TOPIC_STATUS_MESSAGE, cooldownMsg);
+      mqtt.executeDelayed(1000 * 60, onScheduled);
       return;
     }
 
-    // Cooldown period is over, reset and proceed
-    lastFailedAttempt = 0;
+    // Arm the following occurrence before deciding on this one
+    const time_t dueUtc = g_nextScheduledReadUtc;
+    g_lastScheduledFireUtc = dueUtc;
+    g_nextScheduledReadUtc = ScheduleManager::computeNextFireUtc(tnow + 1, g_scheduleMask, g_readHourUtc,
+                                                                 g_readMinuteUtc, TIMEZONE_OFFSET_MINUTES);
 
-    // Call back in 23 hours
-    mqtt.executeDelayed(1000 * 60 * 60 * 23, onScheduled);
-
-    Serial.println("It is time to update data from meter :)");
+    if (tnow - dueUtc > SCHEDULE_CATCH_UP_WINDOW_S)
+    {
+      TS_PRINTF("[SCHEDULE] [WARN] Scheduled read missed by %ld s (outside catch-up window), skipping\n",
+                (long)(tnow - dueUtc));
+    }
+    else
+    {
+      Serial.println("It is time to update data from meter :)");
 
-    // Update data
-    _retry = 0;
-    g_isScheduledRead = true; // Mark this read as triggered by scheduler
-    onUpdateData();
-    return;
+      // Update data
+      _retry = 0;
+      g_isScheduledRead = true; // Mark this read as triggered by scheduler
+      onUpdateData();
+    }
   }
 
-  // Check every 500 ms
-  mqtt.executeDelayed(500, onScheduled);
+  // Sleep until the deadline, but wake at least once a minute so clock
+  // corrections and reading-time changes are picked up promptly
+  unsigned long delayMs = 1000UL * 60;
+  if (g_nextScheduledReadUtc > tnow && g_nextScheduledReadUtc - tnow < 60)
+  {
+    delayMs = (unsigned long)(g_nextScheduledReadUtc - tnow) * 1000UL;
+  }
+  mqtt.executeDelayed(delayMs, onScheduled);
 }
 
 // ============================================================================
@@ -847,70 +1504,126 @@ void onScheduled()
 // Used to reduce the size of the JSON payload
 // https://www.home-assistant.io/integrations/mqtt/#supported-abbreviations-in-mqtt-discovery-messages
 
-// Helper function to conditionally build meter prefix for entity IDs
-// Returns meter serial with underscore suffix if ENABLE_METER_PREFIX_IN_ENTITY_IDS is 1, empty otherwise
-String getMeterPrefix()
+// Discovery payloads are written one entity at a time into this buffer, so
+// publishing discovery does not touch the heap
+static char g_discoveryJson[1024];
+
+// Helper function to start a discovery payload with the fields every entity shares:
+// name, unique/object ID (prefixed with the meter serial if ENABLE_METER_PREFIX_IN_ENTITY_IDS
+// is 1), the base topic and availability topic. Topics are written as "~/suffix"
+// and Home Assistant expands "~" to the base topic.
+static JsonWriter beginDiscoveryJson(const char *name, const char *entity_id)
 {
+  char id[64];
 #if ENABLE_METER_PREFIX_IN_ENTITY_IDS
-  return String(g_meterSerial) + "_";
+  snprintf(id, sizeof(id), "%lu_%s", (unsigned long)g_meterSerial, entity_id);
 #else
-  return "";
+  snprintf(id, sizeof(id), "%s", entity_id);
 #endif
+
+  JsonWriter json(g_discoveryJson, sizeof(g_discoveryJson));
+  json.beginObject();
+  json.field("name", name);
+  json.field("uniq_id", id);
+  json.field("obj_id", id);
+  json.field("qos", 0);
+  json.field("~", mqttBaseTopic);
+  json.field("avty_t", "~/status");
+  return json;
 }
 
-// Helper function to build JSON device block with METER_SERIAL
-String buildDeviceJson()
+// Helper function to finish a discovery payload with the device block. Home
+// Assistant merges device blocks by identifier, so only one entity needs to
+// carry the full description; the others reference the device by its ids.
+static void endDiscoveryJson(JsonWriter &json, bool fullDevice = false)
 {
-  // Pre-allocate memory to prevent heap fragmentation
-  // Estimated size: ~250 bytes for device JSON
-  String json;
-  json.reserve(300);
-
+  json.key("dev");
+  json.beginObject();
+  json.key("ids");
+  json.beginArray();
 #if ENABLE_METER_PREFIX_IN_ENTITY_IDS
-  json = "\"ids\": [\"" + String(g_meterSerial) + "\"],\n";
-  json += "    \"name\": \"EverBlu Meter " + String(g_meterSerial) + "\",\n";
+  json.value(meterSerialStr);
+  json.endArray();
+  if (!fullDevice)
+  {
+    json.endObject();
+    json.endObject();
+    return;
+  }
+  char deviceName[40];
+  snprintf(deviceName, sizeof(deviceName), "EverBlu Meter %s", meterSerialStr);
+  json.field("name", deviceName);
 #else
   // When meter prefix is disabled, use a fixed device ID for single-meter setup
-  json = "\"ids\": [\"everblu_meter_device\"],\n";
-  json += "    \"name\": \"EverBlu Meter\",\n";
+  json.value("everblu_meter_device");
+  json.endArray();
+  if (!fullDevice)
+  {
+    json.endObject();
+    json.endObject();
+    return;
+  }
+  json.field("name", "EverBlu Meter");
 #endif
-  json += "    \"mdl\": \"Itron EverBlu Cyble Enhanced Water and Gas Meter ESP8266/ESP32\",\n";
-  json += "    \"mf\": \"Genestealer\",\n";
-  json += "    \"sw\": \"" EVERBLU_FW_VERSION "\",\n";
-  json += "    \"cu\": \"https://github.com/genestealer/everblu-meters-esp8266-improved\"";
-  return json;
+  json.field("mdl", "Itron EverBlu Cyble Enhanced Water and Gas Meter ESP8266/ESP32");
+  json.field("mf", "Genestealer");
+  json.field("sw", EVERBLU_FW_VERSION);
+  json.field("cu", "https://github.com/genestealer/everblu-meters-esp8266-improved");
+  json.endObject();
+  json.endObject();
+}
+
+// Helper function to write a topic under the base topic ("~")
+static void writeTopicField(JsonWriter &json, const char *key, const char *suffix)
+{
+  char topic[MQTT_TOPIC_BUFFER_SIZE];
+  snprintf(topic, sizeof(topic), "~/%s", suffix);
+  json.field(key, topic);
+}
+
+// Helper function to write the state topic of a discovery payload.
+// With MQTT_CONSOLIDATED_STATE, readings live in {base}/state and each entity
+// picks its key out with a value template.
+static void writeStateTopic(JsonWriter &json, const char *entity_id)
+{
+#if MQTT_CONSOLIDATED_STATE
+  static const char *const stateKeys[] = {"liters", "counter", "battery", "rssi", "rssi_dbm",
+                                          "rssi_percentage", "lqi", "lqi_percentage", "time_start",
+                                          "time_end", "timestamp", "meter_time", "meter_type"};
+  for (const char *key : stateKeys)
+  {
+    if (strcmp(entity_id, key) == 0)
+    {
+      char valueTemplate[48];
+      snprintf(valueTemplate, sizeof(valueTemplate), "{{ value_json.%s }}", key);
+      json.field("stat_t", "~/state");
+      json.field("val_tpl", valueTemplate);
+      return;
+    }
+  }
+#endif
+  writeTopicField(json, "stat_t", entity_id);
 }
 
 // Helper function to build discovery JSON for a sensor
-String buildDiscoveryJson(const char *name, const char *entity_id, const char *icon,
-                          const char *unit = nullptr, const char *dev_class = nullptr,
-                          const char *state_class = nullptr, const char *ent_category = nullptr)
+static JsonWriter buildDiscoveryJson(const char *name, const char *entity_id, const char *icon,
+                                     const char *unit = nullptr, const char *dev_class = nullptr,
+                                     const char *state_class = nullptr, const char *ent_category = nullptr)
 {
-  // Pre-allocate memory to prevent heap fragmentation from multiple reallocations
-  // Estimated size: base structure (~350 bytes) + optional fields (~100 bytes)
-  String json;
-  json.reserve(512);
-
-  json = "{\n";
-  json += "  \"name\": \"" + String(name) + "\",\n";
-  json += "  \"uniq_id\": \"" + getMeterPrefix() + String(entity_id) + "\",\n";
-  json += "  \"obj_id\": \"" + getMeterPrefix() + String(entity_id) + "\",\n";
+  JsonWriter json = beginDiscoveryJson(name, entity_id);
   if (icon)
-    json += "  \"ic\": \"" + String(icon) + "\",\n";
+    json.field("ic", icon);
   if (unit)
-    json += "  \"unit_of_meas\": \"" + String(unit) + "\",\n";
+    json.field("unit_of_meas", unit);
   if (dev_class)
-    json += "  \"dev_cla\": \"" + String(dev_class) + "\",\n";
+    json.field("dev_cla", dev_class);
   if (state_class)
-    json += "  \"stat_cla\": \"" + String(state_class) + "\",\n";
-  json += "  \"qos\": 0,\n";
-  json += "  \"avty_t\": \"" + String(mqttBaseTopic) + "/status\",\n";
-  json += "  \"stat_t\": \"" + String(mqttBaseTopic) + "/" + String(entity_id) + "\",\n";
-  json += "  \"frc_upd\": true,\n";
+    json.field("stat_cla", state_class);
+  writeStateTopic(json, entity_id);
+  json.field("frc_upd", true);
   if (ent_category)
-    json += "  \"ent_cat\": \"" + String(ent_category) + "\",\n";
-  json += "  \"dev\": {\n    " + buildDeviceJson() + "\n  }\n";
-  json += "}";
+    json.field("ent_cat", ent_category);
+  endDiscoveryJson(json);
   return json;
 }
 
@@ -949,41 +1662,44 @@ void publishWifiDetails()
   char uptimeISO[32];
   strftime(uptimeISO, sizeof(uptimeISO), "%FT%TZ", gmtime(&uptimeTimestamp));
 
-  // Publish diagnostic sensors (using char buffers instead of String)
+  // Publish diagnostic sensors (only the values that changed, unless a full refresh is due)
   char valueBuffer[16];
-  char topicBuffer[MQTT_TOPIC_BUFFER_SIZE];
 
-  snprintf(topicBuffer, sizeof(topicBuffer), "%s/wifi_ip", mqttBaseTopic);
-  mqtt.publish(topicBuffer, wifiIP, true);
-  delay(5);
+  publishRetained(TOPIC_WIFI_IP, wifiIP);
 
   snprintf(valueBuffer, sizeof(valueBuffer), "%d", wifiRSSI);
-  snprintf(topicBuffer, sizeof(topicBuffer), "%s/wifi_rssi", mqttBaseTopic);
-  mqtt.publish(topicBuffer, valueBuffer, true);
-  delay(5);
+  publishRetained(TOPIC_WIFI_RSSI, valueBuffer);
 
   snprintf(valueBuffer, sizeof(valueBuffer), "%d", wifiSignalPercentage);
-  snprintf(topicBuffer, sizeof(topicBuffer), "%s/wifi_signal_percentage", mqttBaseTopic);
-  mqtt.publish(topicBuffer, valueBuffer, true);
-  delay(5);
-
-  snprintf(topicBuffer, sizeof(topicBuffer), "%s/mac_address", mqttBaseTopic);
-  mqtt.publish(topicBuffer, macAddress, true);
-  delay(5);
-  snprintf(topicBuffer, sizeof(topicBuffer), "%s/wifi_ssid", mqttBaseTopic);
-  mqtt.publish(topicBuffer, wifiSSID, true);
-  delay(5);
-  snprintf(topicBuffer, sizeof(topicBuffer), "%s/wifi_bssid", mqttBaseTopic);
-  mqtt.publish(topicBuffer, wifiBSSID, true);
-  delay(5);
-  snprintf(topicBuffer, sizeof(topicBuffer), "%s/status", mqttBaseTopic);
-  mqtt.publish(topicBuffer, status, true);
-  delay(5);
-  snprintf(topicBuffer, sizeof(topicBuffer), "%s/uptime", mqttBaseTopic);
-  mqtt.publish(topicBuffer, uptimeISO, true);
-  delay(5);
-
-  TS_PRINTLN("[MQTT] Wi-Fi details published");
+  publishRetained(TOPIC_WIFI_SIGNAL_PERCENTAGE, valueBuffer);
+
+  publishRetained(TOPIC_MAC_ADDRESS, macAddress);
+  publishRetained(TOPIC_WIFI_SSID, wifiSSID);
+  publishRetained(TOPIC_WIFI_BSSID, wifiBSSID);
+  publishRetained(TOPIC_STATUS, status);
+  publishRetained(TOPIC_UPTIME, uptimeISO);
+
+  TS_PRINTF("[MQTT] Wi-Fi details published (%lu unchanged values skipped so far)\n", g_publishFilter.getSuppressed());
+
+  g_diagnostics.sample();
+  publishRuntimeDiagnostics();
+
+  const WifiSerialStats logStats = WiFiSerial.stats();
+  TS_PRINTF("[LOG] Serial output: %lu UART / %lu TCP bytes dropped, longest stall %lu us, UART buffer peak %u/%u bytes\n",
+            (unsigned long)logStats.uartDropped, (unsigned long)logStats.tcpDropped,
+            (unsigned long)logStats.maxStallUs, (unsigned)logStats.uartHighWater, (unsigned)WIFI_SERIAL_UART_BUF_SIZE);
+#if WIFI_SERIAL_MONITOR_ENABLED
+  // Telnet throughput since the previous report
+  static uint32_t lastTcpBytesSent = 0;
+  static unsigned long lastTcpReportMs = 0;
+  const unsigned long tcpElapsedMs = millis() - lastTcpReportMs;
+  const unsigned long tcpRate = tcpElapsedMs > 0 ? (unsigned long)((uint64_t)(logStats.tcpBytesSent - lastTcpBytesSent) * 1000ULL / tcpElapsedMs) : 0;
+  lastTcpBytesSent = logStats.tcpBytesSent;
+  lastTcpReportMs = millis();
+  TS_PRINTF("[LOG] WiFi serial: %u client(s), %lu byte buffer, peak %u bytes, %lu bytes sent (%lu B/s)\n",
+            (unsigned)logStats.tcpClients, (unsigned long)logStats.tcpBufSize, (unsigned)logStats.tcpHighWater,
+            (unsigned long)logStats.tcpBytesSent, tcpRate);
+#endif
 }
 
 // Function: publishMeterSettings
@@ -994,39 +1710,31 @@ void publishMeterSettings()
 
   // Publish Meter Year, Serial (using char buffers instead of String)
   char valueBuffer[16];
-  char topicBuffer[MQTT_TOPIC_BUFFER_SIZE];
 
   snprintf(valueBuffer, sizeof(valueBuffer), "%d", g_meterYear);
-  snprintf(topicBuffer, sizeof(topicBuffer), "%s/everblu_meter_year", mqttBaseTopic);
-  mqtt.publish(topicBuffer, valueBuffer, true);
-  delay(5);
+  publishRetained(TOPIC_METER_YEAR, valueBuffer);
 
   snprintf(valueBuffer, sizeof(valueBuffer), "%lu", (unsigned long)g_meterSerial);
-  snprintf(topicBuffer, sizeof(topicBuffer), "%s/everblu_meter_serial", mqttBaseTopic);
-  mqtt.publish(topicBuffer, valueBuffer, true);
-  delay(5);
+  publishRetained(TOPIC_METER_SERIAL, valueBuffer);
 
   // Publish Reading Schedule
-  snprintf(topicBuffer, sizeof(topicBuffer), "%s/reading_schedule", mqttBaseTopic);
-  mqtt.publish(topicBuffer, readingSchedule, true);
-  delay(5);
+  publishRetained(TOPIC_READING_SCHEDULE, readingSchedule);
 
   // Publish Reading Time (UTC) as HH:MM text (resolved time that may be auto-aligned)
   char readingTimeFormatted[6];
   snprintf(readingTimeFormatted, sizeof(readingTimeFormatted), "%02d:%02d", (int)g_readHourUtc, (int)g_readMinuteUtc);
-  snprintf(topicBuffer, sizeof(topicBuffer), "%s/reading_time", mqttBaseTopic);
-  mqtt.publish(topicBuffer, readingTimeFormatted, true);
-  delay(5);
+  publishRetained(TOPIC_READING_TIME, readingTimeFormatted);
 
   TS_PRINTLN("[MQTT] Meter settings published");
 }
 
 // Function: publishDiscoveryMessage
-// Description: Helper function to publish a single MQTT discovery message for Home Assistant
+// Description: Helper function to publish a single MQTT discovery message for Home Assistant,
+// adding it to the discovery hash (only hashing it when g_discoveryHashOnly is set)
 // @param domain The Home Assistant domain (sensor, button, binary_sensor, etc.)
 // @param entity The entity name suffix (e.g., "everblu_meter_value")
-// @param jsonPayload The complete JSON discovery payload
-static void publishDiscoveryMessage(const char *domain, const char *entity, const String &jsonPayload)
+// @param json The complete JSON discovery payload
+static void publishDiscoveryMessage(const char *domain, const char *entity, const JsonWriter &json)
 {
   // Buffer sizes increased for safety margin to prevent overflow
   // Worst case: "homeassistant/" (14) + "binary_sensor/" (14) +
@@ -1038,83 +1746,74 @@ static void publishDiscoveryMessage(const char *domain, const char *entity, cons
 #else
   snprintf(entityId, sizeof(entityId), "%s", entity);
 #endif
+  if (!json.ok())
+  {
+    TS_PRINTF("[MQTT] [ERROR] Discovery payload for %s does not fit in %u bytes, not published\n", entityId,
+              (unsigned)sizeof(g_discoveryJson));
+    return;
+  }
   snprintf(configTopic, sizeof(configTopic), "homeassistant/%s/%s/config", domain, entityId);
-  mqtt.publish(configTopic, jsonPayload.c_str(), true);
-  delay(5);
+  g_discoveryHash = PublishFilter::hash(configTopic, strlen(configTopic), g_discoveryHash);
+  g_discoveryHash = PublishFilter::hash(json.c_str(), json.length(), g_discoveryHash);
+  if (g_discoveryHashOnly)
+  {
+    return;
+  }
+  if (!mqtt.publish(configTopic, reinterpret_cast<const uint8_t *>(json.c_str()), json.length(), true))
+  {
+    g_discoveryPublishFailed = true;
+  }
 }
 
-// Function: publishHADiscovery
-// Description: Publishes all Home Assistant MQTT discovery messages with serial-specific entity IDs
-void publishHADiscovery()
+// Function: writeHADiscovery
+// Description: Builds every Home Assistant MQTT discovery message with serial-specific
+// entity IDs and passes each to publishDiscoveryMessage()
+static void writeHADiscovery()
 {
-  TS_PRINTLN("[MQTT] Publishing Home Assistant discovery messages...");
-
-  String json;
-
-  // Reading (Total) - Main water/gas sensor
-  TS_PRINTLN("[MQTT] Publishing Reading (Total) sensor discovery...");
-  json = "{\n";
-  json += "  \"name\": \"Reading (Total)\",\n";
-  json += "  \"uniq_id\": \"" + getMeterPrefix() + "everblu_meter_value\",\n";
-  json += "  \"obj_id\": \"" + getMeterPrefix() + "everblu_meter_value\",\n";
-  json += "  \"ic\": \"" + String(meterIcon) + "\",\n";
-  json += "  \"unit_of_meas\": \"" + String(meterUnit) + "\",\n";
-  json += "  \"dev_cla\": \"" + String(meterDeviceClass) + "\",\n";
-  json += "  \"stat_cla\": \"total_increasing\",\n";
-  json += "  \"qos\": 0,\n";
-  json += "  \"avty_t\": \"" + String(mqttBaseTopic) + "/status\",\n";
-  json += "  \"stat_t\": \"" + String(mqttBaseTopic) + "/liters\",\n";
-  TS_PRINTF("[MQTT] Water Usage state topic: %s/liters\n", mqttBaseTopic);
-  json += "  \"json_attr_t\": \"" + String(mqttBaseTopic) + "/liters_attributes\",\n";
-  json += "  \"sug_dsp_prc\": 0,\n";
-  json += "  \"frc_upd\": true,\n";
-  json += "  \"dev\": {\n    " + buildDeviceJson() + "\n  }\n";
-  json += "}";
+#if MQTT_BINARY_PAYLOAD != 2
+  // Reading (Total) - Main water/gas sensor, carries the full device block
+  JsonWriter json = beginDiscoveryJson("Reading (Total)", "everblu_meter_value");
+  json.field("ic", meterIcon);
+  json.field("unit_of_meas", meterUnit);
+  json.field("dev_cla", meterDeviceClass);
+  json.field("stat_cla", "total_increasing");
+  writeStateTopic(json, "liters");
+  writeTopicField(json, "json_attr_t", "liters_attributes");
+  json.field("sug_dsp_prc", 0);
+  json.field("frc_upd", true);
+  endDiscoveryJson(json, true);
   publishDiscoveryMessage("sensor", "everblu_meter_value", json);
 
   // Read Counter
-  json = "{\n";
-  json += "  \"name\": \"Read Counter\",\n";
-  json += "  \"uniq_id\": \"" + getMeterPrefix() + "everblu_meter_counter\",\n";
-  json += "  \"obj_id\": \"" + getMeterPrefix() + "everblu_meter_counter\",\n";
-  json += "  \"ic\": \"mdi:counter\",\n";
-  json += "  \"qos\": 0,\n";
-  json += "  \"avty_t\": \"" + String(mqttBaseTopic) + "/status\",\n";
-  json += "  \"stat_t\": \"" + String(mqttBaseTopic) + "/counter\",\n";
-  json += "  \"frc_upd\": true,\n";
-  json += "  \"dev\": {\n    " + buildDeviceJson() + "\n  }\n";
-  json += "}";
+  json = beginDiscoveryJson("Read Counter", "everblu_meter_counter");
+  json.field("ic", "mdi:counter");
+  writeStateTopic(json, "counter");
+  json.field("frc_upd", true);
+  endDiscoveryJson(json);
   publishDiscoveryMessage("sensor", "everblu_meter_counter", json);
 
   // Last Read (timestamp)
-  json = "{\n";
-  json += "  \"name\": \"Last Read\",\n";
-  json += "  \"uniq_id\": \"" + getMeterPrefix() + "everblu_meter_timestamp\",\n";
-  json += "  \"obj_id\": \"" + getMeterPrefix() + "everblu_meter_timestamp\",\n";
-  json += "  \"ic\": \"mdi:clock\",\n";
-  json += "  \"dev_cla\": \"timestamp\",\n";
-  json += "  \"qos\": 0,\n";
-  json += "  \"avty_t\": \"" + String(mqttBaseTopic) + "/status\",\n";
-  json += "  \"stat_t\": \"" + String(mqttBaseTopic) + "/timestamp\",\n";
-  json += "  \"frc_upd\": true,\n";
-  json += "  \"dev\": {\n    " + buildDeviceJson() + "\n  }\n";
-  json += "}";
+  json = beginDiscoveryJson("Last Read", "everblu_meter_timestamp");
+  json.field("ic", "mdi:clock");
+  json.field("dev_cla", "timestamp");
+  writeStateTopic(json, "timestamp");
+  json.field("frc_upd", true);
+  endDiscoveryJson(json);
   publishDiscoveryMessage("sensor", "everblu_meter_timestamp", json);
 
   // Request Reading Button
-  json = "{\n";
-  json += "  \"name\": \"Request Reading Now\",\n";
-  json += "  \"uniq_id\": \"" + getMeterPrefix() + "everblu_meter_request\",\n";
-  json += "  \"obj_id\": \"" + getMeterPrefix() + "everblu_meter_request\",\n";
-  json += "  \"qos\": 0,\n";
-  json += "  \"avty_t\": \"" + String(mqttBaseTopic) + "/status\",\n";
-  json += "  \"cmd_t\": \"" + String(mqttBaseTopic) + "/trigger_force\",\n";
-  json += "  \"pl_avail\": \"online\",\n";
-  json += "  \"pl_not_avail\": \"offline\",\n";
-  json += "  \"pl_prs\": \"update\",\n";
-  json += "  \"frc_upd\": true,\n";
-  json += "  \"dev\": {\n    " + buildDeviceJson() + "\n  }\n";
-  json += "}";
+  json = beginDiscoveryJson("Request Reading Now", "everblu_meter_request");
+#else
+  // Binary-only mode publishes no reading topics, so there are no reading
+  // entities; the button carries the full device block instead
+  JsonWriter json = beginDiscoveryJson("Request Reading Now", "everblu_meter_request");
+#endif
+  writeTopicField(json, "cmd_t", "trigger_force");
+  json.field("pl_avail", "online");
+  json.field("pl_not_avail", "offline");
+  json.field("pl_prs", "update");
+  json.field("frc_upd", true);
+  endDiscoveryJson(json, MQTT_BINARY_PAYLOAD == 2);
   publishDiscoveryMessage("button", "everblu_meter_request", json);
 
   // Diagnostic sensors
@@ -1129,6 +1828,8 @@ void publishHADiscovery()
   publishDiscoveryMessage("sensor", "everblu_meter_reading_schedule", buildDiscoveryJson("Reading Schedule", "reading_schedule", "mdi:calendar-clock", nullptr, nullptr, nullptr, "diagnostic"));
   publishDiscoveryMessage("sensor", "everblu_meter_year", buildDiscoveryJson("Meter Year", "everblu_meter_year", "mdi:calendar", nullptr, nullptr, nullptr, "diagnostic"));
   publishDiscoveryMessage("sensor", "everblu_meter_serial", buildDiscoveryJson("Meter Serial", "everblu_meter_serial", "mdi:barcode", nullptr, nullptr, nullptr, "diagnostic"));
+  // Reading values, absent in binary-only mode
+#if MQTT_BINARY_PAYLOAD != 2
   publishDiscoveryMessage("sensor", "everblu_meter_battery_months", buildDiscoveryJson("Months Remaining", "battery", "mdi:battery-clock", "months", nullptr, "measurement", nullptr));
   publishDiscoveryMessage("sensor", "everblu_meter_rssi_dbm", buildDiscoveryJson("RSSI", "rssi_dbm", "mdi:signal", "dBm", "signal_strength", "measurement", nullptr));
   publishDiscoveryMessage("sensor", "everblu_meter_rssi_percentage", buildDiscoveryJson("Signal", "rssi_percentage", "mdi:signal-cellular-3", "%", nullptr, "measurement", nullptr));
@@ -1137,6 +1838,7 @@ void publishHADiscovery()
   publishDiscoveryMessage("sensor", "everblu_meter_time_end", buildDiscoveryJson("Sleep Time", "time_end", "mdi:clock-end", nullptr, nullptr, nullptr, nullptr));
   publishDiscoveryMessage("sensor", "everblu_meter_meter_time", buildDiscoveryJson("Meter Clock", "meter_time", "mdi:clock-digital", nullptr, nullptr, nullptr, "diagnostic"));
   publishDiscoveryMessage("sensor", "everblu_meter_meter_type", buildDiscoveryJson("Meter Type", "meter_type", "mdi:barcode", nullptr, nullptr, nullptr, "diagnostic"));
+#endif
   publishDiscoveryMessage("sensor", "everblu_meter_total_attempts", buildDiscoveryJson("Total Read Attempts", "total_attempts", "mdi:counter", nullptr, nullptr, "total_increasing", "diagnostic"));
   publishDiscoveryMessage("sensor", "everblu_meter_successful_reads", buildDiscoveryJson("Successful Reads", "successful_reads", "mdi:check-circle", nullptr, nullptr, "total_increasing", "diagnostic"));
   publishDiscoveryMessage("sensor", "everblu_meter_failed_reads", buildDiscoveryJson("Failed Reads", "failed_reads", "mdi:alert-circle", nullptr, nullptr, "total_increasing", "diagnostic"));
@@ -1146,103 +1848,173 @@ void publishHADiscovery()
   publishDiscoveryMessage("sensor", "everblu_meter_tuned_frequency", buildDiscoveryJson("Tuned Frequency (MHz)", "tuned_frequency", "mdi:radio-tower", "MHz", nullptr, "measurement", "diagnostic"));
   publishDiscoveryMessage("sensor", "everblu_meter_freq_estimate", buildDiscoveryJson("Frequency Estimate", "frequency_estimate", "mdi:sine-wave", "kHz", nullptr, "measurement", "diagnostic"));
 
+  // Read Duration: p50 of the whole read, with per-phase p50/p95/max as attributes
+  json = beginDiscoveryJson("Read Duration", "everblu_meter_read_duration");
+  json.field("ic", "mdi:timer-outline");
+  json.field("unit_of_meas", "ms");
+  json.field("dev_cla", "duration");
+  json.field("stat_cla", "measurement");
+  writeTopicField(json, "stat_t", "read_timeline");
+  json.field("val_tpl", "{{ value_json.total_ms[0] }}");
+  writeTopicField(json, "json_attr_t", "read_timeline");
+  json.field("ent_cat", "diagnostic");
+  endDiscoveryJson(json);
+  publishDiscoveryMessage("sensor", "everblu_meter_read_duration", json);
+
+  // SPI Transactions of the last read, with per-type counts and histograms as attributes
+  json = beginDiscoveryJson("SPI Transactions", "everblu_meter_spi_transactions");
+  json.field("ic", "mdi:swap-horizontal");
+  json.field("stat_cla", "measurement");
+  writeTopicField(json, "stat_t", "spi_stats");
+  json.field("val_tpl", "{{ value_json.n }}");
+  writeTopicField(json, "json_attr_t", "spi_stats");
+  json.field("ent_cat", "diagnostic");
+  endDiscoveryJson(json);
+  publishDiscoveryMessage("sensor", "everblu_meter_spi_transactions", json);
+
+  // Memory and loop health, all from the diagnostics JSON
+  json = beginDiscoveryJson("Free Heap", "everblu_meter_free_heap");
+  json.field("ic", "mdi:memory");
+  json.field("unit_of_meas", "B");
+  json.field("dev_cla", "data_size");
+  json.field("stat_cla", "measurement");
+  writeTopicField(json, "stat_t", "diagnostics");
+  json.field("val_tpl", "{{ value_json.free_heap }}");
+  json.field("ent_cat", "diagnostic");
+  endDiscoveryJson(json);
+  publishDiscoveryMessage("sensor", "everblu_meter_free_heap", json);
+
+  json = beginDiscoveryJson("Largest Free Block", "everblu_meter_largest_free_block");
+  json.field("ic", "mdi:memory");
+  json.field("unit_of_meas", "B");
+  json.field("dev_cla", "data_size");
+  json.field("stat_cla", "measurement");
+  writeTopicField(json, "stat_t", "diagnostics");
+  json.field("val_tpl", "{{ value_json.largest_block }}");
+  json.field("ent_cat", "diagnostic");
+  endDiscoveryJson(json);
+  publishDiscoveryMessage("sensor", "everblu_meter_largest_free_block", json);
+
+  json = beginDiscoveryJson("Heap Fragmentation", "everblu_meter_heap_fragmentation");
+  json.field("ic", "mdi:chart-pie");
+  json.field("unit_of_meas", "%");
+  json.field("stat_cla", "measurement");
+  writeTopicField(json, "stat_t", "diagnostics");
+  json.field("val_tpl", "{{ value_json.frag_pct }}");
+  json.field("ent_cat", "diagnostic");
+  endDiscoveryJson(json);
+  publishDiscoveryMessage("sensor", "everblu_meter_heap_fragmentation", json);
+
+  json = beginDiscoveryJson("Min Free Heap", "everblu_meter_min_free_heap");
+  json.field("ic", "mdi:memory");
+  json.field("unit_of_meas", "B");
+  json.field("dev_cla", "data_size");
+  json.field("stat_cla", "measurement");
+  writeTopicField(json, "stat_t", "diagnostics");
+  json.field("val_tpl", "{{ value_json.min_free_heap }}");
+  json.field("ent_cat", "diagnostic");
+  endDiscoveryJson(json);
+  publishDiscoveryMessage("sensor", "everblu_meter_min_free_heap", json);
+
+  json = beginDiscoveryJson("Stack Free", "everblu_meter_stack_free");
+  json.field("ic", "mdi:layers-outline");
+  json.field("unit_of_meas", "B");
+  json.field("dev_cla", "data_size");
+  json.field("stat_cla", "measurement");
+  writeTopicField(json, "stat_t", "diagnostics");
+  json.field("val_tpl", "{{ value_json.stack_free }}");
+  json.field("ent_cat", "diagnostic");
+  endDiscoveryJson(json);
+  publishDiscoveryMessage("sensor", "everblu_meter_stack_free", json);
+
+  // Longest loop block, with the loop histogram and read snapshots as attributes
+  json = beginDiscoveryJson("Max Loop Block", "everblu_meter_max_loop_block");
+  json.field("ic", "mdi:timer-sand");
+  json.field("unit_of_meas", "ms");
+  json.field("dev_cla", "duration");
+  json.field("stat_cla", "measurement");
+  writeTopicField(json, "stat_t", "diagnostics");
+  json.field("val_tpl", "{{ value_json.loop_max_ms }}");
+  writeTopicField(json, "json_attr_t", "diagnostics");
+  json.field("ent_cat", "diagnostic");
+  endDiscoveryJson(json);
+  publishDiscoveryMessage("sensor", "everblu_meter_max_loop_block", json);
+
   // Buttons
-  json = "{\n";
-  json += "  \"name\": \"Restart Device\",\n";
-  json += "  \"uniq_id\": \"" + getMeterPrefix() + "everblu_meter_restart\",\n";
-  json += "  \"obj_id\": \"" + getMeterPrefix() + "everblu_meter_restart\",\n";
-  json += "  \"qos\": 0,\n";
-  json += "  \"avty_t\": \"" + String(mqttBaseTopic) + "/status\",\n";
-  json += "  \"cmd_t\": \"" + String(mqttBaseTopic) + "/restart\",\n";
-  json += "  \"pl_prs\": \"restart\",\n";
-  json += "  \"ent_cat\": \"config\",\n";
-  json += "  \"dev\": {\n    " + buildDeviceJson() + "\n  }\n";
-  json += "}";
+  json = beginDiscoveryJson("Restart Device", "everblu_meter_restart");
+  writeTopicField(json, "cmd_t", "restart");
+  json.field("pl_prs", "restart");
+  json.field("ent_cat", "config");
+  endDiscoveryJson(json);
   publishDiscoveryMessage("button", "everblu_meter_restart", json);
 
-  json = "{\n";
-  json += "  \"name\": \"Deep Frequency Scan\",\n";
-  json += "  \"uniq_id\": \"" + getMeterPrefix() + "everblu_meter_deep_scan\",\n";
-  json += "  \"obj_id\": \"" + getMeterPrefix() + "everblu_meter_deep_scan\",\n";
-  json += "  \"ic\": \"mdi:radar\",\n";
-  json += "  \"qos\": 0,\n";
-  json += "  \"avty_t\": \"" + String(mqttBaseTopic) + "/status\",\n";
-  json += "  \"cmd_t\": \"" + String(mqttBaseTopic) + "/deep_scan\",\n";
-  json += "  \"pl_prs\": \"scan\",\n";
-  json += "  \"ent_cat\": \"config\",\n";
-  json += "  \"dev\": {\n    " + buildDeviceJson() + "\n  }\n";
-  json += "}";
+  json = beginDiscoveryJson("Deep Frequency Scan", "everblu_meter_deep_scan");
+  json.field("ic", "mdi:radar");
+  writeTopicField(json, "cmd_t", "deep_scan");
+  json.field("pl_prs", "scan");
+  json.field("ent_cat", "config");
+  endDiscoveryJson(json);
   publishDiscoveryMessage("button", "everblu_meter_deep_scan", json);
 
-  json = "{\n";
-  json += "  \"name\": \"Reset Frequency Offset\",\n";
-  json += "  \"uniq_id\": \"" + getMeterPrefix() + "everblu_meter_reset_frequency\",\n";
-  json += "  \"obj_id\": \"" + getMeterPrefix() + "everblu_meter_reset_frequency\",\n";
-  json += "  \"ic\": \"mdi:restore\",\n";
-  json += "  \"qos\": 0,\n";
-  json += "  \"avty_t\": \"" + String(mqttBaseTopic) + "/status\",\n";
-  json += "  \"cmd_t\": \"" + String(mqttBaseTopic) + "/reset_frequency\",\n";
-  json += "  \"pl_prs\": \"reset\",\n";
-  json += "  \"ent_cat\": \"config\",\n";
-  json += "  \"dev\": {\n    " + buildDeviceJson() + "\n  }\n";
-  json += "}";
+  json = beginDiscoveryJson("Reset Frequency Offset", "everblu_meter_reset_frequency");
+  json.field("ic", "mdi:restore");
+  writeTopicField(json, "cmd_t", "reset_frequency");
+  json.field("pl_prs", "reset");
+  json.field("ent_cat", "config");
+  endDiscoveryJson(json);
   publishDiscoveryMessage("button", "everblu_meter_reset_frequency", json);
 
   // Binary sensor for active reading
-  json = "{\n";
-  json += "  \"name\": \"Active Reading\",\n";
-  json += "  \"uniq_id\": \"" + getMeterPrefix() + "everblu_meter_active_reading\",\n";
-  json += "  \"obj_id\": \"" + getMeterPrefix() + "everblu_meter_active_reading\",\n";
-  json += "  \"dev_cla\": \"running\",\n";
-  json += "  \"qos\": 0,\n";
-  json += "  \"avty_t\": \"" + String(mqttBaseTopic) + "/status\",\n";
-  json += "  \"stat_t\": \"" + String(mqttBaseTopic) + "/active_reading\",\n";
-  json += "  \"pl_on\": \"true\",\n";
-  json += "  \"pl_off\": \"false\",\n";
-  json += "  \"dev\": {\n    " + buildDeviceJson() + "\n  }\n";
-  json += "}";
+  json = beginDiscoveryJson("Active Reading", "everblu_meter_active_reading");
+  json.field("dev_cla", "running");
+  writeTopicField(json, "stat_t", "active_reading");
+  json.field("pl_on", "true");
+  json.field("pl_off", "false");
+  endDiscoveryJson(json);
   publishDiscoveryMessage("binary_sensor", "everblu_meter_active_reading", json);
-
-  TS_PRINTLN("[MQTT] Home Assistant discovery messages published");
 }
 
-// Function: onConnectionEstablished
-// Description: Handles MQTT connection establishment, including Home Assistant discovery and OTA setup.
-void onConnectionEstablished()
+// Function: publishHADiscovery
+// Description: Publishes the Home Assistant discovery messages unless the same set
+// was already published (and retained) before. The set is built twice when it is
+// published: once to hash it, once to send it, so no payload has to be kept.
+// @param force Publish even if unchanged (Home Assistant restarted)
+void publishHADiscovery(bool force)
 {
-  TS_PRINTLN("[MQTT] Connected to MQTT Broker");
+  g_discoveryHash = 2166136261UL;
+  g_discoveryHashOnly = true;
+  writeHADiscovery();
+  g_discoveryHashOnly = false;
+  const uint32_t hash = g_discoveryHash;
 
-  TS_PRINTLN("[TIME] Configure time from NTP server. Please wait...");
-  // Note, my VLAN has no WAN/internet, so I am useing Home Assistant Community Add-on: chrony to proxy the time
-  configTzTime("UTC0", SECRET_NTP_SERVER);
-
-  // Wait briefly for NTP to set the clock and report status
-  const time_t MIN_VALID_EPOCH = 1609459200; // 2021-01-01
-  const unsigned long NTP_SYNC_TIMEOUT_MS = 10000;
-  bool timeSynced = false;
-  unsigned long waitStart = millis();
-  while (millis() - waitStart < NTP_SYNC_TIMEOUT_MS)
+  if (!force && hash == g_discoveryPublishedHash)
   {
-    time_t probe = time(nullptr);
-    if (probe >= MIN_VALID_EPOCH)
-    {
-      timeSynced = true;
-      break;
-    }
-    delay(200);
+    TS_PRINTF("[MQTT] Home Assistant discovery unchanged (hash %08lx), not republished\n", (unsigned long)hash);
+    return;
   }
 
-  time_t tnow = time(nullptr);
-  if (timeSynced)
+  TS_PRINTF("[MQTT] Publishing Home Assistant discovery messages (hash %08lx)...\n", (unsigned long)hash);
+  g_discoveryPublishFailed = false;
+  writeHADiscovery();
+  if (g_discoveryPublishFailed)
   {
-    TS_PRINTF("[TIME] ✓ NTP sync successful after %lu ms\n", (unsigned long)(millis() - waitStart));
+    // Leave the stored hash alone so the next connection tries again
+    TS_PRINTLN("[MQTT] [WARN] Some discovery messages were not published, will retry on reconnect");
+    return;
   }
-  else
+  if (hash != g_discoveryPublishedHash)
   {
-    TS_PRINTF("[WARNING] NTP sync failed within %lu ms. Clock may be unset (epoch=%ld).\n",
-                  (unsigned long)(millis() - waitStart), (long)tnow);
+    g_discoveryPublishedHash = hash;
+    StorageAbstraction::saveUint32(DISCOVERY_HASH_KEY, hash, DISCOVERY_HASH_MAGIC);
   }
+  TS_PRINTLN("[MQTT] Home Assistant discovery messages published");
+}
 
+// Function: reportTimeSync
+// Description: Logs the clock once NTP has set it
+static void reportTimeSync()
+{
+  time_t tnow = time(nullptr);
   struct tm *ptm = gmtime(&tnow);
   TS_PRINTF("[TIME] current date (UTC) : %04d/%02d/%02d %02d:%02d:%02d - %ld\n", ptm->tm_year + 1900, ptm->tm_mon + 1, ptm->tm_mday, ptm->tm_hour, ptm->tm_min, ptm->tm_sec, (long)tnow);
   // Print simple offset and derived local time for debugging
@@ -1253,9 +2025,22 @@ void onConnectionEstablished()
   TS_PRINTF("[TIME] Current date (UTC+offset): %04d/%02d/%02d %02d:%02d:%02d - %ld\n",
                 plocal->tm_year + 1900, plocal->tm_mon + 1, plocal->tm_mday,
                 plocal->tm_hour, plocal->tm_min, plocal->tm_sec, (long)tlocal);
+}
 
-  // Initialize schedule caches using validated UTC defaults
-  updateResolvedScheduleFromUtc(DEFAULT_READING_HOUR_UTC, DEFAULT_READING_MINUTE_UTC);
+// Function: onConnectionEstablished
+// Description: Handles MQTT connection establishment, including Home Assistant discovery and OTA setup.
+void onConnectionEstablished()
+{
+  TS_PRINTLN("[MQTT] Connected to MQTT Broker");
+
+  // Retained values (and the status the LWT overwrote) are republished in full
+  g_publishFilter.forceRefresh();
+
+  // Start NTP and carry on: connect handling and discovery don't wait for it
+  // Note, my VLAN has no WAN/internet, so I am useing Home Assistant Community Add-on: chrony to proxy the time
+  TS_PRINTLN("[TIME] Requesting time from NTP server (scheduled reads wait for it)");
+  g_timeProvider.begin(SECRET_NTP_SERVER);
+  g_timeSyncWarned = false;
 
   TS_PRINTLN("[OTA] Configure Arduino OTA flash.");
   ArduinoOTA.onStart([]()
@@ -1300,22 +2085,35 @@ void onConnectionEstablished()
     // Input validation: only accept whitelisted commands
     if (message != "update" && message != "read") {
       TS_PRINTF("[WARN] Invalid trigger command '%s' (expected 'update' or 'read')\n", message.c_str());
-      char topicBuffer[MQTT_TOPIC_BUFFER_SIZE];
-      snprintf(topicBuffer, sizeof(topicBuffer), "%s/status_message", mqttBaseTopic);
-      mqtt.publish(topicBuffer, "Invalid trigger command", true);
+      publishRetained(TOPIC_STATUS_MESSAGE, "Invalid trigger command");
       return;
     }
 
     // Check if we're in cooldown period
-    if (lastFailedAttempt > 0 && (millis() - lastFailedAttempt) < RETRY_COOLDOWN) {
-      unsigned long remainingCooldown = (RETRY_COOLDOWN - (millis() - lastFailedAttempt)) / 1000;
+    if (g_retryPolicy.isCoolingDown(millis())) {
+      unsigned long remainingCooldown = g_retryPolicy.getCooldownRemainingMs(millis()) / 1000;
       TS_PRINTF("[WARN] Cannot trigger update: Still in cooldown period. %lu seconds remaining.\n", remainingCooldown);
 
       char cooldownMsg[64];
       snprintf(cooldownMsg, sizeof(cooldownMsg), "Cooldown active, %lus remaining", remainingCooldown);
-      char topicBuffer[MQTT_TOPIC_BUFFER_SIZE];
-      snprintf(topicBuffer, sizeof(topicBuffer), "%s/status_message", mqttBaseTopic);
-      mqtt.publish(topicBuffer, cooldownMsg, true);
+      publishRetained(TOPIC_STATUS_MESSAGE, cooldownMsg);
+      return;
+    }
+
+    // Coalesce: a retry sequence in flight will publish the result this trigger wants
+    if (_retry > 0) {
+      TS_PRINTLN("[MQTT] Read already in progress, trigger joins it");
+      return;
+    }
+
+    // Serve a fresh reading from the retained topics instead of waking the meter
+    if (READ_CACHE_MAX_AGE_S > 0 && g_haveReading && millis() - g_lastReadingMs < (unsigned long)READ_CACHE_MAX_AGE_S * 1000UL) {
+      unsigned long ageSec = (millis() - g_lastReadingMs) / 1000;
+      TS_PRINTF("[MQTT] Last reading is %lus old (limit %ds), not waking the meter (use trigger_force to read anyway)\n",
+                ageSec, READ_CACHE_MAX_AGE_S);
+      char freshMsg[64];
+      snprintf(freshMsg, sizeof(freshMsg), "Reading is fresh (%lus old), not re-read", ageSec);
+      publishRetained(TOPIC_STATUS_MESSAGE, freshMsg);
       return;
     }
 
@@ -1333,13 +2131,17 @@ void onConnectionEstablished()
     // Input validation: accept same commands as the normal trigger
     if (message != "update" && message != "read") {
       TS_PRINTF("[WARN] Invalid force-trigger command '%s' (expected 'update' or 'read')\n", message.c_str());
-      char topicBuffer[MQTT_TOPIC_BUFFER_SIZE];
-      snprintf(topicBuffer, sizeof(topicBuffer), "%s/status_message", mqttBaseTopic);
-      mqtt.publish(topicBuffer, "Invalid trigger command", true);
+      publishRetained(TOPIC_STATUS_MESSAGE, "Invalid trigger command");
+      return;
+    }
+
+    // Coalesce with a retry sequence in flight rather than starting a second one
+    if (_retry > 0) {
+      TS_PRINTLN("[MQTT] Read already in progress, force trigger joins it");
       return;
     }
 
-    TS_PRINTF("[STATUS] Force update requested via MQTT (command: %s) - overriding cooldown\n", message.c_str());
+    TS_PRINTF("[STATUS] Force update requested via MQTT (command: %s) - overriding cooldown and read cache\n", message.c_str());
 
     // Immediately attempt to update, ignoring any cooldown state
     _retry = 0;
@@ -1353,18 +2155,15 @@ void onConnectionEstablished()
                    if (message != "restart")
                    {
                      TS_PRINTF("[WARN] Invalid restart command '%s' (expected 'restart')\n", message.c_str());
-                     char topicBuffer[MQTT_TOPIC_BUFFER_SIZE];
-                     snprintf(topicBuffer, sizeof(topicBuffer), "%s/status_message", mqttBaseTopic);
-                     mqtt.publish(topicBuffer, "Invalid restart command", true);
+                     publishRetained(TOPIC_STATUS_MESSAGE, "Invalid restart command");
                      return;
                    }
 
                    Serial.println("Restart command received via MQTT. Restarting in 2 seconds...");
-                   char topicBuffer[MQTT_TOPIC_BUFFER_SIZE];
-                   snprintf(topicBuffer, sizeof(topicBuffer), "%s/status_message", mqttBaseTopic);
-                   mqtt.publish(topicBuffer, "Device restarting...", true);
-                   delay(2000);   // Give time for MQTT message to be sent
-                   ESP.restart(); // Restart the ESP device
+                   publishRetained(TOPIC_STATUS_MESSAGE, "Device restarting...");
+                   delay(2000);    // Give time for MQTT message to be sent
+                   Serial.flush(); // Write out buffered log output
+                   ESP.restart();  // Restart the ESP device
                  });
 
   char wideFreqScanTopic[MQTT_TOPIC_BUFFER_SIZE];
@@ -1374,13 +2173,17 @@ void onConnectionEstablished()
     // Input validation: only accept "scan" command
     if (message != "scan") {
       TS_PRINTF("[WARN] Invalid deep scan command '%s' (expected 'scan')\n", message.c_str());
-      char topicBuffer[MQTT_TOPIC_BUFFER_SIZE];
-      snprintf(topicBuffer, sizeof(topicBuffer), "%s/status_message", mqttBaseTopic);
-      mqtt.publish(topicBuffer, "Invalid scan command", true);
+      publishRetained(TOPIC_STATUS_MESSAGE, "Invalid scan command");
       return;
     }
 
     Serial.println("Deep frequency scan command received via MQTT");
+    if (!g_readBudget.tryConsume(ReadBudget::SCAN_COST, ReadBudget::Priority::Manual, millis())) {
+      TS_PRINTF("[WARN] Read budget too low for a frequency scan (%u tokens, needs %u plus the scheduled reserve)\n",
+                (unsigned)g_readBudget.getTokens(millis()), (unsigned)ReadBudget::SCAN_COST);
+      publishRetained(TOPIC_STATUS_MESSAGE, "Read budget exhausted");
+      return;
+    }
     performDeepFrequencyScan(); });
 
   char resetFrequencyTopic[MQTT_TOPIC_BUFFER_SIZE];
@@ -1390,9 +2193,7 @@ void onConnectionEstablished()
     // Input validation: only accept "reset" command
     if (message != "reset") {
       TS_PRINTF("[WARN] Invalid reset frequency command '%s' (expected 'reset')\n", message.c_str());
-      char topicBuffer[MQTT_TOPIC_BUFFER_SIZE];
-      snprintf(topicBuffer, sizeof(topicBuffer), "%s/status_message", mqttBaseTopic);
-      mqtt.publish(topicBuffer, "Invalid reset command", true);
+      publishRetained(TOPIC_STATUS_MESSAGE, "Invalid reset command");
       return;
     }
 
@@ -1401,58 +2202,47 @@ void onConnectionEstablished()
 
   // Publish Home Assistant discovery only when enabled in compile-time config.
 #if ENABLE_HA_DISCOVERY
-  TS_PRINTLN("[MQTT] Send Home Assistant discovery config.");
-  publishHADiscovery();
+  // Home Assistant announces a restart with "online" on its status topic; its
+  // discovery state may have been lost, so publish the set again
+  mqtt.subscribe("homeassistant/status", [](const String &message)
+                 {
+    if (message == "online") {
+      TS_PRINTLN("[MQTT] Home Assistant came online, republishing discovery");
+      publishHADiscovery(true);
+    } });
+
+  publishHADiscovery(false);
 #else
   TS_PRINTLN("[MQTT] Home Assistant discovery disabled by ENABLE_HA_DISCOVERY=0");
 #endif
 
   // Set initial state for active reading
-  char topicBuffer[MQTT_TOPIC_BUFFER_SIZE];
-  snprintf(topicBuffer, sizeof(topicBuffer), "%s/active_reading", mqttBaseTopic);
-  mqtt.publish(topicBuffer, "false", true);
-  delay(5);
+  publishRetained(TOPIC_ACTIVE_READING, "false");
 
   // Publish CC1101 radio availability status for button enable/disable
-  snprintf(topicBuffer, sizeof(topicBuffer), "%s/cc1101_availability", mqttBaseTopic);
-  mqtt.publish(topicBuffer, cc1101RadioConnected ? "online" : "offline", true);
-  delay(5);
+  publishRetained(TOPIC_CC1101_AVAILABILITY, cc1101RadioConnected ? "online" : "offline");
 
   // Publish initial diagnostic metrics (using char buffers instead of String)
   char metricBuffer[16];
 
-  snprintf(topicBuffer, sizeof(topicBuffer), "%s/cc1101_state", mqttBaseTopic);
-  mqtt.publish(topicBuffer, cc1101RadioConnected ? "Idle" : "unavailable", true);
-  delay(5);
+  publishRetained(TOPIC_CC1101_STATE, cc1101RadioConnected ? "Idle" : "unavailable");
 
   snprintf(metricBuffer, sizeof(metricBuffer), "%lu", totalReadAttempts);
-  snprintf(topicBuffer, sizeof(topicBuffer), "%s/total_attempts", mqttBaseTopic);
-  mqtt.publish(topicBuffer, metricBuffer, true);
-  delay(5);
+  publishRetained(TOPIC_TOTAL_ATTEMPTS, metricBuffer);
 
   snprintf(metricBuffer, sizeof(metricBuffer), "%lu", successfulReads);
-  snprintf(topicBuffer, sizeof(topicBuffer), "%s/successful_reads", mqttBaseTopic);
-  mqtt.publish(topicBuffer, metricBuffer, true);
-  delay(5);
+  publishRetained(TOPIC_SUCCESSFUL_READS, metricBuffer);
 
   snprintf(metricBuffer, sizeof(metricBuffer), "%lu", failedReads);
-  snprintf(topicBuffer, sizeof(topicBuffer), "%s/failed_reads", mqttBaseTopic);
-  mqtt.publish(topicBuffer, metricBuffer, true);
-  delay(5);
-  snprintf(topicBuffer, sizeof(topicBuffer), "%s/last_error", mqttBaseTopic);
-  mqtt.publish(topicBuffer, lastErrorMessage, true);
-  delay(5);
+  publishRetained(TOPIC_FAILED_READS, metricBuffer);
+  publishRetained(TOPIC_LAST_ERROR, lastErrorMessage);
 
   char freqBuffer[16];
   snprintf(freqBuffer, sizeof(freqBuffer), "%.3f", FrequencyManager::getOffset() * 1000.0); // Convert MHz to kHz
-  snprintf(topicBuffer, sizeof(topicBuffer), "%s/frequency_offset", mqttBaseTopic);
-  mqtt.publish(topicBuffer, freqBuffer, true);
-  delay(5);
+  publishRetained(TOPIC_FREQUENCY_OFFSET, freqBuffer);
 
   snprintf(freqBuffer, sizeof(freqBuffer), "%.6f", FrequencyManager::getTunedFrequency());
-  snprintf(topicBuffer, sizeof(topicBuffer), "%s/tuned_frequency", mqttBaseTopic);
-  mqtt.publish(topicBuffer, freqBuffer, true);
-  delay(5);
+  publishRetained(TOPIC_TUNED_FREQUENCY, freqBuffer);
 
   TS_PRINTLN("[MQTT] MQTT config sent");
 
@@ -1462,13 +2252,28 @@ void onConnectionEstablished()
   // Publish once the meter settings as set in the softeware
   publishMeterSettings();
 
+  // Readings taken while we were offline go out now, oldest first
+  if (!g_readingQueue.isEmpty() && !g_readingQueueDraining)
+  {
+    TS_PRINTF("[MQTT] %u queued reading(s) to publish\n", (unsigned)g_readingQueue.size());
+    g_readingQueueDraining = true;
+    mqtt.executeDelayed(READING_QUEUE_DRAIN_INTERVAL_MS, drainReadingQueue);
+  }
+
   // Turn off LED to show everything is setup
   digitalWrite(LED_BUILTIN, HIGH); // turned off
 
   TS_PRINTLN("[STATUS] Setup done");
   Serial.println("================================\n");
 
-  onScheduled();
+  // Start the scheduler chain once. Delayed executions keep running across
+  // MQTT reconnects, so starting it again would stack duplicate chains.
+  static bool schedulerStarted = false;
+  if (!schedulerStarted)
+  {
+    schedulerStarted = true;
+    onScheduled();
+  }
 }
 
 // ============================================================================
@@ -1485,27 +2290,22 @@ void onConnectionEstablished()
 // progress to the Home Assistant cc1101_state / status_message topics.
 static void mqttFrequencyStatus(const char *state, const char *message)
 {
-  char topicBuffer[MQTT_TOPIC_BUFFER_SIZE];
   if (state && *state)
   {
-    snprintf(topicBuffer, sizeof(topicBuffer), "%s/cc1101_state", mqttBaseTopic);
-    mqtt.publish(topicBuffer, state, true);
+    publishRetained(TOPIC_CC1101_STATE, state);
   }
   if (message && *message)
   {
-    snprintf(topicBuffer, sizeof(topicBuffer), "%s/status_message", mqttBaseTopic);
-    mqtt.publish(topicBuffer, message, true);
+    publishRetained(TOPIC_STATUS_MESSAGE, message);
   }
 }
 
 // Publish the current frequency offset (kHz) to Home Assistant.
 static void publishFrequencyOffsetToMqtt()
 {
-  char topicBuffer[MQTT_TOPIC_BUFFER_SIZE];
   char freqBuffer[16];
   snprintf(freqBuffer, sizeof(freqBuffer), "%.3f", FrequencyManager::getOffset() * 1000.0);
-  snprintf(topicBuffer, sizeof(topicBuffer), "%s/frequency_offset", mqttBaseTopic);
-  mqtt.publish(topicBuffer, freqBuffer, true);
+  publishRetained(TOPIC_FREQUENCY_OFFSET, freqBuffer);
 }
 
 // Function: performDeepFrequencyScan
@@ -1559,11 +2359,9 @@ void resetFrequencyOffset()
 
   // Mirror the reset values to Home Assistant.
   publishFrequencyOffsetToMqtt();
-  char topicBuffer[MQTT_TOPIC_BUFFER_SIZE];
   char freqBuffer[16];
   snprintf(freqBuffer, sizeof(freqBuffer), "%.6f", FrequencyManager::getTunedFrequency());
-  snprintf(topicBuffer, sizeof(topicBuffer), "%s/tuned_frequency", mqttBaseTopic);
-  mqtt.publish(topicBuffer, freqBuffer, false);
+  publishRetained(TOPIC_TUNED_FREQUENCY, freqBuffer);
 }
 
 // Function: adaptiveFrequencyTracking
@@ -1585,17 +2383,15 @@ void adaptiveFrequencyTracking(int8_t freqest)
 
   // Always publish tuned_frequency and frequency_estimate after each read so
   // the corresponding HA sensors are not left blank/unknown.
-  char topicBuffer[MQTT_TOPIC_BUFFER_SIZE];
   char freqBuffer[16];
 
   snprintf(freqBuffer, sizeof(freqBuffer), "%.6f", FrequencyManager::getTunedFrequency());
-  snprintf(topicBuffer, sizeof(topicBuffer), "%s/tuned_frequency", mqttBaseTopic);
-  mqtt.publish(topicBuffer, freqBuffer, false);
+  publishRetained(TOPIC_TUNED_FREQUENCY, freqBuffer);
 
+  // Per-read estimate, not retained
   constexpr float FREQEST_TO_KHZ = 1.587f;
   snprintf(freqBuffer, sizeof(freqBuffer), "%.3f", static_cast<float>(freqest) * FREQEST_TO_KHZ);
-  snprintf(topicBuffer, sizeof(topicBuffer), "%s/frequency_estimate", mqttBaseTopic);
-  mqtt.publish(topicBuffer, freqBuffer, false);
+  mqtt.publish(g_topics[TOPIC_FREQUENCY_ESTIMATE], freqBuffer, false);
 }
 
 /**
@@ -1687,7 +2483,8 @@ bool validateConfiguration()
   if (!isValidReadingSchedule(readingSchedule))
   {
     TS_PRINTF("[WARNING] Invalid reading schedule '%s'. Will fall back to 'Monday-Friday'.\n", readingSchedule);
-    Serial.println("         Expected: presets ('Monday-Friday', 'Monday-Saturday', 'Monday-Sunday') or a single day ('Monday'..'Sunday')");
+    Serial.println("         Expected: presets ('Monday-Friday', 'Monday-Saturday', 'Monday-Sunday'), a single day ('Monday'..'Sunday')");
+    Serial.println("         or an Nth weekday of the month ('First-Monday'..'Fourth-Sunday', 'Last-Monday'..'Last-Sunday')");
   }
   else
   {
@@ -1711,6 +2508,8 @@ void setup()
   // Parse METER_CODE into g_meterYear, g_meterSerial, and topic buffers
   // Must happen before any code uses these values
   parseMeterCode();
+  buildTopicTable();
+  g_publishFilter.configure((unsigned long)PUBLISH_FULL_REFRESH_S * 1000UL);
 
 // On platforms with native USB Serial (e.g. some ESP32 cores) wait briefly for host to open the port
 #if defined(ESP32)
@@ -1789,6 +2588,26 @@ void setup()
 
   const bool noStoredOffset = (loadedOffset == 0.0f);
 
+  if (g_readSlotStats.load(READ_SLOT_STATS_KEY))
+  {
+    TS_PRINTLN("[SCHEDULE] Loaded read slot statistics");
+  }
+
+#if ENABLE_HA_DISCOVERY
+  StorageAbstraction::loadUint32(DISCOVERY_HASH_KEY, g_discoveryPublishedHash, DISCOVERY_HASH_MAGIC);
+#endif
+
+#if PUBLISH_QUEUE_PERSIST
+  if (g_readingQueue.load(READING_QUEUE_KEY))
+  {
+    TS_PRINTF("[MQTT] Restored %u queued reading(s) from before the reboot\n", (unsigned)g_readingQueue.size());
+  }
+#endif
+
+  // Seed the retry jitter per meter so neighbouring nodes drift apart
+  g_retryPolicy.configure(max_retries, RETRY_COOLDOWN, g_meterSerial ^ ((uint32_t)g_meterYear << 24));
+  g_readBudget.configure(READ_BUDGET_PER_DAY, READ_BUDGET_BURST, max_retries);
+
   // If no valid frequency offset found and auto-scan is enabled, perform Deep scan.
   // FrequencyManager updates its own stored offset during the scan, so no reload.
   if (noStoredOffset && autoScanEnabled)
@@ -1898,11 +2717,15 @@ void setup()
  */
 void loop()
 {
+  const unsigned long loopStartMs = millis();
+  if (g_lastLoopStartMs != 0)
+    g_diagnostics.recordLoop(loopStartMs - g_lastLoopStartMs);
+  g_lastLoopStartMs = loopStartMs;
+
   mqtt.loop();
   ArduinoOTA.handle();
-#if WIFI_SERIAL_MONITOR_ENABLED
-  wifiSerialLoop();
-#endif
+  wifiSerialLoop(); // Drains buffered serial output (UART always, TCP when the monitor is enabled)
+  echo_debug_flush(); // Debug lines deferred during a radio read, if any
 
   // Update diagnostics and Wi-Fi details every 5 minutes
   if (millis() - lastWifiUpdate > 300000)
@@ -1933,6 +2756,24 @@ void loop()
   g_prevWifiUp = wifiUp;
   g_prevMqttUp = mqttUp;
 
+  // NTP completes in the background after the connect callback started it
+  if (!g_timeSyncReported && g_timeProvider.getLastSyncAttempt() != 0)
+  {
+    if (g_timeProvider.isTimeSynced())
+    {
+      g_timeSyncReported = true;
+      reportTimeSync();
+      // The uptime sensor was derived from the unset clock
+      if (mqttUp)
+        publishWifiDetails();
+    }
+    else if (!g_timeSyncWarned && millis() - g_timeProvider.getLastSyncAttempt() > NTP_SYNC_WARN_MS)
+    {
+      g_timeSyncWarned = true;
+      TS_PRINTF("[WARNING] No NTP time after %lu ms, scheduled reads wait until it arrives\n", NTP_SYNC_WARN_MS);
+    }
+  }
+
   // Blink LED while offline (Wi-Fi or MQTT down)
   if (!(wifiUp && mqttUp))
   {
@@ -1978,6 +2819,7 @@ void loop()
     {
       TS_PRINTLN("[Wi-Fi] Offline too long. Rebooting device to recover...");
       delay(200);
+      Serial.flush();
       ESP.restart();
     }
     // No further checks if Wi-Fi is down
@@ -2015,6 +2857,7 @@ void loop()
     {
       TS_PRINTLN("[MQTT] Offline too long. Rebooting device to recover...");
       delay(200);
+      Serial.flush();
       ESP.restart();
     }
     return;
@@ -0,0 +1,521 @@
+/**
+ * @file deferred_log.cpp
+ * @brief Implementation of the deferred binary log ring
+ */
+
+#include "deferred_log.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace
+{
+// One parsed conversion specification, e.g. "%-08.3lx"
+struct Spec
+{
+    const char *flags;
+    size_t flagsLen;
+    const char *width; // Digits, or nullptr for none / '*'
+    size_t widthLen;
+    bool starWidth;
+    bool hasPrecision;
+    const char *precision;
+    size_t precisionLen;
+    bool starPrecision;
+    const char *length;
+    size_t lengthLen;
+    char conv;
+};
+
+enum ArgKind
+{
+    ARG_NONE, // "%%"
+    ARG_INT,
+    ARG_DOUBLE,
+    ARG_STRING,
+    ARG_POINTER,
+    ARG_UNSUPPORTED
+};
+
+size_t spanOf(const char *p, const char *set)
+{
+    size_t n = 0;
+    while (p[n] != '\0' && strchr(set, p[n]) != nullptr)
+    {
+        n++;
+    }
+    return n;
+}
+
+// Parse the specification starting just after '%'. Returns the character after
+// the conversion, or nullptr if the format ends mid-specification.
+const char *parseSpec(const char *p, Spec &s)
+{
+    memset(&s, 0, sizeof(s));
+    s.flags = p;
+    s.flagsLen = spanOf(p, "-+ #0");
+    p += s.flagsLen;
+
+    if (*p == '*')
+    {
+        s.starWidth = true;
+        p++;
+    }
+    else
+    {
+        s.width = p;
+        s.widthLen = spanOf(p, "0123456789");
+        p += s.widthLen;
+    }
+
+    if (*p == '.')
+    {
+        s.hasPrecision = true;
+        p++;
+        if (*p == '*')
+        {
+            s.starPrecision = true;
+            p++;
+        }
+        else
+        {
+            s.precision = p;
+            s.precisionLen = spanOf(p, "0123456789");
+            p += s.precisionLen;
+        }
+    }
+
+    s.length = p;
+    s.lengthLen = spanOf(p, "hlLzjtq");
+    p += s.lengthLen;
+
+    s.conv = *p;
+    return (*p == '\0') ? nullptr : p + 1;
+}
+
+ArgKind kindOf(const Spec &s)
+{
+    switch (s.conv)
+    {
+    case '%':
+        return ARG_NONE;
+    case 'd':
+    case 'i':
+    case 'u':
+    case 'x':
+    case 'X':
+    case 'o':
+    case 'c':
+        return ARG_INT;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+        // long double has no portable word layout
+        return (s.lengthLen == 0) ? ARG_DOUBLE : ARG_UNSUPPORTED;
+    case 's':
+        return (s.lengthLen == 0) ? ARG_STRING : ARG_UNSUPPORTED;
+    case 'p':
+        return ARG_POINTER;
+    default:
+        return ARG_UNSUPPORTED; // Includes %n, which must never be deferred
+    }
+}
+
+// Size in bytes of the promoted integer argument for the length modifier
+size_t intSize(const Spec &s)
+{
+    if (s.lengthLen == 2 && s.length[0] == 'l')
+        return sizeof(long long);
+    if (s.lengthLen == 1)
+    {
+        switch (s.length[0])
+        {
+        case 'l':
+            return sizeof(long);
+        case 'z':
+            return sizeof(size_t);
+        case 'j':
+            return sizeof(intmax_t);
+        case 't':
+            return sizeof(ptrdiff_t);
+        case 'q':
+            return sizeof(long long);
+        }
+    }
+    return sizeof(int); // none, h, hh: promoted to int
+}
+
+uint64_t readInt(const Spec &s, va_list &args)
+{
+    if (s.lengthLen == 2 && s.length[0] == 'l')
+        return (uint64_t)va_arg(args, unsigned long long);
+    if (s.lengthLen == 1)
+    {
+        switch (s.length[0])
+        {
+        case 'l':
+            return (uint64_t)va_arg(args, unsigned long);
+        case 'z':
+            return (uint64_t)va_arg(args, size_t);
+        case 'j':
+            return (uint64_t)va_arg(args, uintmax_t);
+        case 't':
+            return (uint64_t)va_arg(args, ptrdiff_t);
+        case 'q':
+            return (uint64_t)va_arg(args, unsigned long long);
+        }
+    }
+    return (uint64_t)va_arg(args, unsigned int);
+}
+
+struct WordWriter
+{
+    uint32_t *words;
+    uint8_t count;
+    bool overflow;
+
+    void push(uint32_t w)
+    {
+        if (count >= DeferredLogRecord::MAX_WORDS)
+        {
+            overflow = true;
+            return;
+        }
+        words[count++] = w;
+    }
+
+    void push(uint64_t v, size_t bytes)
+    {
+        push((uint32_t)v);
+        if (bytes > 4)
+            push((uint32_t)(v >> 32));
+    }
+};
+
+struct WordReader
+{
+    const uint32_t *words;
+    uint8_t count;
+    uint8_t pos;
+    bool error;
+
+    uint32_t next()
+    {
+        if (pos >= count)
+        {
+            error = true;
+            return 0;
+        }
+        return words[pos++];
+    }
+
+    uint64_t next(size_t bytes)
+    {
+        uint64_t v = next();
+        if (bytes > 4)
+            v |= (uint64_t)next() << 32;
+        return v;
+    }
+};
+
+// Bounded append; length keeps counting past the end so callers can clamp once
+struct TextWriter
+{
+    char *out;
+    size_t size;
+    size_t length;
+
+    char *cursor() { return (length < size) ? out + length : nullptr; }
+    size_t room() const { return (length < size) ? size - length : 0; }
+
+    void put(const char *p, size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            if (length + 1 < size)
+                out[length] = p[i];
+            length++;
+        }
+    }
+
+    void advance(int n)
+    {
+        if (n > 0)
+            length += (size_t)n;
+    }
+};
+
+void writeLE32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+} // namespace
+
+DeferredLog::DeferredLog()
+    : m_records{}, m_head(0), m_tail(0), m_dropped(0)
+{
+}
+
+bool DeferredLog::capture(const char *fmt, va_list args)
+{
+    if (fmt == nullptr)
+    {
+        return false;
+    }
+    if ((uint8_t)(m_head - m_tail) >= CAPACITY)
+    {
+        m_dropped = m_dropped + 1;
+        return false;
+    }
+
+    DeferredLogRecord &record = m_records[m_head % CAPACITY];
+    WordWriter w = {record.words, 0, false};
+    va_list ap;
+    va_copy(ap, args);
+
+    for (const char *p = fmt; *p != '\0' && !w.overflow;)
+    {
+        if (*p++ != '%')
+            continue;
+
+        Spec s;
+        p = parseSpec(p, s);
+        const ArgKind kind = p ? kindOf(s) : ARG_UNSUPPORTED;
+        if (kind == ARG_UNSUPPORTED)
+        {
+            va_end(ap);
+            return false;
+        }
+        if (kind == ARG_NONE)
+            continue;
+
+        if (s.starWidth)
+            w.push((uint32_t)va_arg(ap, int));
+        if (s.starPrecision)
+            w.push((uint32_t)va_arg(ap, int));
+
+        switch (kind)
+        {
+        case ARG_INT:
+            w.push(readInt(s, ap), intSize(s));
+            break;
+        case ARG_DOUBLE:
+        {
+            const double d = va_arg(ap, double);
+            uint64_t bits;
+            memcpy(&bits, &d, sizeof(bits));
+            w.push(bits, sizeof(bits));
+            break;
+        }
+        case ARG_POINTER:
+            w.push((uint64_t)(uintptr_t)va_arg(ap, void *), sizeof(void *));
+            break;
+        case ARG_STRING:
+        {
+            // Copy the text: the caller's buffer is usually gone by flush time
+            const char *str = va_arg(ap, const char *);
+            if (str == nullptr)
+                str = "(null)";
+            const size_t room = (DeferredLogRecord::MAX_WORDS - w.count) * 4;
+            const size_t len = strlen(str);
+            if (len + 1 > room)
+            {
+                w.overflow = true;
+                break;
+            }
+            memcpy(&record.words[w.count], str, len + 1);
+            w.count = (uint8_t)(w.count + (len + 4) / 4);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    va_end(ap);
+
+    if (w.overflow)
+    {
+        return false;
+    }
+
+    record.fmt = fmt;
+    record.timestampUs = micros();
+    record.wordCount = w.count;
+    m_head = (uint8_t)(m_head + 1); // Publish only once the record is complete
+    return true;
+}
+
+bool DeferredLog::pop(DeferredLogRecord &record)
+{
+    if (isEmpty())
+    {
+        return false;
+    }
+    record = m_records[m_tail % CAPACITY];
+    m_tail = (uint8_t)(m_tail + 1);
+    return true;
+}
+
+uint32_t DeferredLog::takeDropped()
+{
+    const uint32_t dropped = m_dropped;
+    m_dropped = 0;
+    return dropped;
+}
+
+size_t DeferredLog::format(const DeferredLogRecord &record, char *out, size_t size)
+{
+    TextWriter t = {out, out ? size : 0, 0};
+    WordReader r = {record.words, record.wordCount, 0, false};
+    const char *p = record.fmt ? record.fmt : "";
+
+    while (*p != '\0' && !r.error)
+    {
+        const char *literal = p;
+        while (*p != '\0' && *p != '%')
+            p++;
+        t.put(literal, (size_t)(p - literal));
+        if (*p == '\0')
+            break;
+
+        Spec s;
+        const char *next = parseSpec(p + 1, s);
+        const ArgKind kind = next ? kindOf(s) : ARG_UNSUPPORTED;
+        if (kind == ARG_UNSUPPORTED)
+            break; // capture() never stores such a record
+        p = next;
+        if (kind == ARG_NONE)
+        {
+            t.put("%", 1);
+            continue;
+        }
+
+        // Rebuild the specification with '*' replaced by the captured values
+        char spec[32];
+        TextWriter sw = {spec, sizeof(spec), 0};
+        sw.put("%", 1);
+        sw.put(s.flags, s.flagsLen);
+        if (s.starWidth)
+            sw.advance(snprintf(sw.cursor(), sw.room(), "%d", (int)r.next()));
+        else
+            sw.put(s.width, s.widthLen);
+        if (s.hasPrecision)
+        {
+            sw.put(".", 1);
+            if (s.starPrecision)
+                sw.advance(snprintf(sw.cursor(), sw.room(), "%d", (int)r.next()));
+            else
+                sw.put(s.precision, s.precisionLen);
+        }
+        sw.put(s.length, s.lengthLen);
+        sw.put(&s.conv, 1);
+        if (sw.length >= sizeof(spec))
+            break;
+        spec[sw.length] = '\0';
+
+        int n = 0;
+        switch (kind)
+        {
+        case ARG_INT:
+        {
+            const uint64_t v = r.next(intSize(s));
+            if (s.lengthLen == 2 && s.length[0] == 'l')
+                n = snprintf(t.cursor(), t.room(), spec, (unsigned long long)v);
+            else if (s.lengthLen == 1 && s.length[0] == 'l')
+                n = snprintf(t.cursor(), t.room(), spec, (unsigned long)v);
+            else if (s.lengthLen == 1 && s.length[0] == 'z')
+                n = snprintf(t.cursor(), t.room(), spec, (size_t)v);
+            else if (s.lengthLen == 1 && s.length[0] == 'j')
+                n = snprintf(t.cursor(), t.room(), spec, (uintmax_t)v);
+            else if (s.lengthLen == 1 && s.length[0] == 't')
+                n = snprintf(t.cursor(), t.room(), spec, (ptrdiff_t)v);
+            else if (s.lengthLen == 1 && s.length[0] == 'q')
+                n = snprintf(t.cursor(), t.room(), spec, (unsigned long long)v);
+            else
+                n = snprintf(t.cursor(), t.room(), spec, (unsigned int)v);
+            break;
+        }
+        case ARG_DOUBLE:
+        {
+            const uint64_t bits = r.next(sizeof(double));
+            double d;
+            memcpy(&d, &bits, sizeof(d));
+            n = snprintf(t.cursor(), t.room(), spec, d);
+            break;
+        }
+        case ARG_POINTER:
+            n = snprintf(t.cursor(), t.room(), spec, (void *)(uintptr_t)r.next(sizeof(void *)));
+            break;
+        case ARG_STRING:
+        {
+            if (r.pos >= r.count)
+            {
+                r.error = true;
+                break;
+            }
+            const char *str = reinterpret_cast<const char *>(&record.words[r.pos]);
+            const size_t maxLen = (size_t)(r.count - r.pos) * 4;
+            const size_t len = strnlen(str, maxLen);
+            if (len == maxLen)
+            {
+                r.error = true; // Not terminated: corrupt record
+                break;
+            }
+            r.pos = (uint8_t)(r.pos + (len + 4) / 4);
+            n = snprintf(t.cursor(), t.room(), spec, str);
+            break;
+        }
+        default:
+            break;
+        }
+        if (!r.error)
+            t.advance(n);
+    }
+
+    if (t.size == 0)
+        return 0;
+    const size_t end = (t.length < t.size) ? t.length : t.size - 1;
+    out[end] = '\0';
+    return end;
+}
+
+size_t DeferredLog::exportRecord(const DeferredLogRecord &record, uint8_t *out, size_t size)
+{
+    const uint8_t count = (record.wordCount <= DeferredLogRecord::MAX_WORDS) ? record.wordCount
+                                                                            : DeferredLogRecord::MAX_WORDS;
+    const size_t length = 10 + (size_t)count * 4;
+    if (out == nullptr || size < length)
+    {
+        return 0;
+    }
+
+    writeLE32(out, formatId(record.fmt));
+    writeLE32(out + 4, record.timestampUs);
+    out[8] = count;
+    out[9] = (uint8_t)((sizeof(long) > 4 ? 0x01 : 0) | (sizeof(void *) > 4 ? 0x02 : 0));
+    for (uint8_t i = 0; i < count; i++)
+    {
+        writeLE32(out + 10 + i * 4, record.words[i]);
+    }
+    return length;
+}
+
+uint32_t DeferredLog::formatId(const char *fmt)
+{
+    // FNV-1a, matching the host decoder
+    uint32_t h = 2166136261UL;
+    for (const char *p = fmt ? fmt : ""; *p != '\0'; p++)
+    {
+        h ^= (uint8_t)*p;
+        h *= 16777619UL;
+    }
+    return h;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file deferred_log.h
+ * @brief Binary ring of unformatted log records for time-critical code paths
+ *
+ * Formatting a debug line (vsnprintf, timestamp, colour prefix, Serial/telnet
+ * write) costs hundreds of microseconds per call, and the radio TX feed and
+ * RX capture loops are sensitive to that. While deferral is active a log call
+ * only stores the format string pointer, a microsecond timestamp and the raw
+ * argument words; the text is produced later, outside the critical window.
+ *
+ * Records can also be exported in a compact binary form that carries an ID
+ * (FNV-1a hash) of the format string instead of the string itself, so a host
+ * tool with the source tree can decode a captured log
+ * (tools/deferred_log_decoder.py). Wire layout of one exported record, all
+ * multi-byte integers little-endian:
+ *
+ *   u32     format ID (FNV-1a of the format string, without the NUL)
+ *   u32     capture timestamp (micros())
+ *   u8      argument word count n
+ *   u8      flags: bit 0 long is 64-bit, bit 1 pointer is 64-bit
+ *   u32 x n argument words
+ *
+ * Supported conversions: d i u x X o c (with hh h l ll z j t), p, s (the text
+ * is copied into the record), f e g a (stored as a double) and '*' width and
+ * precision. A call whose arguments do not fit a record is refused so the
+ * caller can format it immediately instead.
+ *
+ * Single producer, single consumer: the head is only written by capture()
+ * and the tail only by pop(), so capture is safe against a concurrent flush.
+ *
+ * This module is designed to be reusable across different projects (Arduino, ESPHome, etc.)
+ * and is independent of MQTT or WiFi dependencies.
+ */
+
+#ifndef DEFERRED_LOG_H
+#define DEFERRED_LOG_H
+
+#include <Arduino.h>
+#include <stdarg.h>
+
+/**
+ * @struct DeferredLogRecord
+ * @brief One captured, not yet formatted, log call
+ */
+struct DeferredLogRecord
+{
+    static constexpr uint8_t MAX_WORDS = 8;
+
+    const char *fmt;           // Format string (must outlive the record, e.g. a literal)
+    uint32_t timestampUs;      // micros() at capture
+    uint8_t wordCount;         // Argument words in use
+    uint32_t words[MAX_WORDS]; // Raw arguments in format order
+};
+
+/**
+ * @class DeferredLog
+ * @brief Fixed-capacity ring of DeferredLogRecord
+ */
+class DeferredLog
+{
+public:
+    static constexpr uint8_t CAPACITY = 32;
+
+    /// Largest exported record (header plus every argument word)
+    static constexpr size_t MAX_EXPORT_SIZE = 10 + DeferredLogRecord::MAX_WORDS * 4;
+
+    DeferredLog();
+
+    /**
+     * @brief Store a log call without formatting it
+     * @param fmt printf-style format string; only the pointer is kept
+     * @param args Arguments matching fmt (not consumed; a copy is read)
+     * @return false if the ring is full (counted as dropped, isFull() is true)
+     *         or the arguments do not fit a record or use an unsupported
+     *         conversion (not counted; the caller should format it immediately)
+     */
+    bool capture(const char *fmt, va_list args);
+
+    /**
+     * @brief Remove the oldest record
+     * @param record Output
+     * @return false if the ring is empty
+     */
+    bool pop(DeferredLogRecord &record);
+
+    bool isEmpty() const { return m_head == m_tail; }
+    bool isFull() const { return size() >= CAPACITY; }
+    uint8_t size() const { return (uint8_t)(m_head - m_tail); }
+
+    /// Records lost because the ring was full, since the last takeDropped()
+    uint32_t takeDropped();
+
+    /**
+     * @brief Format a record as printf would have
+     * @param record Record produced by capture()
+     * @param out Output buffer (always NUL-terminated when size > 0)
+     * @param size Output buffer size
+     * @return Length written, excluding the NUL
+     */
+    static size_t format(const DeferredLogRecord &record, char *out, size_t size);
+
+    /**
+     * @brief Encode a record for the host decoder (layout in the file comment)
+     * @return Encoded length, or 0 if the buffer is too small
+     */
+    static size_t exportRecord(const DeferredLogRecord &record, uint8_t *out, size_t size);
+
+    /// Format ID used by exportRecord(): FNV-1a of the string without its NUL
+    static uint32_t formatId(const char *fmt);
+
+private:
+    DeferredLogRecord m_records[CAPACITY];
+    volatile uint8_t m_head; // Next slot to write; only capture() advances it
+    volatile uint8_t m_tail; // Next slot to read; only pop() advances it
+    volatile uint32_t m_dropped;
+};
+
+#endif // DEFERRED_LOG_H
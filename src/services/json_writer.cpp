@@ -0,0 +1,227 @@
+/**
+ * @file json_writer.cpp
+ * @brief Implementation of the allocation-free JSON writer
+ */
+
+#include "json_writer.h"
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+// Decimal digits of number into text (no NUL), most significant first.
+// History and discovery payloads are mostly integers, so this skips the
+// printf format parsing for every one of them.
+size_t formatUnsigned(unsigned long number, char *text)
+{
+    char digits[20];
+    size_t count = 0;
+    do
+    {
+        digits[count++] = (char)('0' + number % 10);
+        number /= 10;
+    } while (number != 0);
+    for (size_t i = 0; i < count; i++)
+    {
+        text[i] = digits[count - 1 - i];
+    }
+    return count;
+}
+} // namespace
+
+JsonWriter::JsonWriter(char *buffer, size_t size)
+    : m_buffer(buffer), m_size(size), m_length(0), m_overflow(buffer == nullptr || size == 0), m_afterKey(false),
+      m_depth(0), m_hasItems(0)
+{
+    if (!m_overflow)
+    {
+        m_buffer[0] = '\0';
+    }
+}
+
+void JsonWriter::append(const char *text, size_t n)
+{
+    if (m_overflow)
+    {
+        return;
+    }
+    if (m_length + n >= m_size)
+    {
+        m_overflow = true;
+        return;
+    }
+    memcpy(m_buffer + m_length, text, n);
+    m_length += n;
+    m_buffer[m_length] = '\0';
+}
+
+void JsonWriter::put(char c)
+{
+    append(&c, 1);
+}
+
+void JsonWriter::separate()
+{
+    if (m_afterKey)
+    {
+        m_afterKey = false;
+        return;
+    }
+    if (m_depth == 0 || m_depth > MAX_DEPTH)
+    {
+        return;
+    }
+    const uint8_t bit = 1u << (m_depth - 1);
+    if (m_hasItems & bit)
+    {
+        put(',');
+    }
+    m_hasItems |= bit;
+}
+
+void JsonWriter::open(char bracket)
+{
+    separate();
+    put(bracket);
+    m_depth++;
+    if (m_depth <= MAX_DEPTH)
+    {
+        m_hasItems &= ~(1u << (m_depth - 1));
+    }
+}
+
+void JsonWriter::close(char bracket)
+{
+    if (m_depth > 0)
+    {
+        m_depth--;
+    }
+    put(bracket);
+}
+
+void JsonWriter::beginObject()
+{
+    open('{');
+}
+
+void JsonWriter::endObject()
+{
+    close('}');
+}
+
+void JsonWriter::beginArray()
+{
+    open('[');
+}
+
+void JsonWriter::endArray()
+{
+    close(']');
+}
+
+void JsonWriter::key(const char *name)
+{
+    value(name);
+    put(':');
+    m_afterKey = true;
+}
+
+void JsonWriter::value(const char *text)
+{
+    separate();
+    if (!text)
+    {
+        append("null", 4);
+        return;
+    }
+
+    put('"');
+    for (const char *p = text; *p; p++)
+    {
+        const unsigned char c = (unsigned char)*p;
+        if (c == '"' || c == '\\')
+        {
+            const char escaped[2] = {'\\', (char)c};
+            append(escaped, 2);
+        }
+        else if (c == '\n')
+        {
+            append("\\n", 2);
+        }
+        else if (c < 0x20)
+        {
+            char escaped[7];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            append(escaped, 6);
+        }
+        else
+        {
+            put((char)c);
+        }
+    }
+    put('"');
+}
+
+void JsonWriter::value(long number)
+{
+    char text[24];
+    size_t n = 0;
+    if (number < 0)
+    {
+        text[n++] = '-';
+    }
+    // Negate in unsigned arithmetic so LONG_MIN does not overflow
+    const unsigned long magnitude = (number < 0) ? 0UL - (unsigned long)number : (unsigned long)number;
+    n += formatUnsigned(magnitude, text + n);
+    separate();
+    append(text, n);
+}
+
+void JsonWriter::value(unsigned long number)
+{
+    char text[24];
+    const size_t n = formatUnsigned(number, text);
+    separate();
+    append(text, n);
+}
+
+void JsonWriter::value(bool flag)
+{
+    separate();
+    if (flag)
+    {
+        append("true", 4);
+    }
+    else
+    {
+        append("false", 5);
+    }
+}
+
+void JsonWriter::value(double number, uint8_t decimals)
+{
+    if (!std::isfinite(number))
+    {
+        separate();
+        append("null", 4); // JSON has no NaN or Infinity
+        return;
+    }
+    char text[32];
+    const int n = snprintf(text, sizeof(text), "%.*f", (int)decimals, number);
+    separate();
+    if (n <= 0 || n >= (int)sizeof(text))
+    {
+        m_overflow = true;
+        return;
+    }
+    append(text, (size_t)n);
+}
+
+void JsonWriter::raw(const char *json)
+{
+    separate();
+    if (json)
+    {
+        append(json, strlen(json));
+    }
+}
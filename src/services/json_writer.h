@@ -0,0 +1,113 @@
+/**
+ * @file json_writer.h
+ * @brief Allocation-free streaming JSON writer over a caller-supplied buffer
+ *
+ * Writes compact JSON straight into a fixed char buffer: commas are inserted
+ * automatically, strings are escaped, and every write is bounds-checked. A
+ * write that does not fit marks the writer as overflowed and leaves the
+ * buffer NUL-terminated, so callers check ok() once at the end instead of
+ * after every field. Used for Home Assistant discovery, state payloads and
+ * the history attributes.
+ *
+ * This module is designed to be reusable across different projects (Arduino, ESPHome, etc.)
+ * and is independent of MQTT or WiFi dependencies.
+ */
+
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <Arduino.h>
+
+/**
+ * @class JsonWriter
+ * @brief Appends JSON tokens to a fixed buffer
+ *
+ * Example:
+ * @code
+ * char buf[128];
+ * JsonWriter w(buf, sizeof(buf));
+ * w.beginObject();
+ * w.field("liters", 1234UL);
+ * w.field("timestamp", "2026-01-01T00:00:00Z");
+ * w.endObject();
+ * if (w.ok()) publish(buf);
+ * @endcode
+ */
+class JsonWriter
+{
+public:
+    static constexpr uint8_t MAX_DEPTH = 8; // Nesting levels tracked for comma placement
+
+    /**
+     * @param buffer Output buffer (always NUL-terminated when size > 0)
+     * @param size Buffer size in bytes, terminator included
+     */
+    JsonWriter(char *buffer, size_t size);
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+
+    /**
+     * @brief Write an object key; the next value belongs to it
+     */
+    void key(const char *name);
+
+    void value(const char *text); // Escaped string, or null for nullptr
+    void value(long number);
+    void value(unsigned long number);
+    void value(int number) { value((long)number); }
+    void value(unsigned int number) { value((unsigned long)number); }
+    void value(bool flag);
+
+    /**
+     * @brief Write a number with a fixed number of decimals (null if NaN or infinite)
+     */
+    void value(double number, uint8_t decimals);
+
+    /**
+     * @brief Write pre-formatted JSON (a number, or a nested document) as-is
+     */
+    void raw(const char *json);
+
+    template <typename T>
+    void field(const char *name, T v)
+    {
+        key(name);
+        value(v);
+    }
+
+    void field(const char *name, double number, uint8_t decimals)
+    {
+        key(name);
+        value(number, decimals);
+    }
+
+    /**
+     * @brief Check that everything written so far fit in the buffer
+     */
+    bool ok() const { return !m_overflow && m_depth <= MAX_DEPTH; }
+
+    /// Characters written, terminator excluded
+    size_t length() const { return m_length; }
+
+    const char *c_str() const { return m_buffer; }
+
+private:
+    void separate();
+    void put(char c);
+    void append(const char *text, size_t n);
+    void open(char bracket);
+    void close(char bracket);
+
+    char *m_buffer;
+    size_t m_size;
+    size_t m_length;
+    bool m_overflow;
+    bool m_afterKey;
+    uint8_t m_depth;
+    uint8_t m_hasItems; // Bit per depth: a value was already written at that level
+};
+
+#endif // JSON_WRITER_H
@@ -0,0 +1,162 @@
+/**
+ * @file meter_clock_tracker.cpp
+ * @brief Implementation of meter clock offset and drift estimation
+ */
+
+#include "meter_clock_tracker.h"
+
+MeterClockTracker::MeterClockTracker()
+{
+    reset();
+}
+
+void MeterClockTracker::reset()
+{
+    m_count = 0;
+    m_next = 0;
+    m_refUtc = 0;
+    m_fitOffset = 0.0f;
+    m_slope = 0.0f;
+}
+
+bool MeterClockTracker::addSample(time_t meterClock, time_t utc)
+{
+    const int32_t offset = (int32_t)(meterClock - utc);
+    bool continuous = true;
+
+    if (m_count > 0)
+    {
+        const int32_t predicted = getOffsetSeconds(utc);
+        if (abs(offset - predicted) > STEP_THRESHOLD_S)
+        {
+            reset();
+            continuous = false;
+        }
+    }
+
+    if (m_count > 0)
+    {
+        const uint8_t newest = (m_next + MAX_SAMPLES - 1) % MAX_SAMPLES;
+        if (utc - m_samples[newest].utc < MIN_SAMPLE_SPACING_S)
+        {
+            // Keep the span wide: a burst of manual reads refreshes the newest point
+            m_samples[newest] = {utc, offset};
+            refit();
+            return continuous;
+        }
+    }
+
+    m_samples[m_next] = {utc, offset};
+    m_next = (m_next + 1) % MAX_SAMPLES;
+    if (m_count < MAX_SAMPLES)
+    {
+        m_count++;
+    }
+    refit();
+    return continuous;
+}
+
+void MeterClockTracker::refit()
+{
+    // Centre on the mean time so float precision is spent on the differences
+    double sumT = 0.0;
+    double sumO = 0.0;
+    const uint8_t first = (m_count < MAX_SAMPLES) ? 0 : m_next;
+    const time_t base = m_samples[first].utc;
+    for (uint8_t i = 0; i < m_count; i++)
+    {
+        sumT += (double)(m_samples[i].utc - base);
+        sumO += m_samples[i].offset;
+    }
+    const double meanT = sumT / m_count;
+    const double meanO = sumO / m_count;
+
+    m_refUtc = base + (time_t)meanT;
+    m_fitOffset = (float)meanO;
+    m_slope = 0.0f;
+
+    if (!hasDrift())
+    {
+        return;
+    }
+
+    double sxx = 0.0;
+    double sxy = 0.0;
+    for (uint8_t i = 0; i < m_count; i++)
+    {
+        const double dt = (double)(m_samples[i].utc - base) - meanT;
+        sxx += dt * dt;
+        sxy += dt * (m_samples[i].offset - meanO);
+    }
+    if (sxx > 0.0)
+    {
+        m_slope = (float)(sxy / sxx);
+    }
+}
+
+bool MeterClockTracker::hasDrift() const
+{
+    if (m_count < 2)
+    {
+        return false;
+    }
+    const uint8_t oldest = (m_count < MAX_SAMPLES) ? 0 : m_next;
+    const uint8_t newest = (m_next + MAX_SAMPLES - 1) % MAX_SAMPLES;
+    return m_samples[newest].utc - m_samples[oldest].utc >= MIN_DRIFT_SPAN_S;
+}
+
+int32_t MeterClockTracker::getOffsetSeconds(time_t utc) const
+{
+    if (m_count == 0)
+    {
+        return 0;
+    }
+    const float predicted = m_fitOffset + m_slope * (float)(utc - m_refUtc);
+    return (int32_t)lroundf(predicted);
+}
+
+int MeterClockTracker::getShiftMinutes(time_t utc, int timezoneOffsetMinutes) const
+{
+    const int32_t offset = getOffsetSeconds(utc);
+    const int32_t offsetMinutes = (offset >= 0) ? (offset + 30) / 60 : -((-offset + 30) / 60);
+    return (int)offsetMinutes - timezoneOffsetMinutes;
+}
+
+bool MeterClockTracker::isWindowClosed(time_t utc, int windowStartHour, int windowEndHour) const
+{
+    const int start = constrain(windowStartHour, 0, 23);
+    const int length = (constrain(windowEndHour, 0, 23) - start + 24) % 24;
+    if (!isValid() || length == 0)
+    {
+        return false;
+    }
+
+    // The meter clock epoch is its wall-clock time, so the hour is read off directly
+    const time_t meterClock = utc + getOffsetSeconds(utc);
+    const int meterHour = (int)(((meterClock % 86400) + 86400) % 86400 / 3600);
+    return (meterHour - start + 24) % 24 >= length;
+}
+
+int MeterClockTracker::guardReadMinute(int minuteOfDay, int windowStartHour, int windowEndHour, int shiftMinutes,
+                                       int guardMinutes)
+{
+    const int length = ((constrain(windowEndHour, 0, 23) - constrain(windowStartHour, 0, 23) + 24) % 24) * 60;
+    if (length == 0 || length <= 2 * guardMinutes)
+    {
+        return minuteOfDay;
+    }
+
+    // Window in local-offset minutes, and the reading time relative to its opening
+    const int open = ((constrain(windowStartHour, 0, 23) * 60 - shiftMinutes) % 1440 + 1440) % 1440;
+    const int rel = ((minuteOfDay - open) % 1440 + 1440) % 1440;
+
+    if (rel < guardMinutes || rel >= 1440 - 60)
+    {
+        return (open + guardMinutes) % 1440; // At or just before the opening edge
+    }
+    if (rel >= length - guardMinutes && rel < length + 60)
+    {
+        return (open + length - guardMinutes - 1) % 1440; // At or just past the closing edge
+    }
+    return minuteOfDay;
+}
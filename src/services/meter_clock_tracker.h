@@ -0,0 +1,139 @@
+/**
+ * @file meter_clock_tracker.h
+ * @brief Meter real-time clock offset and drift estimation
+ *
+ * The meter opens its radio only between time_start and time_end by its OWN
+ * clock, which has no time zone and drifts by tens of ppm. Each successful
+ * read carries a snapshot of that clock; comparing it with the NTP time of the
+ * read gives the meter's offset. A least-squares fit over the last few reads
+ * gives the drift rate, so the wake window edges can be predicted in our time
+ * base instead of assuming the meter clock matches ours.
+ *
+ * This module is designed to be reusable across different projects (Arduino, ESPHome, etc.)
+ * and is independent of MQTT or WiFi dependencies.
+ */
+
+#ifndef METER_CLOCK_TRACKER_H
+#define METER_CLOCK_TRACKER_H
+
+#include <Arduino.h>
+#include <time.h>
+
+/**
+ * @class MeterClockTracker
+ * @brief Per-meter estimate of meter clock offset (seconds) and drift (ppm)
+ *
+ * Keeps up to MAX_SAMPLES (utc, offset) pairs at least MIN_SAMPLE_SPACING_S
+ * apart. A sample that disagrees with the prediction by more than
+ * STEP_THRESHOLD_S (meter clock set, battery swap, meter DST change) restarts
+ * the history rather than skewing the fit.
+ */
+class MeterClockTracker
+{
+public:
+    static constexpr uint8_t MAX_SAMPLES = 8;
+    static constexpr time_t MIN_SAMPLE_SPACING_S = 6 * 60 * 60; // Closer samples replace the newest
+    static constexpr time_t MIN_DRIFT_SPAN_S = 24 * 60 * 60;    // Span needed before drift is estimated
+    static constexpr int32_t STEP_THRESHOLD_S = 90;
+
+    MeterClockTracker();
+
+    /**
+     * @brief Forget all samples
+     */
+    void reset();
+
+    /**
+     * @brief Add a meter clock observation
+     *
+     * @param meterClock Meter clock as epoch seconds in the meter's time base
+     * @param utc NTP time (UTC epoch) when the frame was received
+     * @return false if the sample was a clock step and restarted the history
+     */
+    bool addSample(time_t meterClock, time_t utc);
+
+    /**
+     * @brief Check if at least one sample is available
+     */
+    bool isValid() const { return m_count > 0; }
+
+    /**
+     * @brief Check if the samples span long enough to estimate drift
+     */
+    bool hasDrift() const;
+
+    /**
+     * @brief Predict the meter clock offset at a given time
+     * @param utc UTC epoch
+     * @return Meter clock minus UTC in seconds (0 if no samples)
+     */
+    int32_t getOffsetSeconds(time_t utc) const;
+
+    /**
+     * @brief Get the estimated drift rate
+     * @return Parts per million, positive when the meter clock runs fast (0 until hasDrift())
+     */
+    float getDriftPpm() const { return m_slope * 1e6f; }
+
+    /**
+     * @brief Meter clock minus local-offset time, in whole minutes
+     *
+     * Zero when the meter clock agrees with our local-offset time; a meter
+     * set to UTC in a UTC+1 zone gives -60.
+     *
+     * @param utc UTC epoch
+     * @param timezoneOffsetMinutes Our timezone offset from UTC in minutes
+     */
+    int getShiftMinutes(time_t utc, int timezoneOffsetMinutes) const;
+
+    /**
+     * @brief Check if the meter's wake window is closed at a given time
+     *
+     * Uses the meter clock predicted for utc, so it only answers once a
+     * sample is available.
+     *
+     * @param utc UTC epoch
+     * @param windowStartHour Wake window start by the meter clock (0-23)
+     * @param windowEndHour Wake window end by the meter clock (0-23, exclusive)
+     * @return true if the meter clock is known and outside the window; false
+     *         if inside, unknown, or the window is all day
+     */
+    bool isWindowClosed(time_t utc, int windowStartHour, int windowEndHour) const;
+
+    /**
+     * @brief Keep a reading time clear of the meter's wake window edges
+     *
+     * Moves a reading time that falls just before the window opens, or within
+     * guardMinutes of either edge, to guardMinutes inside the window. Times
+     * well outside the window are returned unchanged.
+     *
+     * @param minuteOfDay Reading time in local-offset minutes (0-1439)
+     * @param windowStartHour Wake window start by the meter clock (0-23)
+     * @param windowEndHour Wake window end by the meter clock (0-23, exclusive)
+     * @param shiftMinutes Meter clock minus local-offset time (getShiftMinutes())
+     * @param guardMinutes Margin to keep from each edge
+     * @return Adjusted reading time in local-offset minutes (0-1439)
+     */
+    static int guardReadMinute(int minuteOfDay, int windowStartHour, int windowEndHour, int shiftMinutes,
+                               int guardMinutes);
+
+private:
+    struct Sample
+    {
+        time_t utc;
+        int32_t offset; // Meter clock minus UTC, seconds
+    };
+
+    void refit();
+
+    Sample m_samples[MAX_SAMPLES]; // Ring buffer, oldest at m_next once full
+    uint8_t m_count;
+    uint8_t m_next;
+
+    // Fit: offset(utc) = m_fitOffset + m_slope * (utc - m_refUtc)
+    time_t m_refUtc;
+    float m_fitOffset;
+    float m_slope;
+};
+
+#endif // METER_CLOCK_TRACKER_H
@@ -4,6 +4,7 @@
  */
 
 #include "meter_history.h"
+#include "json_writer.h"
 #include "../core/logging.h"
 #include <cstring>
 
@@ -11,136 +12,92 @@ HistoryStats MeterHistory::calculateStats(const uint32_t history[13], uint32_t c
 {
     HistoryStats stats = {};
     stats.currentVolume = currentVolume;
-
-    // Count valid months
-    stats.monthCount = countValidMonths(history);
-
-    if (stats.monthCount == 0)
+    if (!history)
     {
-        return stats; // No valid history
+        return stats;
     }
 
-    // Calculate monthly usage for each valid month
+    // One pass: the valid months run up to the first zero entry. The oldest
+    // month has no earlier baseline, so its usage stays 0.
     uint32_t totalUsage = 0;
-    for (int i = 0; i < stats.monthCount; i++)
+    int count = 0;
+    while (count < 13 && history[count] != 0)
     {
-        if (i == 0)
-        {
-            // First month: can't calculate without older baseline
-            stats.monthlyUsage[i] = 0;
-        }
-        else if (history[i] >= history[i - 1])
+        if (count > 0)
         {
-            stats.monthlyUsage[i] = history[i] - history[i - 1];
+            stats.monthlyUsage[count] = calculateUsage(history[count], history[count - 1]);
+            totalUsage += stats.monthlyUsage[count];
         }
-        else
-        {
-            stats.monthlyUsage[i] = 0; // Meter reset or underflow
-        }
-        totalUsage += stats.monthlyUsage[i];
+        count++;
     }
+    stats.monthCount = count;
 
-    // Calculate current month usage
-    if (stats.monthCount > 0 && currentVolume >= history[stats.monthCount - 1])
-    {
-        stats.currentMonthUsage = currentVolume - history[stats.monthCount - 1];
-    }
-    else
+    if (count == 0)
     {
-        stats.currentMonthUsage = 0;
+        return stats; // No valid history
     }
 
+    stats.currentMonthUsage = calculateUsage(currentVolume, history[count - 1]);
     stats.totalUsage = totalUsage + stats.currentMonthUsage;
-    stats.averageMonthlyUsage = (stats.monthCount > 0) ? (stats.totalUsage / (stats.monthCount + 1)) : 0;
+    stats.averageMonthlyUsage = stats.totalUsage / (count + 1);
 
     return stats;
 }
 
 int MeterHistory::generateHistoryJson(const uint32_t history[13], uint32_t currentVolume,
                                       char *outputBuffer, int bufferSize)
+{
+    return writeHistoryJson(history, calculateStats(history, currentVolume), outputBuffer, bufferSize);
+}
+
+int MeterHistory::writeHistoryJson(const uint32_t history[13], const HistoryStats &stats,
+                                   char *outputBuffer, int bufferSize)
 {
     if (!outputBuffer || bufferSize <= 1)
     {
         return 0;
     }
 
-    int monthCount = countValidMonths(history);
-    if (monthCount == 0)
+    if (stats.monthCount == 0)
     {
+        outputBuffer[0] = '\0';
         return 0; // No valid history
     }
 
-    int pos = 0;
-    int remaining = bufferSize;
-
-    // Start JSON object
-    pos += snprintf(outputBuffer + pos, remaining, "{\"history\":[");
-    remaining = bufferSize - pos;
+    JsonWriter json(outputBuffer, (size_t)bufferSize);
+    json.beginObject();
 
-    if (remaining <= 1)
-    {
-        return 0;
-    }
-
-    // Add historical volumes
-    for (int i = 0; i < monthCount; i++)
-    {
-        remaining = bufferSize - pos;
-        if (remaining <= 1)
-        {
-            break;
-        }
-        pos += snprintf(outputBuffer + pos, remaining, "%s%u",
-                        (i > 0 ? "," : ""), history[i]);
-    }
-
-    // Add monthly usage calculations
-    remaining = bufferSize - pos;
-    if (remaining <= 1)
+    json.key("history");
+    json.beginArray();
+    for (int i = 0; i < stats.monthCount; i++)
     {
-        // Buffer full before monthly_usage - close and return best-effort
-        outputBuffer[bufferSize - 1] = '\0';
-        return pos;
+        json.value((unsigned long)history[i]);
     }
-
-    pos += snprintf(outputBuffer + pos, remaining, "],\"monthly_usage\":[");
+    json.endArray();
 
     // Start at the second month: the oldest month has no earlier baseline, so we
     // omit it entirely rather than publishing a misleading value. monthly_usage
     // holds (monthCount - 1) real month-over-month deltas, aligned so
     // monthly_usage[k] pairs with history[k+1].
-    for (int i = 1; i < monthCount; i++)
+    json.key("monthly_usage");
+    json.beginArray();
+    for (int i = 1; i < stats.monthCount; i++)
     {
-        uint32_t usage = calculateUsage(history[i], history[i - 1]);
-
-        remaining = bufferSize - pos;
-        if (remaining <= 1)
-        {
-            break;
-        }
-        pos += snprintf(outputBuffer + pos, remaining, "%s%u",
-                        (i > 1 ? "," : ""), usage);
+        json.value((unsigned long)stats.monthlyUsage[i]);
     }
+    json.endArray();
 
-    // Calculate current month usage
-    uint32_t currentMonthUsage = calculateUsage(currentVolume, (monthCount > 0) ? history[monthCount - 1] : 0);
+    json.field("current_month_usage", (unsigned long)stats.currentMonthUsage);
+    json.field("months_available", stats.monthCount);
+    json.endObject();
 
-    remaining = bufferSize - pos;
-    if (remaining <= 1)
+    // A truncated document is not valid JSON; publish nothing rather than that
+    if (!json.ok())
     {
-        // Buffer full - close and return best-effort
-        outputBuffer[bufferSize - 1] = '\0';
-        return pos;
+        outputBuffer[0] = '\0';
+        return 0;
     }
-
-    pos += snprintf(outputBuffer + pos, remaining,
-                    "],\"current_month_usage\":%u,\"months_available\":%d}",
-                    currentMonthUsage, monthCount);
-
-    // Ensure null termination
-    outputBuffer[bufferSize - 1] = '\0';
-
-    return pos;
+    return (int)json.length();
 }
 
 void MeterHistory::getMonthLabel(int monthIndex, int totalMonths, char *outputBuffer, int bufferSize)
@@ -168,7 +125,13 @@ void MeterHistory::getMonthLabel(int monthIndex, int totalMonths, char *outputBu
 void MeterHistory::printToSerial(const uint32_t history[13], uint32_t currentVolume,
                                  const char *headerPrefix)
 {
-    int monthCount = countValidMonths(history);
+    printToSerial(history, calculateStats(history, currentVolume), headerPrefix);
+}
+
+void MeterHistory::printToSerial(const uint32_t history[13], const HistoryStats &stats,
+                                 const char *headerPrefix)
+{
+    const int monthCount = stats.monthCount;
 
     if (monthCount == 0)
     {
@@ -187,14 +150,13 @@ void MeterHistory::printToSerial(const uint32_t history[13], uint32_t currentVol
     // below as "Now".
     for (int i = 0; i < monthCount; i++)
     {
-        uint32_t usage = (i > 0) ? calculateUsage(history[i], history[i - 1]) : 0;
-        LOG_I("everblu_meter", "%s  -%02d   %10u  %9u", headerPrefix, monthCount - 1 - i, history[i], usage);
+        LOG_I("everblu_meter", "%s  -%02d   %10u  %9u", headerPrefix, monthCount - 1 - i, history[i],
+              stats.monthlyUsage[i]);
     }
 
     // Print current month usage
-    uint32_t currentMonthUsage = calculateUsage(currentVolume, history[monthCount - 1]);
     LOG_I("everblu_meter", "%s   Now  %10u  %9u (current month usage: %u L)",
-          headerPrefix, currentVolume, currentMonthUsage, currentMonthUsage);
+          headerPrefix, stats.currentVolume, stats.currentMonthUsage, stats.currentMonthUsage);
 
     LOG_I("everblu_meter", "===================================");
 }
@@ -246,3 +208,50 @@ uint32_t MeterHistory::calculateUsage(uint32_t current, uint32_t previous)
         return 0; // Meter reset or underflow
     }
 }
+
+HistoryModel::HistoryModel()
+    : m_history{}, m_stats{}, m_built(false), m_jsonDirty(false), m_jsonLength(0), m_renders(0), m_json{}
+{
+}
+
+bool HistoryModel::build(const uint32_t history[13], uint32_t currentVolume)
+{
+    uint32_t next[13] = {};
+    if (history)
+    {
+        memcpy(next, history, sizeof(next));
+    }
+
+    if (m_built && currentVolume == m_stats.currentVolume && memcmp(next, m_history, sizeof(next)) == 0)
+    {
+        return false;
+    }
+
+    memcpy(m_history, next, sizeof(m_history));
+    m_stats = MeterHistory::calculateStats(m_history, currentVolume);
+    m_built = true;
+    m_jsonDirty = true;
+    return true;
+}
+
+const char *HistoryModel::json()
+{
+    if (m_jsonDirty)
+    {
+        m_jsonLength = MeterHistory::writeHistoryJson(m_history, m_stats, m_json, sizeof(m_json));
+        m_jsonDirty = false;
+        m_renders++;
+    }
+    return m_json;
+}
+
+int HistoryModel::jsonLength()
+{
+    json();
+    return m_jsonLength;
+}
+
+void HistoryModel::printToSerial(const char *headerPrefix) const
+{
+    MeterHistory::printToSerial(m_history, m_stats, headerPrefix);
+}
@@ -67,11 +67,26 @@ public:
      * @param currentVolume Current meter reading
      * @param outputBuffer Buffer to write JSON to
      * @param bufferSize Size of output buffer
-     * @return Number of bytes written (including null terminator), or 0 if buffer too small
+     * @return Length of the JSON written (null terminator excluded), or 0 if there is no
+     *         history or the buffer is too small (the buffer is then left empty)
      */
     static int generateHistoryJson(const uint32_t history[13], uint32_t currentVolume,
                                    char *outputBuffer, int bufferSize);
 
+    /**
+     * @brief Render the history JSON from already calculated statistics
+     *
+     * Same output as generateHistoryJson(), without rescanning the history.
+     *
+     * @param history Array of 13 uint32_t values the statistics were calculated from
+     * @param stats Statistics from calculateStats()
+     * @param outputBuffer Buffer to write JSON to
+     * @param bufferSize Size of output buffer
+     * @return Length of the JSON written, or 0 (buffer left empty) as for generateHistoryJson()
+     */
+    static int writeHistoryJson(const uint32_t history[13], const HistoryStats &stats,
+                                char *outputBuffer, int bufferSize);
+
     /**
      * @brief Get string description of a history month (relative to current)
      *
@@ -96,6 +111,12 @@ public:
     static void printToSerial(const uint32_t history[13], uint32_t currentVolume,
                               const char *headerPrefix = "[HISTORY]");
 
+    /**
+     * @brief Print history from already calculated statistics
+     */
+    static void printToSerial(const uint32_t history[13], const HistoryStats &stats,
+                              const char *headerPrefix = "[HISTORY]");
+
     /**
      * @brief Validate history data
      *
@@ -124,4 +145,61 @@ private:
     MeterHistory() = delete;
 };
 
+/**
+ * @class HistoryModel
+ * @brief One frame's history, its statistics and its JSON, computed once
+ *
+ * build() copies the 13-month history and calculates the statistics in a
+ * single pass; the JSON is rendered on first use into an internal buffer and
+ * reused until a frame brings a different history or current volume. The MQTT
+ * and ESPHome publishers each keep one, so an unchanged history is neither
+ * rescanned per consumer nor rendered again on the next read.
+ */
+class HistoryModel
+{
+public:
+    /// Holds the largest document (13 ten-digit months and 12 ten-digit deltas)
+    static constexpr int JSON_BUFFER_SIZE = 512;
+
+    HistoryModel();
+
+    /**
+     * @brief Take a frame's history
+     *
+     * @param history Array of 13 uint32_t values, or nullptr when the frame has none
+     * @param currentVolume Current meter reading
+     * @return true if the history or current volume differs from the previous build
+     */
+    bool build(const uint32_t history[13], uint32_t currentVolume);
+
+    /// At least one valid month (countValidMonths() > 0)
+    bool isValid() const { return m_stats.monthCount > 0; }
+
+    const HistoryStats &getStats() const { return m_stats; }
+    const uint32_t *getHistory() const { return m_history; }
+
+    /**
+     * @brief JSON of the current history, rendered only if it changed since the last call
+     * @return The document, or an empty string if there is no valid history
+     */
+    const char *json();
+
+    /// Length of json(), rendering it if needed
+    int jsonLength();
+
+    /// Times the JSON was rendered (for diagnostics and tests)
+    unsigned long getRenderCount() const { return m_renders; }
+
+    void printToSerial(const char *headerPrefix = "[HISTORY]") const;
+
+private:
+    uint32_t m_history[13];
+    HistoryStats m_stats;
+    bool m_built;
+    bool m_jsonDirty;
+    int m_jsonLength;
+    unsigned long m_renders;
+    char m_json[JSON_BUFFER_SIZE];
+};
+
 #endif // METER_HISTORY_H
@@ -5,6 +5,7 @@
 
 #include "meter_reader.h"
 #include "meter_history.h"
+#include "read_timeline.h"
 
 // Conditional includes based on build environment
 #ifdef USE_ESPHOME
@@ -18,6 +19,7 @@
 #endif
 
 #include <Arduino.h>
+#include <limits.h>
 
 // Schedule check interval (milliseconds)
 static const unsigned long SCHEDULE_CHECK_INTERVAL_MS = 500;
@@ -25,8 +27,23 @@ static const unsigned long SCHEDULE_CHECK_INTERVAL_MS = 500;
 // Statistics publish interval (milliseconds) - 5 minutes
 static const unsigned long STATS_PUBLISH_INTERVAL_MS = 300000;
 
-// Retry delay (milliseconds) - 5 seconds between retry attempts
-static const unsigned long RETRY_DELAY_MS = 5000;
+// A scheduled read that was missed (blocked loop, cooldown) still fires if
+// the deadline is no older than this. Later than that the meter's wake window
+// has likely passed, so the read is skipped until the next scheduled day.
+static const time_t SCHEDULE_CATCH_UP_WINDOW_S = 60 * 60;
+
+// Margin kept between a read and the meter's predicted wake window edges
+static const int WINDOW_EDGE_GUARD_MIN = 2;
+
+// Values run through the publish filter (unchanged ones are only republished
+// on a full refresh)
+enum FilteredValue : uint8_t
+{
+    FILTERED_STATISTICS,
+    FILTERED_FREQUENCY_OFFSET,
+    FILTERED_TUNED_FREQUENCY,
+    FILTERED_HISTORY
+};
 
 // Produce a concise, MQTT-style summary of the latest reading for ESPHome logs
 static void logReadableSummary(const tmeter_data &data, const IConfigProvider *config)
@@ -49,7 +66,7 @@ static void logReadableSummary(const tmeter_data &data, const IConfigProvider *c
 }
 
 MeterReader::MeterReader(IConfigProvider *config, ITimeProvider *timeProvider, IDataPublisher *publisher)
-    : m_config(config), m_timeProvider(timeProvider), m_publisher(publisher), m_initialized(false), m_readingInProgress(false), m_isScheduledRead(false), m_haConnected(false), m_radioConnected(false), m_retryCount(0), m_lastFailedAttempt(0), m_nextRetryTime(0), m_autoScanAfterFailureDone(false), m_totalReadAttempts(0), m_successfulReads(0), m_failedReads(0), m_lastErrorMessage("None"), m_lastScheduleCheck(0), m_lastStatsPublish(0), m_readHourLocal(10), m_readMinuteLocal(0), m_lastReadDayMatch(false), m_lastReadTimeMatch(false)
+    : m_config(config), m_timeProvider(timeProvider), m_publisher(publisher), m_initialized(false), m_readingInProgress(false), m_isScheduledRead(false), m_haConnected(false), m_radioConnected(false), m_retryCount(0), m_nextRetryTime(0), m_autoScanAfterFailureDone(false), m_haveReading(false), m_lastReadingMs(0), m_cacheHits(0), m_coalescedTriggers(0), m_totalReadAttempts(0), m_successfulReads(0), m_failedReads(0), m_lastErrorMessage("None"), m_lastScheduleCheck(0), m_lastStatsPublish(0), m_readHourLocal(10), m_readMinuteLocal(0), m_nextScheduledReadUtc(0), m_lastScheduleEvalUtc(0), m_lastScheduledFireUtc(0), m_scheduleMask{0, 0}, m_scheduleDirty(true), m_alignedHourLocal(-1), m_slotStatsKey{}, m_sessionHourLocal(-1), m_sessionWeekday(0), m_meterWindowStart(-1), m_meterWindowEnd(-1)
 {
 }
 
@@ -107,6 +124,25 @@ void MeterReader::begin()
 
     float effectiveFrequency = frequency + FrequencyManager::getOffset();
 
+    // Read outcome histogram, one per meter so multi-meter setups learn separately
+    snprintf(m_slotStatsKey, sizeof(m_slotStatsKey), "read_slots_%02u_%lu",
+             (unsigned)m_config->getMeterYear(), (unsigned long)m_config->getMeterSerial());
+    if (m_slotStats.load(m_slotStatsKey))
+    {
+        LOG_I("everblu_meter", "Loaded read slot statistics");
+    }
+
+    // Seed the retry jitter per meter so meters sharing a node drift apart
+    m_retryPolicy.configure(m_config->getMaxRetries(), m_config->getRetryCooldownMs(),
+                            m_config->getMeterSerial() ^ ((uint32_t)m_config->getMeterYear() << 24));
+
+    // Scheduled sessions keep enough tokens for a full set of retries
+    m_readBudget.configure(constrain(m_config->getReadBudgetPerDay(), 0, 1440),
+                           constrain(m_config->getReadBudgetBurst(), 1, 100),
+                           constrain(m_config->getMaxRetries(), 0, 100));
+
+    m_publishFilter.configure(m_config->getPublishFullRefreshMs());
+
     bool radio_ok = cc1101_init(effectiveFrequency);
     m_radioConnected = radio_ok; // Store radio initialization status for republish checks
 
@@ -126,6 +162,12 @@ void MeterReader::begin()
     LOG_I("everblu_meter", "Scheduled reading time: %02d:%02d UTC (%02d:%02d local)",
           utcHour, utcMinute, m_readHourLocal, m_readMinuteLocal);
     LOG_I("everblu_meter", "Reading schedule: %s", m_config->getReadingSchedule());
+    if (!ScheduleManager::isValidSchedule(m_config->getReadingSchedule()))
+    {
+        LOG_W("everblu_meter", "Unknown reading_schedule '%s'; scheduled reads are disabled.",
+              m_config->getReadingSchedule());
+    }
+    m_scheduleDirty = true;
 
     m_initialized = true;
     LOG_I("everblu_meter", "Initialization complete");
@@ -199,7 +241,7 @@ void MeterReader::loop()
     if (m_retryCount > 0 && m_nextRetryTime > 0 && now >= m_nextRetryTime)
     {
         LOG_I("MeterReader", "Retry timer expired, attempting retry %d/%d",
-              m_retryCount + 1, m_config->getMaxRetries());
+              m_retryCount + 1, m_retryPolicy.getAttemptBudget());
         m_nextRetryTime = 0;
         performReading();
         return;
@@ -216,16 +258,41 @@ void MeterReader::loop()
         }
     }
 
-    // Publish statistics periodically
+    // Publish statistics periodically (only the ones that changed, unless a full refresh is due)
     if (now - m_lastStatsPublish >= STATS_PUBLISH_INTERVAL_MS)
     {
         m_lastStatsPublish = now;
-        if (m_publisher->isReady())
-        {
-            m_publisher->publishStatistics(m_totalReadAttempts, m_successfulReads, m_failedReads);
-            m_publisher->publishFrequencyOffset(FrequencyManager::getOffset());
-            m_publisher->publishTunedFrequency(FrequencyManager::getTunedFrequency());
-        }
+        publishRadioStatistics();
+    }
+}
+
+void MeterReader::publishRadioStatistics()
+{
+    if (!m_publisher->isReady())
+    {
+        return;
+    }
+
+    const unsigned long now = millis();
+    const unsigned long stats[3] = {m_totalReadAttempts, m_successfulReads, m_failedReads};
+    if (m_publishFilter.shouldPublish(FILTERED_STATISTICS, stats, sizeof(stats), now))
+    {
+        m_publisher->publishStatistics(m_totalReadAttempts, m_successfulReads, m_failedReads);
+        m_publishFilter.markPublished(FILTERED_STATISTICS, stats, sizeof(stats));
+    }
+
+    const float offset = FrequencyManager::getOffset();
+    if (m_publishFilter.shouldPublish(FILTERED_FREQUENCY_OFFSET, &offset, sizeof(offset), now))
+    {
+        m_publisher->publishFrequencyOffset(offset);
+        m_publishFilter.markPublished(FILTERED_FREQUENCY_OFFSET, &offset, sizeof(offset));
+    }
+
+    const float tuned = FrequencyManager::getTunedFrequency();
+    if (m_publishFilter.shouldPublish(FILTERED_TUNED_FREQUENCY, &tuned, sizeof(tuned), now))
+    {
+        m_publisher->publishTunedFrequency(tuned);
+        m_publishFilter.markPublished(FILTERED_TUNED_FREQUENCY, &tuned, sizeof(tuned));
     }
 }
 
@@ -246,49 +313,242 @@ bool MeterReader::shouldPerformScheduledRead()
     // Don't trigger if time not synchronized
     if (!m_timeProvider->isTimeSynced())
     {
+        m_scheduleDirty = true; // Reschedule from the synced clock once it returns
         return false;
     }
 
     // Check if in cooldown period after failures
-    if (m_lastFailedAttempt > 0)
+    if (m_retryPolicy.isCoolingDown(millis()))
+    {
+        return false;
+    }
+
+    const time_t nowUtc = m_timeProvider->getCurrentTime();
+
+    // Recompute only when the configuration or the clock changed. Forward
+    // steps need no special handling: they look like a blocked loop and go
+    // through the catch-up check below.
+    if (m_scheduleDirty || nowUtc < m_lastScheduleEvalUtc)
     {
-        unsigned long cooldown = m_config->getRetryCooldownMs();
-        if (millis() - m_lastFailedAttempt < cooldown)
+        time_t fromUtc = nowUtc;
+        // After a small backwards correction don't fire the same deadline twice
+        if (m_lastScheduledFireUtc > nowUtc && m_lastScheduledFireUtc - nowUtc < 24 * 60 * 60)
         {
-            return false;
+            fromUtc = m_lastScheduledFireUtc + 1;
         }
-        // Cooldown expired, reset
-        m_lastFailedAttempt = 0;
+        updateNextScheduledRead(fromUtc);
     }
+    m_lastScheduleEvalUtc = nowUtc;
 
-    // Get current local time
-    time_t localTime = m_timeProvider->getLocalTime(m_config->getTimezoneOffsetMinutes());
-    struct tm *ptm = gmtime(&localTime);
-    if (!ptm)
+    if (m_nextScheduledReadUtc == 0 || nowUtc < m_nextScheduledReadUtc)
     {
         return false;
     }
 
-    // Check if today is a valid reading day
-    bool isDayMatch = isReadingDayForConfiguredSchedule(ptm);
-    bool isTimeMatch = (ptm->tm_hour == m_readHourLocal && ptm->tm_min == m_readMinuteLocal);
-    bool isSecondMatch = (ptm->tm_sec == 0);
+    // Deadline reached: arm the following occurrence before deciding on this one
+    const time_t dueUtc = m_nextScheduledReadUtc;
+    m_lastScheduledFireUtc = dueUtc;
+    updateNextScheduledRead(nowUtc + 1);
+
+    if (nowUtc - dueUtc > SCHEDULE_CATCH_UP_WINDOW_S)
+    {
+        LOG_W("everblu_meter", "Scheduled read missed by %ld s (outside catch-up window), skipping",
+              (long)(nowUtc - dueUtc));
+        return false;
+    }
+
+    if (nowUtc - dueUtc > 1)
+    {
+        LOG_I("everblu_meter", "Catching up scheduled read %ld s late", (long)(nowUtc - dueUtc));
+    }
+
+    return true;
+}
+
+void MeterReader::updateNextScheduledRead(time_t fromUtc)
+{
+    if (m_scheduleDirty)
+    {
+        // Compile the schedule once per configuration change; an unknown
+        // schedule leaves an empty mask, which never fires
+        ScheduleManager::compileSchedule(m_config->getReadingSchedule(), m_scheduleMask);
+        m_scheduleDirty = false;
+    }
+
+    int hourUtc;
+    int minuteUtc;
+    getEffectiveReadTimeUtc(hourUtc, minuteUtc);
+    m_nextScheduledReadUtc = ScheduleManager::computeNextFireUtc(
+        fromUtc, m_scheduleMask, hourUtc, minuteUtc, m_config->getTimezoneOffsetMinutes());
+
+    if (m_nextScheduledReadUtc > 0)
+    {
+        char nextBuf[24];
+        time_t nextLocal = m_nextScheduledReadUtc + (time_t)m_config->getTimezoneOffsetMinutes() * 60;
+        strftime(nextBuf, sizeof(nextBuf), "%a %Y-%m-%d %H:%M", gmtime(&nextLocal));
+        LOG_D("everblu_meter", "Next scheduled read: %s local", nextBuf);
+    }
+}
+
+void MeterReader::getEffectiveReadTimeUtc(int &hourUtc, int &minuteUtc) const
+{
+    hourUtc = m_config->getReadHourUTC();
+    minuteUtc = m_config->getReadMinuteUTC();
+    if (m_alignedHourLocal < 0)
+    {
+        return;
+    }
+
+    // Keep the configured minute, move the hour (local-offset) to the aligned slot
+    const int offsetMinutes = m_config->getTimezoneOffsetMinutes();
+    int localMin = ((hourUtc * 60 + minuteUtc + offsetMinutes) % 1440 + 1440) % 1440;
+    localMin = m_alignedHourLocal * 60 + localMin % 60;
+
+    // Stay clear of the window edges where the meter's own clock puts them
+    if (m_meterWindowStart >= 0 && m_meterClock.isValid())
+    {
+        const int shift = m_meterClock.getShiftMinutes(m_timeProvider->getCurrentTime(), offsetMinutes);
+        localMin = MeterClockTracker::guardReadMinute(localMin, m_meterWindowStart, m_meterWindowEnd, shift,
+                                                      WINDOW_EDGE_GUARD_MIN);
+    }
+    const int utcMin = ((localMin - offsetMinutes) % 1440 + 1440) % 1440;
+    hourUtc = utcMin / 60;
+    minuteUtc = utcMin % 60;
+}
+
+void MeterReader::recordReadSession(int attempts, bool success)
+{
+    if (m_sessionHourLocal < 0)
+    {
+        return; // Started without a synced clock, so the slot is unknown
+    }
+
+    m_slotStats.recordSession(m_sessionHourLocal, m_sessionWeekday, attempts, success);
+    m_slotStats.save(m_slotStatsKey);
+
+    LOG_D("everblu_meter", "Read slot %02d:00 local: %d%% first-attempt over %u sessions",
+          m_sessionHourLocal, m_slotStats.getFirstAttemptPercent(m_sessionHourLocal),
+          (unsigned)m_slotStats.getSessions(m_sessionHourLocal));
+
+    // Some meters sleep through part of the week; say so rather than silently retrying
+    if (m_slotStats.getWeekdaySessions(m_sessionWeekday) >= 4 &&
+        m_slotStats.getWeekdayFirstAttemptPercent(m_sessionWeekday) == 0)
+    {
+        static const char *const DAY_NAMES[] = {"Sunday", "Monday", "Tuesday", "Wednesday",
+                                                "Thursday", "Friday", "Saturday"};
+        LOG_W("everblu_meter", "Meter has not answered first time on a %s in the last %u reads; "
+                               "consider a reading_schedule that skips it",
+              DAY_NAMES[m_sessionWeekday], (unsigned)m_slotStats.getWeekdaySessions(m_sessionWeekday));
+    }
+
+    m_sessionHourLocal = -1;
+}
+
+void MeterReader::trackMeterClock(const tmeter_data &data, time_t utc)
+{
+    if (data.meter_clock_epoch == 0)
+    {
+        return;
+    }
+
+    if (!m_meterClock.addSample((time_t)data.meter_clock_epoch, utc))
+    {
+        LOG_W("everblu_meter", "Meter clock stepped (now %+ld s from UTC), drift estimate restarted",
+              (long)m_meterClock.getOffsetSeconds(utc));
+    }
+    else if (m_meterClock.hasDrift())
+    {
+        LOG_I("everblu_meter", "Meter clock offset %+ld s from UTC, drift %+.1f ppm",
+              (long)m_meterClock.getOffsetSeconds(utc), m_meterClock.getDriftPpm());
+    }
+    else
+    {
+        LOG_I("everblu_meter", "Meter clock offset %+ld s from UTC", (long)m_meterClock.getOffsetSeconds(utc));
+    }
+}
+
+void MeterReader::alignReadTimeToMeterWindow(int timeStart, int timeEnd)
+{
+    const int offsetMinutes = m_config->getTimezoneOffsetMinutes();
+
+    // The window is in the meter's time base; move it onto our local-offset
+    // hours (e.g. a meter left on UTC in a UTC+1 zone opens an hour later)
+    int shiftHours = 0;
+    if (m_meterClock.isValid())
+    {
+        const int shift = m_meterClock.getShiftMinutes(m_timeProvider->getCurrentTime(), offsetMinutes);
+        shiftHours = (shift >= 0) ? (shift + 30) / 60 : -((-shift + 30) / 60);
+    }
+    const int start = ((constrain(timeStart, 0, 23) - shiftHours) % 24 + 24) % 24;
+    const int end = ((constrain(timeEnd, 0, 23) - shiftHours) % 24 + 24) % 24;
+    const int window = (end - start + 24) % 24;
+    if (window == 0)
+    {
+        return; // Unknown or all-day window, keep the configured time
+    }
+
+    // Reading time as currently scheduled, before this read's window is applied
+    int hourUtc;
+    int minuteUtc;
+    getEffectiveReadTimeUtc(hourUtc, minuteUtc);
+    const int previousUtcMin = hourUtc * 60 + minuteUtc;
+    const int currentHourLocal = (m_alignedHourLocal >= 0)
+                                     ? m_alignedHourLocal
+                                     : (((m_config->getReadHourUTC() * 60 + m_config->getReadMinuteUTC() + offsetMinutes) % 1440 + 1440) % 1440) / 60;
 
-    // Trigger only on the first match (edge detection)
-    bool shouldTrigger = isDayMatch && isTimeMatch && isSecondMatch &&
-                         (!m_lastReadDayMatch || !m_lastReadTimeMatch);
+    const int anchor = m_config->useAutoAlignMidpoint() ? (start + window / 2) % 24 : start;
+    const int chosen = m_slotStats.chooseHour(start, end, anchor, currentHourLocal);
+    if (chosen < 0)
+    {
+        return;
+    }
+    m_meterWindowStart = constrain(timeStart, 0, 23);
+    m_meterWindowEnd = constrain(timeEnd, 0, 23);
+    m_alignedHourLocal = chosen;
+    getEffectiveReadTimeUtc(hourUtc, minuteUtc);
+    if (hourUtc * 60 + minuteUtc == previousUtcMin)
+    {
+        return;
+    }
 
-    m_lastReadDayMatch = isDayMatch && isTimeMatch;
-    m_lastReadTimeMatch = isTimeMatch;
+    LOG_I("everblu_meter", "Auto-aligned reading time to %02d:%02d UTC (hour %02d local, %d%% first-attempt, "
+                           "meter window %02d-%02d local)",
+          hourUtc, minuteUtc, chosen, m_slotStats.getFirstAttemptPercent(chosen), start, end);
 
-    return shouldTrigger;
+    // Today's read is done: the new slot starts tomorrow
+    if (m_scheduleDirty)
+    {
+        ScheduleManager::compileSchedule(m_config->getReadingSchedule(), m_scheduleMask);
+        m_scheduleDirty = false;
+    }
+    updateNextScheduledRead(ScheduleManager::startOfNextLocalDayUtc(m_timeProvider->getCurrentTime(), offsetMinutes));
+
+    char utc_time_buf[8];
+    snprintf(utc_time_buf, sizeof(utc_time_buf), "%02d:%02d", hourUtc, minuteUtc);
+    m_publisher->publishMeterSettings(m_config->getMeterYear(), m_config->getMeterSerial(),
+                                      m_config->getReadingSchedule(), utc_time_buf, m_config->getFrequency());
 }
 
-void MeterReader::triggerReading(bool isScheduled)
+void MeterReader::triggerReading(bool isScheduled, bool force)
 {
     if (m_readingInProgress)
     {
-        LOG_W("everblu_meter", "Reading already in progress, skipping trigger");
+        // Coalesce: the read in flight publishes the result this trigger wants
+        m_coalescedTriggers++;
+        LOG_I("everblu_meter", "Reading already in progress, trigger joins it");
+        return;
+    }
+
+    const unsigned long maxAgeMs = m_config->getReadCacheMaxAgeMs();
+    if (!isScheduled && !force && maxAgeMs > 0 && m_haveReading && millis() - m_lastReadingMs < maxAgeMs)
+    {
+        m_cacheHits++;
+        const unsigned long ageSec = (millis() - m_lastReadingMs) / 1000;
+        LOG_I("everblu_meter", "Last reading is %lu s old (limit %lu s), not waking the meter", ageSec,
+              maxAgeMs / 1000);
+        char status[64];
+        snprintf(status, sizeof(status), "Reading is fresh (%lus old), not re-read", ageSec);
+        m_publisher->publishStatusMessage(status);
         return;
     }
 
@@ -297,6 +557,16 @@ void MeterReader::triggerReading(bool isScheduled)
 
     LOG_I("everblu_meter", "Triggering %s reading...", isScheduled ? "scheduled" : "manual");
 
+    // Remember the slot this session runs in for the read slot statistics
+    m_sessionHourLocal = -1;
+    if (m_timeProvider->isTimeSynced())
+    {
+        time_t local = m_timeProvider->getCurrentTime() + (time_t)m_config->getTimezoneOffsetMinutes() * 60;
+        struct tm *ptm = gmtime(&local);
+        m_sessionHourLocal = ptm->tm_hour;
+        m_sessionWeekday = ptm->tm_wday;
+    }
+
     performReading();
 }
 
@@ -311,6 +581,15 @@ void MeterReader::performReading()
         return;
     }
 
+    // Every attempt, retries included, is paid for from the read budget
+    const ReadBudget::Priority priority =
+        m_isScheduledRead ? ReadBudget::Priority::Scheduled : ReadBudget::Priority::Manual;
+    if (!m_readBudget.tryConsume(1, priority, millis()))
+    {
+        abortSessionForBudget();
+        return;
+    }
+
     // Publish status
     m_publisher->publishActiveReading(true);
     m_publisher->publishRadioState("Reading");
@@ -323,15 +602,18 @@ void MeterReader::performReading()
     float currentOffset = FrequencyManager::getOffset();
 
     LOG_I("everblu_meter", "Reading attempt %lu (retry %d/%d) at %.6f MHz (offset: %.3f kHz)",
-          m_totalReadAttempts, m_retryCount, m_config->getMaxRetries(),
+          m_totalReadAttempts, m_retryCount, m_retryPolicy.getAttemptBudget(),
           currentFreq, currentOffset * 1000.0);
 
     // Perform actual meter read
+    m_diagnostics.snapshotBeforeRead();
     struct tmeter_data meter_data = meterReadCallback();
+    m_diagnostics.snapshotAfterRead();
 
     // Validate data
     if (meter_data.reads_counter == 0 || meter_data.volume == 0)
     {
+        cc1101_get_read_timeline().commit(false);
         handleFailedRead();
         return;
     }
@@ -344,7 +626,14 @@ void MeterReader::handleSuccessfulRead(const tmeter_data &data)
 {
     LOG_I("everblu_meter", "Read successful!");
 
-    // Reset retry state
+    recordReadSession(m_retryCount + 1, true);
+
+    // Reset retry state and the failure streak
+    if (m_retryPolicy.isMeterUnresponsive())
+    {
+        LOG_I("everblu_meter", "Meter answered again after %u failed sessions", (unsigned)m_retryPolicy.getFailedStreak());
+    }
+    m_retryPolicy.onSuccess();
     resetRetryState();
 
     // Allow a fresh failure-recovery frequency scan on the next failure streak
@@ -353,6 +642,8 @@ void MeterReader::handleSuccessfulRead(const tmeter_data &data)
     // Update statistics
     m_successfulReads++;
     m_lastErrorMessage = "None";
+    m_haveReading = true;
+    m_lastReadingMs = millis();
 
     // Perform adaptive frequency tracking based on FREQEST register
     FrequencyManager::adaptiveFrequencyTracking(data.freqest);
@@ -362,23 +653,46 @@ void MeterReader::handleSuccessfulRead(const tmeter_data &data)
     time_t now = m_timeProvider->getCurrentTime();
     strftime(iso8601, sizeof(iso8601), "%FT%TZ", gmtime(&now));
 
+    if (m_timeProvider->isTimeSynced())
+    {
+        trackMeterClock(data, now);
+    }
+
     // Emit a concise, MQTT-style summary into the ESPHome log
     logReadableSummary(data, m_config);
-
-    // Publish meter data
-    m_publisher->publishMeterReading(data, iso8601);
-
-    // Publish historical data if available
+    ReadTimeline &timeline = cc1101_get_read_timeline();
+    timeline.skip(micros()); // The log summary is not part of the read
+
+    // Publish the reading, history, statistics and frequency state in one call.
+    // History only changes once a month and the frequency only on a correction.
+    const unsigned long nowMs = millis();
+    const unsigned long stats[3] = {m_totalReadAttempts, m_successfulReads, m_failedReads};
+    const float offset = FrequencyManager::getOffset();
+    const float tuned = FrequencyManager::getTunedFrequency();
+    // The history JSON carries current_month_usage, derived from the volume
+    const uint32_t historyHash = PublishFilter::hash(&data.volume, sizeof(data.volume),
+                                                     PublishFilter::hash(data.history, sizeof(data.history)));
+    const bool historyChanged = data.history_available &&
+                                m_publishFilter.shouldPublish(FILTERED_HISTORY, &historyHash, sizeof(historyHash), nowMs);
+    const bool offsetChanged = m_publishFilter.shouldPublish(FILTERED_FREQUENCY_OFFSET, &offset, sizeof(offset), nowMs);
+    const bool tunedChanged = m_publishFilter.shouldPublish(FILTERED_TUNED_FREQUENCY, &tuned, sizeof(tuned), nowMs);
+
+    const ReadingSnapshot snapshot = {data, iso8601,
+                                      m_totalReadAttempts, m_successfulReads, m_failedReads,
+                                      offset, tuned,
+                                      historyChanged, offsetChanged || tunedChanged};
+    m_publisher->publishSnapshot(snapshot);
+    timeline.mark(ReadPhase::Publish, micros());
+    timeline.commit(true);
+
+    m_publishFilter.markPublished(FILTERED_STATISTICS, stats, sizeof(stats));
+    m_publishFilter.markPublished(FILTERED_FREQUENCY_OFFSET, &offset, sizeof(offset));
+    m_publishFilter.markPublished(FILTERED_TUNED_FREQUENCY, &tuned, sizeof(tuned));
     if (data.history_available)
     {
-        m_publisher->publishHistory(data.history, true);
+        m_publishFilter.markPublished(FILTERED_HISTORY, &historyHash, sizeof(historyHash));
     }
 
-    // Publish updated statistics
-    m_publisher->publishStatistics(m_totalReadAttempts, m_successfulReads, m_failedReads);
-    m_publisher->publishFrequencyOffset(FrequencyManager::getOffset());
-    m_publisher->publishTunedFrequency(FrequencyManager::getTunedFrequency());
-
     // Update status
     m_publisher->publishActiveReading(false);
     m_publisher->publishRadioState("Idle");
@@ -386,15 +700,32 @@ void MeterReader::handleSuccessfulRead(const tmeter_data &data)
 
     m_readingInProgress = false;
 
+    // Move scheduled reads towards the slot where the meter answers first time
+    if (m_isScheduledRead && m_config->isAutoAlignReadingTime())
+    {
+        alignReadTimeToMeterWindow(data.time_start, data.time_end);
+    }
+    else if (!m_config->isAutoAlignReadingTime())
+    {
+        // Still needed to skip retries while the meter is asleep
+        m_meterWindowStart = constrain(data.time_start, 0, 23);
+        m_meterWindowEnd = constrain(data.time_end, 0, 23);
+    }
+
     LOG_I("everblu_meter", "Data published successfully");
 }
 
 void MeterReader::handleFailedRead()
 {
-    LOG_W("everblu_meter", "Read failed (attempt %d/%d)",
-          m_retryCount + 1, m_config->getMaxRetries());
+    const unsigned long now = millis();
+    const int budget = m_retryPolicy.getAttemptBudget();
+    LOG_W("everblu_meter", "Read failed (attempt %d/%d)", m_retryCount + 1, budget);
 
-    if (m_retryCount < m_config->getMaxRetries() - 1)
+    // Don't burn radio time and meter battery on attempts that cannot succeed
+    const bool windowClosed = isMeterWindowClosed();
+    const unsigned long retryDelay = m_retryPolicy.onAttemptFailed(m_retryCount + 1, windowClosed, now);
+
+    if (retryDelay > 0)
     {
         // Schedule retry after delay.
         // Keep the "Active Reading" sensor true and the radio state as "Reading"
@@ -404,34 +735,52 @@ void MeterReader::handleFailedRead()
         // retry timer in loop() calls performReading() directly, bypassing the
         // m_readingInProgress guard).
         m_retryCount++;
-        m_nextRetryTime = millis() + RETRY_DELAY_MS;
+        m_nextRetryTime = now + retryDelay;
         m_lastErrorMessage = "No meter response (asleep/out of range/wrong Year/Serial) - retrying";
 
         m_publisher->publishStatusMessage("Retry scheduled");
         m_publisher->publishError(m_lastErrorMessage);
 
-        LOG_I("everblu_meter", "Retry %d/%d scheduled in %lu seconds",
-              m_retryCount + 1, m_config->getMaxRetries(), RETRY_DELAY_MS / 1000);
+        LOG_I("everblu_meter", "Retry %d/%d scheduled in %lu ms",
+              m_retryCount + 1, budget, retryDelay);
     }
     else
     {
+        if (windowClosed && m_retryCount + 1 < budget)
+        {
+            LOG_W("everblu_meter", "Meter wake window (%02d-%02d meter time) is closed, skipping remaining retries",
+                  m_meterWindowStart, m_meterWindowEnd);
+        }
+        else if (m_retryPolicy.isMeterUnresponsive())
+        {
+            LOG_W("everblu_meter", "Meter unresponsive for %u sessions, probing with %d attempt(s) per session",
+                  (unsigned)m_retryPolicy.getFailedStreak(), (int)RetryPolicy::UNRESPONSIVE_ATTEMPTS);
+        }
+
         // Max retries reached
+        recordReadSession(m_retryCount + 1, false);
         m_failedReads++;
-        m_lastFailedAttempt = millis();
         m_lastErrorMessage = "No meter response after max retries - check distance and meter Year/Serial";
 
         m_publisher->publishError(m_lastErrorMessage);
         m_publisher->publishStatusMessage("Failed after max retries");
-        m_publisher->publishStatistics(m_totalReadAttempts, m_successfulReads, m_failedReads);
-        m_publisher->publishFrequencyOffset(FrequencyManager::getOffset());
+        publishRadioStatistics();
         m_publisher->publishActiveReading(false);
         m_publisher->publishRadioState("Idle");
 
         resetRetryState();
         m_readingInProgress = false;
 
-        unsigned long cooldownSec = m_config->getRetryCooldownMs() / 1000;
-        LOG_W("everblu_meter", "Entering cooldown period (%lu seconds)", cooldownSec);
+        // A failed slot counts against its hour too; move on from it using the
+        // wake window reported by the last successful read
+        if (m_isScheduledRead && m_config->isAutoAlignReadingTime() && m_meterWindowStart >= 0)
+        {
+            alignReadTimeToMeterWindow(m_meterWindowStart, m_meterWindowEnd);
+        }
+
+        unsigned long cooldownSec = m_retryPolicy.getCooldownMs() / 1000;
+        LOG_W("everblu_meter", "Entering cooldown period (%lu seconds, %u failed session(s) in a row)", cooldownSec,
+              (unsigned)m_retryPolicy.getFailedStreak());
 
         // When the meter cannot be reached after all retries, a drifted carrier
         // frequency (crystal offset) is a common cause. Automatically run a
@@ -441,6 +790,11 @@ void MeterReader::handleFailedRead()
         // when the meter is genuinely unreachable (e.g. dead battery).
         if (m_config->isAutoScanOnFailureEnabled() && !m_autoScanAfterFailureDone)
         {
+            if (!m_readBudget.tryConsume(ReadBudget::SCAN_COST, ReadBudget::Priority::Manual, millis()))
+            {
+                LOG_W("everblu_meter", "Read budget too low for the automatic frequency scan, skipping it");
+                return;
+            }
             m_autoScanAfterFailureDone = true;
             LOG_W("everblu_meter", "Running automatic frequency scan to check for meter offset drift... (disable with auto_scan_on_failure / AUTO_SCAN_ON_FAILURE_ENABLED)");
             m_publisher->publishStatusMessage("Auto frequency scan after failed reads");
@@ -452,6 +806,43 @@ void MeterReader::handleFailedRead()
     }
 }
 
+bool MeterReader::isMeterWindowClosed() const
+{
+    if (m_meterWindowStart < 0 || !m_timeProvider->isTimeSynced())
+    {
+        return false;
+    }
+    return m_meterClock.isWindowClosed(m_timeProvider->getCurrentTime(), m_meterWindowStart, m_meterWindowEnd);
+}
+
+void MeterReader::abortSessionForBudget()
+{
+    const unsigned long now = millis();
+    LOG_W("everblu_meter", "Read budget exhausted (%u/%u tokens, next in %lu s), %s read not sent",
+          (unsigned)m_readBudget.getTokens(now), (unsigned)m_readBudget.getBurst(),
+          m_readBudget.getMsUntilNextToken(now) / 1000, m_isScheduledRead ? "scheduled" : "manual");
+
+    const bool midSession = m_retryCount > 0;
+    resetRetryState();
+    m_retryPolicy.cancel();
+    m_readingInProgress = false;
+    m_sessionHourLocal = -1; // An unfinished session says nothing about the slot
+
+    m_lastErrorMessage = "Read budget exhausted - protecting meter battery";
+    m_publisher->publishError(m_lastErrorMessage);
+    m_publisher->publishStatusMessage("Read budget exhausted");
+    if (midSession)
+    {
+        m_publisher->publishActiveReading(false);
+        m_publisher->publishRadioState("Idle");
+    }
+}
+
+unsigned long MeterReader::getLastReadingAgeMs() const
+{
+    return m_haveReading ? millis() - m_lastReadingMs : ULONG_MAX;
+}
+
 void MeterReader::resetRetryState()
 {
     m_retryCount = 0;
@@ -466,7 +857,9 @@ void MeterReader::stopReading()
     const bool wasActive = m_readingInProgress || m_retryCount > 0 || m_nextRetryTime > 0;
 
     resetRetryState();
+    m_retryPolicy.cancel();
     m_readingInProgress = false;
+    m_sessionHourLocal = -1; // An interrupted session says nothing about the slot
 
     // Also ask any in-progress deep frequency scan to bail at its next step
     // boundary (it cannot be interrupted within a single blocking step).
@@ -489,6 +882,14 @@ void MeterReader::performFrequencyScan()
 {
     activateCallbackContext();
 
+    if (!m_readBudget.tryConsume(ReadBudget::SCAN_COST, ReadBudget::Priority::Manual, millis()))
+    {
+        LOG_W("everblu_meter", "Read budget too low for a frequency scan (%u tokens, needs %u plus the scheduled reserve)",
+              (unsigned)m_readBudget.getTokens(millis()), (unsigned)ReadBudget::SCAN_COST);
+        m_publisher->publishStatusMessage("Read budget exhausted");
+        return;
+    }
+
     LOG_I("everblu_meter", "Starting frequency scan...");
 
     FrequencyManager::performDeepFrequencyScan();
@@ -545,55 +946,10 @@ void MeterReader::getStatistics(unsigned long &totalAttempts, unsigned long &suc
 
 void MeterReader::setHAConnected(bool connected)
 {
-    m_haConnected = connected;
-}
-
-bool MeterReader::isReadingDayForConfiguredSchedule(const struct tm *ptm) const
-{
-    if (ptm == nullptr)
-    {
-        return false;
-    }
-
-    const char *schedule = m_config->getReadingSchedule();
-    if (schedule == nullptr)
+    if (connected && !m_haConnected)
     {
-        schedule = "Monday-Friday";
+        // Home Assistant may have lost the values suppressed while it was away
+        m_publishFilter.forceRefresh();
     }
-
-    const int dayOfWeek = ptm->tm_wday; // 0=Sunday, 1=Monday, ... 6=Saturday
-    if (strcmp(schedule, "Monday-Friday") == 0)
-    {
-        return dayOfWeek >= 1 && dayOfWeek <= 5;
-    }
-    if (strcmp(schedule, "Monday-Saturday") == 0)
-    {
-        return dayOfWeek >= 1 && dayOfWeek <= 6;
-    }
-    if (strcmp(schedule, "Monday-Sunday") == 0)
-    {
-        return true;
-    }
-    // check for single day reading schedule
-    switch(dayOfWeek)
-    {
-        case 0:
-            return strcmp(schedule, "Sunday") == 0;
-        case 1:
-            return strcmp(schedule, "Monday") == 0;
-        case 2:
-            return strcmp(schedule, "Tuesday") == 0;
-        case 3:
-            return strcmp(schedule, "Wednesday") == 0;
-        case 4:
-            return strcmp(schedule, "Thursday") == 0;
-        case 5:
-            return strcmp(schedule, "Friday") == 0;
-        case 6:
-            return strcmp(schedule, "Saturday") == 0;
-    }
-
-    // Unknown schedule: log warning and skip read to avoid misconfiguration
-    LOG_W("everblu_meter", "Unknown reading_schedule '%s'; skipping scheduled read.", schedule);
-    return false;
+    m_haConnected = connected;
 }
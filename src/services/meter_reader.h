@@ -45,6 +45,13 @@
 #endif
 #include "../core/cc1101.h"
 #include "frequency_manager.h"
+#include "schedule_manager.h"
+#include "read_slot_stats.h"
+#include "meter_clock_tracker.h"
+#include "retry_policy.h"
+#include "read_budget.h"
+#include "publish_filter.h"
+#include "runtime_diagnostics.h"
 
 /**
  * @class MeterReader
@@ -88,9 +95,16 @@ public:
 
     /**
      * @brief Trigger a manual meter reading
+     *
+     * A manual trigger within getReadCacheMaxAgeMs() of the last successful
+     * read keeps that reading (already published) instead of waking the meter,
+     * which would cost meter battery and bump its reads counter. A trigger
+     * while a read is in flight joins that read.
+     *
      * @param isScheduled true if triggered by schedule, false if manual
+     * @param force true to read the meter even if the last reading is fresh
      */
-    void triggerReading(bool isScheduled);
+    void triggerReading(bool isScheduled, bool force = false);
 
     /**
      * @brief Perform a Deep frequency scan (window-map + zoom) to recalibrate the carrier offset
@@ -126,6 +140,23 @@ public:
      */
     bool isReadingInProgress() const { return m_readingInProgress; }
 
+    /**
+     * @brief Get the age of the last successful reading
+     * @return Milliseconds since it was read, or ULONG_MAX if there is none
+     */
+    unsigned long getLastReadingAgeMs() const;
+
+    /**
+     * @brief Get the number of manual triggers answered without a radio read
+     * @param cacheHits Output: triggers served by a fresh last reading
+     * @param coalesced Output: triggers that joined a read already in flight
+     */
+    void getTriggerSavings(unsigned long &cacheHits, unsigned long &coalesced) const
+    {
+        cacheHits = m_cacheHits;
+        coalesced = m_coalescedTriggers;
+    }
+
     /**
      * @brief Check if CC1101 radio initialized successfully
      * @return true if radio is connected and initialized
@@ -144,6 +175,64 @@ public:
      */
     void setHAConnected(bool connected);
 
+    /**
+     * @brief Publish every filtered value on its next update, changed or not
+     *
+     * Call when the consumer reconnects. setHAConnected() does this itself.
+     */
+    void requestFullRefresh() { m_publishFilter.forceRefresh(); }
+
+    /**
+     * @brief Force the next scheduled read time to be recomputed
+     *
+     * Call after changing the reading schedule, reading time or timezone
+     * offset at runtime. Clock jumps and time sync changes are detected
+     * automatically.
+     */
+    void invalidateSchedule() { m_scheduleDirty = true; }
+
+    /**
+     * @brief Get the next scheduled read time
+     * @return UTC epoch of the next scheduled read, or 0 if not yet computed
+     */
+    time_t getNextScheduledReadUtc() const { return m_nextScheduledReadUtc; }
+
+    /**
+     * @brief Get the read outcome histogram used by auto-align
+     * @return Histogram of read sessions by local hour and weekday
+     */
+    const ReadSlotStats &getReadSlotStats() const { return m_slotStats; }
+
+    /**
+     * @brief Get the meter clock offset and drift estimate
+     * @return Tracker fed from the meter clock of each successful read
+     */
+    const MeterClockTracker &getMeterClock() const { return m_meterClock; }
+
+    /**
+     * @brief Get the retry policy state and counters
+     * @return Policy deciding retry delays, attempt budget and cooldown
+     */
+    const RetryPolicy &getRetryPolicy() const { return m_retryPolicy; }
+
+    /**
+     * @brief Get the read budget (remaining tokens and denied requests)
+     * @return Token bucket charged for every read attempt and scan
+     */
+    ReadBudget &getReadBudget() { return m_readBudget; }
+
+    /**
+     * @brief Get the change-only publish filter (published/suppressed counters)
+     * @return Filter for statistics, frequency and history publishes
+     */
+    const PublishFilter &getPublishFilter() const { return m_publishFilter; }
+
+    /**
+     * @brief Get the heap, stack and loop-block telemetry
+     * @return Diagnostics snapshotted around every read; the host feeds loop blocks
+     */
+    RuntimeDiagnostics &getDiagnostics() { return m_diagnostics; }
+
 private:
     static MeterReader *s_active_reader;
 
@@ -151,7 +240,41 @@ private:
     static tmeter_data meterReadCallback();
 
     void activateCallbackContext();
-    bool isReadingDayForConfiguredSchedule(const struct tm *ptm) const;
+
+    /**
+     * @brief Recompute the cached next scheduled read time
+     * @param fromUtc Earliest acceptable fire time (UTC epoch)
+     */
+    void updateNextScheduledRead(time_t fromUtc);
+
+    /**
+     * @brief Get the effective reading time in UTC
+     *
+     * The configured time, or the auto-aligned hour once alignment has run,
+     * kept clear of the wake window edges as predicted from the meter clock.
+     */
+    void getEffectiveReadTimeUtc(int &hourUtc, int &minuteUtc) const;
+
+    /**
+     * @brief Record the finished read session in the slot histogram
+     * @param attempts Attempts made in this session
+     * @param success true if the session produced a valid reading
+     */
+    void recordReadSession(int attempts, bool success);
+
+    /**
+     * @brief Move the reading hour to the best slot in the meter's wake window
+     * @param timeStart Wake window start hour reported by the meter
+     * @param timeEnd Wake window end hour reported by the meter
+     */
+    void alignReadTimeToMeterWindow(int timeStart, int timeEnd);
+
+    /**
+     * @brief Feed the meter clock of a successful read into the drift tracker
+     * @param data Meter data with meter_clock_epoch
+     * @param utc NTP time the read completed
+     */
+    void trackMeterClock(const tmeter_data &data, time_t utc);
 
     /**
      * @brief Perform actual meter reading operation
@@ -166,6 +289,11 @@ private:
 
     /**
      * @brief Check if it's time for a scheduled reading
+     *
+     * Compares the current epoch against the precomputed next fire time. A
+     * deadline missed because the loop was blocked still fires, as long as
+     * it is no older than the catch-up window.
+     *
      * @return true if schedule conditions are met
      */
     bool shouldPerformScheduledRead();
@@ -176,13 +304,32 @@ private:
      */
     void handleSuccessfulRead(const tmeter_data &data);
 
+    /**
+     * @brief Publish read statistics, frequency offset and tuned frequency that changed
+     *
+     * Unchanged values are skipped until the publish filter's next full refresh.
+     */
+    void publishRadioStatistics();
+
     /**
      * @brief Handle failed reading attempt
      */
     void handleFailedRead();
 
     /**
-     * @brief Reset retry counter and cooldown
+     * @brief Check if the meter's wake window is known to be closed now
+     */
+    bool isMeterWindowClosed() const;
+
+    /**
+     * @brief End the session because the read budget refused an attempt
+     *
+     * Not counted as a failed read: the meter was never asked.
+     */
+    void abortSessionForBudget();
+
+    /**
+     * @brief Reset the retry counter and pending retry
      */
     void resetRetryState();
 
@@ -200,9 +347,18 @@ private:
 
     // Retry management
     int m_retryCount;
-    unsigned long m_lastFailedAttempt;
     unsigned long m_nextRetryTime;
-    bool m_autoScanAfterFailureDone; // Guards the failure-recovery frequency scan to once per failure streak
+    RetryPolicy m_retryPolicy;        // Backoff, attempt budget and cooldown
+    ReadBudget m_readBudget;          // Token bucket over attempts and scans
+    PublishFilter m_publishFilter;    // Suppresses unchanged statistics and history
+    RuntimeDiagnostics m_diagnostics; // Memory around reads, loop blocks
+    bool m_autoScanAfterFailureDone;  // Guards the failure-recovery frequency scan to once per failure streak
+
+    // Read cache (the reading itself stays on the published sensors/topics)
+    bool m_haveReading;
+    unsigned long m_lastReadingMs; // millis() of the last successful read
+    unsigned long m_cacheHits;
+    unsigned long m_coalescedTriggers;
 
     // Statistics
     unsigned long m_totalReadAttempts;
@@ -219,8 +375,23 @@ private:
     // Schedule state cache
     int m_readHourLocal;
     int m_readMinuteLocal;
-    bool m_lastReadDayMatch;
-    bool m_lastReadTimeMatch;
+    time_t m_nextScheduledReadUtc; // Next fire time, 0 when not computed or no reading day
+    time_t m_lastScheduleEvalUtc;  // Epoch at the previous schedule check, detects clock jumps
+    time_t m_lastScheduledFireUtc; // Deadline of the last scheduled read that fired
+    ScheduleMask m_scheduleMask;   // Reading schedule compiled from the config
+    bool m_scheduleDirty;          // Recompute m_nextScheduledReadUtc on the next check
+    int m_alignedHourLocal;        // Auto-aligned reading hour (local-offset), -1 = use config
+
+    // Read slot statistics
+    ReadSlotStats m_slotStats;
+    char m_slotStatsKey[32];
+    int m_sessionHourLocal; // Local-offset hour the current session started, -1 = unknown
+    int m_sessionWeekday;
+
+    // Meter clock and wake window (meter time base), from the last successful read
+    MeterClockTracker m_meterClock;
+    int m_meterWindowStart; // -1 until a read reports the window
+    int m_meterWindowEnd;
 };
 
 #endif // METER_READER_H
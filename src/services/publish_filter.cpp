@@ -0,0 +1,81 @@
+/**
+ * @file publish_filter.cpp
+ * @brief Implementation of change-only publishing
+ */
+
+#include "publish_filter.h"
+#include <cstring>
+
+PublishFilter::PublishFilter()
+    : m_fullRefreshMs(0), m_lastRefreshMs(0), m_known(0), m_hashes{}, m_published(0), m_suppressed(0)
+{
+}
+
+void PublishFilter::configure(unsigned long fullRefreshMs)
+{
+    m_fullRefreshMs = fullRefreshMs;
+    m_lastRefreshMs = millis();
+    m_known = 0;
+}
+
+uint32_t PublishFilter::hash(const void *data, size_t size, uint32_t seed)
+{
+    // FNV-1a: a collision only delays an update until the next full refresh
+    uint32_t h = seed;
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < size; i++)
+    {
+        h ^= bytes[i];
+        h *= 16777619UL;
+    }
+    return h;
+}
+
+bool PublishFilter::shouldPublish(uint8_t entity, const void *data, size_t size, unsigned long nowMs)
+{
+    if (!isEnabled() || entity >= MAX_ENTITIES)
+    {
+        m_published++;
+        return true;
+    }
+
+    if (nowMs - m_lastRefreshMs >= m_fullRefreshMs)
+    {
+        forceRefresh();
+        m_lastRefreshMs = nowMs;
+    }
+
+    const uint64_t bit = 1ULL << entity;
+    if ((m_known & bit) && m_hashes[entity] == hash(data, size))
+    {
+        m_suppressed++;
+        return false;
+    }
+    m_published++;
+    return true;
+}
+
+bool PublishFilter::shouldPublish(uint8_t entity, const char *payload, unsigned long nowMs)
+{
+    return shouldPublish(entity, payload, payload ? strlen(payload) : 0, nowMs);
+}
+
+void PublishFilter::markPublished(uint8_t entity, const void *data, size_t size)
+{
+    if (entity >= MAX_ENTITIES)
+    {
+        return;
+    }
+    m_hashes[entity] = hash(data, size);
+    m_known |= 1ULL << entity;
+}
+
+void PublishFilter::markPublished(uint8_t entity, const char *payload)
+{
+    markPublished(entity, payload, payload ? strlen(payload) : 0);
+}
+
+void PublishFilter::forceRefresh()
+{
+    m_known = 0;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file publish_filter.h
+ * @brief Change-only publishing with a periodic full refresh
+ *
+ * Remembers a 32-bit hash of the last value published for each entity and
+ * suppresses a publish whose value has not changed. Every entity is published
+ * again once per full-refresh interval, and after forceRefresh() (call it when
+ * the connection is re-established), so a consumer that lost its state
+ * recovers without waiting for a value to change.
+ *
+ * Entities are small integers chosen by the caller (an enum of its topics).
+ * A value is only recorded as published when the caller reports success, so
+ * a publish lost to a dropped connection is retried on the next update.
+ *
+ * This module is designed to be reusable across different projects (Arduino, ESPHome, etc.)
+ * and is independent of MQTT or WiFi dependencies.
+ */
+
+#ifndef PUBLISH_FILTER_H
+#define PUBLISH_FILTER_H
+
+#include <Arduino.h>
+
+/**
+ * @class PublishFilter
+ * @brief Per-entity last-value hashes and the refresh schedule
+ */
+class PublishFilter
+{
+public:
+    static constexpr uint8_t MAX_ENTITIES = 64;
+
+    PublishFilter();
+
+    /**
+     * @brief Set the full-refresh interval
+     * @param fullRefreshMs Republish every entity this often; 0 disables suppression
+     */
+    void configure(unsigned long fullRefreshMs);
+
+    /**
+     * @brief Check if a value needs publishing
+     *
+     * @param entity Caller's entity number (< MAX_ENTITIES; others always publish)
+     * @param data Value bytes, e.g. the payload string
+     * @param size Number of bytes
+     * @param nowMs Current millis()
+     * @return true if the value changed, was never published, or a refresh is due
+     */
+    bool shouldPublish(uint8_t entity, const void *data, size_t size, unsigned long nowMs);
+    bool shouldPublish(uint8_t entity, const char *payload, unsigned long nowMs);
+
+    /**
+     * @brief Record a value as published
+     */
+    void markPublished(uint8_t entity, const void *data, size_t size);
+    void markPublished(uint8_t entity, const char *payload);
+
+    /**
+     * @brief Publish every entity again on its next update
+     */
+    void forceRefresh();
+
+    bool isEnabled() const { return m_fullRefreshMs > 0; }
+
+    /// Values published (changed, new or refreshed)
+    unsigned long getPublished() const { return m_published; }
+    /// Values suppressed because they were unchanged
+    unsigned long getSuppressed() const { return m_suppressed; }
+
+    /**
+     * @brief 32-bit FNV-1a hash, chainable by passing a previous result as seed
+     */
+    static uint32_t hash(const void *data, size_t size, uint32_t seed = 2166136261UL);
+
+private:
+
+    unsigned long m_fullRefreshMs;
+    unsigned long m_lastRefreshMs;
+    uint64_t m_known; // Bit per entity: a hash is recorded since the last refresh
+    uint32_t m_hashes[MAX_ENTITIES];
+    unsigned long m_published;
+    unsigned long m_suppressed;
+};
+
+#endif // PUBLISH_FILTER_H
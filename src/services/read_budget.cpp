@@ -0,0 +1,104 @@
+/**
+ * @file read_budget.cpp
+ * @brief Implementation of the meter interrogation token bucket
+ */
+
+#include "read_budget.h"
+
+static const uint32_t MS_PER_DAY = 24UL * 60 * 60 * 1000;
+
+ReadBudget::ReadBudget()
+    : m_perDay(0), m_burst(1), m_reserve(0), m_milliTokens(1000), m_lastRefillMs(0), m_deniedManual(0),
+      m_deniedScheduled(0)
+{
+}
+
+void ReadBudget::configure(uint16_t perDay, uint16_t burst, uint16_t scheduledReserve)
+{
+    m_perDay = perDay;
+    m_burst = (burst < 1) ? 1 : burst;
+    m_reserve = (scheduledReserve < m_burst) ? scheduledReserve : m_burst - 1;
+    m_milliTokens = (uint32_t)m_burst * 1000;
+    m_lastRefillMs = millis();
+}
+
+void ReadBudget::refill(unsigned long nowMs)
+{
+    const uint32_t full = (uint32_t)m_burst * 1000;
+    const unsigned long elapsed = nowMs - m_lastRefillMs;
+    // Milli-tokens per ms is perDay / MS_PER_DAY; only whole milli-tokens are
+    // credited and the clock advances by exactly the time they took
+    const uint64_t earned = (uint64_t)elapsed * m_perDay * 1000 / MS_PER_DAY;
+    if (earned == 0)
+    {
+        return;
+    }
+    if (m_milliTokens + earned >= full)
+    {
+        m_milliTokens = full;
+        m_lastRefillMs = nowMs;
+        return;
+    }
+    m_milliTokens += (uint32_t)earned;
+    m_lastRefillMs += (unsigned long)(earned * MS_PER_DAY / ((uint64_t)m_perDay * 1000));
+}
+
+bool ReadBudget::tryConsume(uint16_t tokens, Priority priority, unsigned long nowMs)
+{
+    if (!isEnabled())
+    {
+        return true;
+    }
+    refill(nowMs);
+
+    const uint32_t keep = (priority == Priority::Manual) ? (uint32_t)m_reserve * 1000 : 0;
+    const uint32_t cost = (uint32_t)tokens * 1000;
+    if (m_milliTokens < cost + keep)
+    {
+        if (priority == Priority::Manual)
+        {
+            m_deniedManual++;
+        }
+        else
+        {
+            m_deniedScheduled++;
+        }
+        return false;
+    }
+
+    // Leaving a full bucket starts the refill clock now, not at the last refill
+    if (m_milliTokens == (uint32_t)m_burst * 1000)
+    {
+        m_lastRefillMs = nowMs;
+    }
+    m_milliTokens -= cost;
+    return true;
+}
+
+uint16_t ReadBudget::getTokens(unsigned long nowMs)
+{
+    if (!isEnabled())
+    {
+        return m_burst;
+    }
+    refill(nowMs);
+    return (uint16_t)(m_milliTokens / 1000);
+}
+
+unsigned long ReadBudget::getMsUntilNextToken(unsigned long nowMs)
+{
+    if (!isEnabled())
+    {
+        return 0;
+    }
+    refill(nowMs);
+    if (m_milliTokens >= (uint32_t)m_burst * 1000)
+    {
+        return 0;
+    }
+    const uint32_t missing = 1000 - m_milliTokens % 1000;
+    const unsigned long sinceRefill = nowMs - m_lastRefillMs;
+    const unsigned long needed = (unsigned long)(((uint64_t)missing * MS_PER_DAY + (uint64_t)m_perDay * 1000 - 1) /
+                                                 ((uint64_t)m_perDay * 1000));
+    return (needed > sinceRefill) ? needed - sinceRefill : 0;
+}
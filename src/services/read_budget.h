@@ -0,0 +1,99 @@
+/**
+ * @file read_budget.h
+ * @brief Token-bucket budget for meter interrogations
+ *
+ * Every read attempt wakes the meter and spends a little of its battery
+ * (reported as battery_left in months), and every scan keeps our radio
+ * transmitting. This budget caps how often a user, an automation or a retry
+ * storm can do either: each attempt costs one token, a frequency scan costs
+ * SCAN_COST tokens, and tokens refill at a steady rate up to a burst limit.
+ *
+ * Scheduled reads take priority: they may spend the bucket down to zero,
+ * while manual reads and scans must leave enough tokens for one full
+ * scheduled session.
+ *
+ * This module is designed to be reusable across different projects (Arduino, ESPHome, etc.)
+ * and is independent of MQTT or WiFi dependencies.
+ */
+
+#ifndef READ_BUDGET_H
+#define READ_BUDGET_H
+
+#include <Arduino.h>
+
+/**
+ * @class ReadBudget
+ * @brief Per-meter token bucket with scheduled-first priority
+ *
+ * Tokens are kept in thousandths so slow refill rates accumulate exactly.
+ * The bucket starts full and lives in RAM only. All times are millis() values.
+ */
+class ReadBudget
+{
+public:
+    enum class Priority : uint8_t
+    {
+        Scheduled, // May spend the last tokens
+        Manual     // Must leave the scheduled reserve untouched
+    };
+
+    static constexpr uint16_t SCAN_COST = 5; // Most scan steps are off-frequency and don't wake the meter
+
+    ReadBudget();
+
+    /**
+     * @brief Set the budget
+     * @param perDay Tokens refilled per day (0 = unlimited, budget disabled)
+     * @param burst Bucket capacity (>= 1)
+     * @param scheduledReserve Tokens manual requests must leave for a scheduled session
+     */
+    void configure(uint16_t perDay, uint16_t burst, uint16_t scheduledReserve);
+
+    /**
+     * @brief Check if the budget is enforced
+     */
+    bool isEnabled() const { return m_perDay > 0; }
+
+    /**
+     * @brief Spend tokens if the budget allows it
+     *
+     * @param tokens Tokens to spend (1 per read attempt, SCAN_COST per scan)
+     * @param priority Scheduled or manual
+     * @param nowMs Current millis()
+     * @return true if spent (or the budget is disabled); false if denied
+     */
+    bool tryConsume(uint16_t tokens, Priority priority, unsigned long nowMs);
+
+    /**
+     * @brief Get whole tokens available now
+     * @param nowMs Current millis()
+     */
+    uint16_t getTokens(unsigned long nowMs);
+
+    /**
+     * @brief Get the time until one more token is available
+     * @param nowMs Current millis()
+     * @return Milliseconds (0 if the bucket is full or the budget is disabled)
+     */
+    unsigned long getMsUntilNextToken(unsigned long nowMs);
+
+    uint16_t getBurst() const { return m_burst; }
+    uint16_t getPerDay() const { return m_perDay; }
+    /// Manual reads and scans refused
+    unsigned long getDeniedManual() const { return m_deniedManual; }
+    /// Scheduled reads and retries refused (the bucket was empty)
+    unsigned long getDeniedScheduled() const { return m_deniedScheduled; }
+
+private:
+    void refill(unsigned long nowMs);
+
+    uint16_t m_perDay;
+    uint16_t m_burst;
+    uint16_t m_reserve;
+    uint32_t m_milliTokens;
+    unsigned long m_lastRefillMs;
+    unsigned long m_deniedManual;
+    unsigned long m_deniedScheduled;
+};
+
+#endif // READ_BUDGET_H
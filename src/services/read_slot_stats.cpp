@@ -0,0 +1,178 @@
+/**
+ * @file read_slot_stats.cpp
+ * @brief Implementation of the read outcome histogram
+ */
+
+#include "read_slot_stats.h"
+#include "storage_abstraction.h"
+
+ReadSlotStats::ReadSlotStats()
+{
+    reset();
+}
+
+void ReadSlotStats::reset()
+{
+    memset(&m_data, 0, sizeof(m_data));
+    m_data.version = LAYOUT_VERSION;
+}
+
+void ReadSlotStats::recordSession(int hourLocal, int weekday, int attempts, bool success)
+{
+    if (hourLocal < 0 || hourLocal > 23 || weekday < 0 || weekday > 6)
+    {
+        return;
+    }
+
+    const int extra = constrain(attempts - 1, 0, 255);
+    const bool firstOk = success && attempts <= 1;
+
+    HourBucket &h = m_data.hours[hourLocal];
+    if (h.sessions >= DECAY_AT || h.extraAttempts > 255 - extra)
+    {
+        h.sessions = (h.sessions + 1) / 2;
+        h.firstOk = (h.firstOk + 1) / 2;
+        h.extraAttempts = (h.extraAttempts + 1) / 2;
+    }
+    h.sessions++;
+    h.firstOk += firstOk ? 1 : 0;
+    h.extraAttempts = static_cast<uint8_t>(constrain(h.extraAttempts + extra, 0, 255));
+
+    DayBucket &d = m_data.days[weekday];
+    if (d.sessions >= DECAY_AT)
+    {
+        d.sessions = (d.sessions + 1) / 2;
+        d.firstOk = (d.firstOk + 1) / 2;
+    }
+    d.sessions++;
+    d.firstOk += firstOk ? 1 : 0;
+}
+
+int32_t ReadSlotStats::scoreHour(int hour) const
+{
+    const HourBucket &h = m_data.hours[hour];
+    // Laplace-smoothed first-attempt rate, so one lucky session doesn't
+    // outrank an hour with a long good record
+    int32_t score = (static_cast<int32_t>(h.firstOk) + 1) * 1000 / (h.sessions + 2);
+    if (h.sessions > 0)
+    {
+        score -= static_cast<int32_t>(h.extraAttempts) * RETRY_PENALTY_PERMILLE / h.sessions;
+    }
+    return score;
+}
+
+int ReadSlotStats::chooseHour(int windowStartHour, int windowEndHour, int anchorHour, int currentHour) const
+{
+    const int start = constrain(windowStartHour, 0, 23);
+    const int end = constrain(windowEndHour, 0, 23);
+    const int window = (end - start + 24) % 24;
+    if (window == 0)
+    {
+        return -1;
+    }
+
+    const int anchorIdx = constrain((anchorHour - start + 24) % 24, 0, window - 1);
+    int currentIdx = -1;
+    if (currentHour >= 0)
+    {
+        currentIdx = (currentHour - start + 24) % 24;
+        if (currentIdx >= window)
+        {
+            currentIdx = -1;
+        }
+    }
+
+    // Explore: least-sampled hour first, nearest the anchor on ties
+    int bestIdx = -1;
+    for (int i = 0; i < window; i++)
+    {
+        const uint8_t sessions = m_data.hours[(start + i) % 24].sessions;
+        if (sessions >= MIN_SESSIONS_PER_HOUR)
+        {
+            continue;
+        }
+        if (bestIdx < 0)
+        {
+            bestIdx = i;
+            continue;
+        }
+        const uint8_t bestSessions = m_data.hours[(start + bestIdx) % 24].sessions;
+        if (sessions < bestSessions ||
+            (sessions == bestSessions && abs(i - anchorIdx) < abs(bestIdx - anchorIdx)))
+        {
+            bestIdx = i;
+        }
+    }
+    if (bestIdx >= 0)
+    {
+        return (start + bestIdx) % 24;
+    }
+
+    // Exploit: best score, nearest the anchor on ties
+    int32_t bestScore = 0;
+    for (int i = 0; i < window; i++)
+    {
+        const int32_t score = scoreHour((start + i) % 24);
+        if (bestIdx < 0 || score > bestScore ||
+            (score == bestScore && abs(i - anchorIdx) < abs(bestIdx - anchorIdx)))
+        {
+            bestIdx = i;
+            bestScore = score;
+        }
+    }
+
+    // Hysteresis: stay put unless the move is clearly worth it
+    if (currentIdx >= 0 && bestScore - scoreHour((start + currentIdx) % 24) < SWITCH_MARGIN_PERMILLE)
+    {
+        bestIdx = currentIdx;
+    }
+
+    return (start + bestIdx) % 24;
+}
+
+uint8_t ReadSlotStats::getSessions(int hour) const
+{
+    return (hour >= 0 && hour < 24) ? m_data.hours[hour].sessions : 0;
+}
+
+int ReadSlotStats::getFirstAttemptPercent(int hour) const
+{
+    if (hour < 0 || hour > 23 || m_data.hours[hour].sessions == 0)
+    {
+        return -1;
+    }
+    return m_data.hours[hour].firstOk * 100 / m_data.hours[hour].sessions;
+}
+
+uint8_t ReadSlotStats::getWeekdaySessions(int weekday) const
+{
+    return (weekday >= 0 && weekday < 7) ? m_data.days[weekday].sessions : 0;
+}
+
+int ReadSlotStats::getWeekdayFirstAttemptPercent(int weekday) const
+{
+    if (weekday < 0 || weekday > 6 || m_data.days[weekday].sessions == 0)
+    {
+        return -1;
+    }
+    return m_data.days[weekday].firstOk * 100 / m_data.days[weekday].sessions;
+}
+
+bool ReadSlotStats::load(const char *key)
+{
+    Data loaded;
+    if (!StorageAbstraction::loadBlob(key, &loaded, sizeof(loaded), STORAGE_MAGIC) ||
+        loaded.version != LAYOUT_VERSION)
+    {
+        reset();
+        return false;
+    }
+    m_data = loaded;
+    return true;
+}
+
+bool ReadSlotStats::save(const char *key) const
+{
+    static_assert(sizeof(Data) <= StorageAbstraction::BLOB_MAX_SIZE, "Read slot histogram must fit a storage blob");
+    return StorageAbstraction::saveBlob(key, &m_data, sizeof(m_data), STORAGE_MAGIC);
+}
@@ -0,0 +1,149 @@
+/**
+ * @file read_slot_stats.h
+ * @brief Read outcome histogram used to pick the best reading hour
+ *
+ * Records how each read session went (first-attempt success and number of
+ * retries) by local hour of day and by weekday, in a compact decaying
+ * histogram that is persisted between reboots. Auto-align uses it to choose
+ * the hour inside the meter's wake window (time_start to time_end) where the
+ * meter answers first time most often, instead of always using the window
+ * start or midpoint.
+ *
+ * This module is designed to be reusable across different projects (Arduino, ESPHome, etc.)
+ * and is independent of MQTT or WiFi dependencies.
+ */
+
+#ifndef READ_SLOT_STATS_H
+#define READ_SLOT_STATS_H
+
+#include <Arduino.h>
+
+/**
+ * @class ReadSlotStats
+ * @brief Per-meter histogram of read outcomes by hour and weekday
+ *
+ * Each hour bucket counts sessions, first-attempt successes and extra
+ * attempts (retries). A bucket is halved once it reaches DECAY_AT sessions, so
+ * the statistics follow changes at the site (new obstacles, meter battery
+ * ageing) instead of being dominated by old data. The whole record is 88
+ * bytes.
+ *
+ * Slot selection first explores every hour in the wake window until each has
+ * MIN_SESSIONS_PER_HOUR sessions, starting from the anchor hour (window start
+ * or midpoint) and working outwards. After that it picks the hour with the
+ * best smoothed first-attempt rate minus a penalty per average retry, and
+ * only moves away from the current hour when the gain exceeds a small margin.
+ */
+class ReadSlotStats
+{
+public:
+    /// Sessions needed in every window hour before exploration stops
+    static constexpr uint8_t MIN_SESSIONS_PER_HOUR = 3;
+
+    ReadSlotStats();
+
+    /**
+     * @brief Clear all recorded sessions
+     */
+    void reset();
+
+    /**
+     * @brief Record the outcome of one read session
+     *
+     * @param hourLocal Local-offset hour the session started (0-23)
+     * @param weekday Local-offset weekday the session started (0 = Sunday)
+     * @param attempts Attempts made, including the first one (>= 1)
+     * @param success true if the session ended with a valid reading
+     */
+    void recordSession(int hourLocal, int weekday, int attempts, bool success);
+
+    /**
+     * @brief Choose the reading hour inside the meter's wake window
+     *
+     * @param windowStartHour Start of the wake window (local, 0-23)
+     * @param windowEndHour End of the wake window (local, 0-23, exclusive)
+     * @param anchorHour Preferred hour while exploring and on ties (start or midpoint)
+     * @param currentHour Hour in use now, kept unless another is clearly better (-1 if none)
+     * @return Chosen local hour, or -1 if the window is invalid (0 hours)
+     */
+    int chooseHour(int windowStartHour, int windowEndHour, int anchorHour, int currentHour) const;
+
+    /**
+     * @brief Get the number of sessions recorded for an hour
+     * @param hour Local hour (0-23)
+     */
+    uint8_t getSessions(int hour) const;
+
+    /**
+     * @brief Get the first-attempt success rate for an hour
+     * @param hour Local hour (0-23)
+     * @return Percentage 0-100, or -1 if no sessions are recorded
+     */
+    int getFirstAttemptPercent(int hour) const;
+
+    /**
+     * @brief Get the number of sessions recorded for a weekday
+     * @param weekday Weekday (0 = Sunday)
+     */
+    uint8_t getWeekdaySessions(int weekday) const;
+
+    /**
+     * @brief Get the first-attempt success rate for a weekday
+     * @param weekday Weekday (0 = Sunday)
+     * @return Percentage 0-100, or -1 if no sessions are recorded
+     */
+    int getWeekdayFirstAttemptPercent(int weekday) const;
+
+    /**
+     * @brief Load the histogram from persistent storage
+     * @param key Storage key (unique per meter)
+     * @return true if a stored histogram was loaded, false if starting empty
+     */
+    bool load(const char *key);
+
+    /**
+     * @brief Save the histogram to persistent storage
+     * @param key Storage key (unique per meter)
+     * @return true if the save succeeded
+     */
+    bool save(const char *key) const;
+
+private:
+    struct HourBucket
+    {
+        uint8_t sessions;      // Read sessions started in this hour
+        uint8_t firstOk;       // Sessions that succeeded on the first attempt
+        uint8_t extraAttempts; // Retries used by those sessions
+    };
+
+    struct DayBucket
+    {
+        uint8_t sessions;
+        uint8_t firstOk;
+    };
+
+    // Persisted as-is: only uint8_t fields, so there is no padding and the
+    // layout is identical on every platform
+    struct Data
+    {
+        uint8_t version;
+        uint8_t reserved;
+        HourBucket hours[24];
+        DayBucket days[7];
+    };
+
+    /**
+     * @brief Score an hour in permille (higher is better)
+     */
+    int32_t scoreHour(int hour) const;
+
+    Data m_data;
+
+    static constexpr uint16_t STORAGE_MAGIC = 0x5348;
+    static constexpr uint8_t LAYOUT_VERSION = 1;
+    static constexpr uint8_t DECAY_AT = 32;                 // Halve a bucket after this many sessions
+    static constexpr int32_t RETRY_PENALTY_PERMILLE = 100;  // Score cost of one retry per session
+    static constexpr int32_t SWITCH_MARGIN_PERMILLE = 50;   // Gain needed to move off the current hour
+};
+
+#endif // READ_SLOT_STATS_H
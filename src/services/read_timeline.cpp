@@ -0,0 +1,182 @@
+/**
+ * @file read_timeline.cpp
+ * @brief Implementation of the per-phase read timeline
+ */
+
+#include "read_timeline.h"
+#include "json_writer.h"
+#include <string.h>
+
+namespace
+{
+const char *const PHASE_NAMES[(size_t)ReadPhase::Count] = {
+    "pre_tx_reset",
+    "wup_prefill",
+    "wup_feed",
+    "interrogation_write",
+    "tx_drain",
+    "ack_sync_wait",
+    "ack_payload",
+    "data_sync_wait",
+    "capture",
+    "decode",
+    "crc",
+    "parse",
+    "publish",
+};
+
+void writeStatsArray(JsonWriter &json, const ReadPhaseStats &stats)
+{
+    json.beginArray();
+    json.value(stats.p50Us / 1000.0, 1);
+    json.value(stats.p95Us / 1000.0, 1);
+    json.value(stats.maxUs / 1000.0, 1);
+    json.endArray();
+}
+} // namespace
+
+ReadTimeline::ReadTimeline()
+    : m_traces{}, m_next(0), m_count(0), m_committed(0), m_current{}, m_boundaryUs(0), m_open(false)
+{
+}
+
+void ReadTimeline::begin(uint32_t nowUs)
+{
+    memset(&m_current, 0, sizeof(m_current));
+    m_boundaryUs = nowUs;
+    m_open = true;
+}
+
+void ReadTimeline::mark(ReadPhase phase, uint32_t nowUs)
+{
+    if (!m_open || phase >= ReadPhase::Count)
+    {
+        return;
+    }
+    const size_t i = (size_t)phase;
+    m_current.phaseUs[i] += nowUs - m_boundaryUs; // Unsigned: correct across the micros() wrap
+    m_current.recorded |= (uint16_t)(1U << i);
+    m_boundaryUs = nowUs;
+}
+
+void ReadTimeline::skip(uint32_t nowUs)
+{
+    m_boundaryUs = nowUs;
+}
+
+void ReadTimeline::commit(bool success)
+{
+    if (!m_open)
+    {
+        return;
+    }
+    m_current.success = success;
+    m_traces[m_next] = m_current;
+    m_next = (uint8_t)((m_next + 1) % CAPACITY);
+    if (m_count < CAPACITY)
+    {
+        m_count++;
+    }
+    m_committed++;
+    m_open = false;
+}
+
+const ReadTrace *ReadTimeline::latest() const
+{
+    if (m_count == 0)
+    {
+        return nullptr;
+    }
+    return &m_traces[(m_next + CAPACITY - 1) % CAPACITY];
+}
+
+ReadPhaseStats ReadTimeline::computeStats(uint32_t *values, uint8_t n)
+{
+    ReadPhaseStats stats = {0, 0, 0, n};
+    if (n == 0)
+    {
+        return stats;
+    }
+
+    // Insertion sort: at most CAPACITY values
+    for (uint8_t i = 1; i < n; i++)
+    {
+        uint32_t v = values[i];
+        uint8_t j = i;
+        while (j > 0 && values[j - 1] > v)
+        {
+            values[j] = values[j - 1];
+            j--;
+        }
+        values[j] = v;
+    }
+
+    // Nearest rank: the smallest value with at least p% of samples at or below it
+    stats.p50Us = values[(n * 50 + 99) / 100 - 1];
+    stats.p95Us = values[(n * 95 + 99) / 100 - 1];
+    stats.maxUs = values[n - 1];
+    return stats;
+}
+
+ReadPhaseStats ReadTimeline::getPhaseStats(ReadPhase phase) const
+{
+    uint32_t values[CAPACITY];
+    uint8_t n = 0;
+    if (phase < ReadPhase::Count)
+    {
+        const size_t p = (size_t)phase;
+        for (uint8_t i = 0; i < m_count; i++)
+        {
+            if (m_traces[i].recorded & (1U << p))
+            {
+                values[n++] = m_traces[i].phaseUs[p];
+            }
+        }
+    }
+    return computeStats(values, n);
+}
+
+ReadPhaseStats ReadTimeline::getTotalStats() const
+{
+    uint32_t values[CAPACITY];
+    for (uint8_t i = 0; i < m_count; i++)
+    {
+        uint32_t total = 0;
+        for (size_t p = 0; p < (size_t)ReadPhase::Count; p++)
+        {
+            if (m_traces[i].recorded & (1U << p))
+            {
+                total += m_traces[i].phaseUs[p];
+            }
+        }
+        values[i] = total;
+    }
+    return computeStats(values, m_count);
+}
+
+void ReadTimeline::writeJson(JsonWriter &json) const
+{
+    json.beginObject();
+    json.field("reads", (unsigned int)m_count);
+    json.key("total_ms");
+    writeStatsArray(json, getTotalStats());
+    json.key("phases_ms");
+    json.beginObject();
+    for (size_t p = 0; p < (size_t)ReadPhase::Count; p++)
+    {
+        const ReadPhaseStats stats = getPhaseStats((ReadPhase)p);
+        if (stats.samples == 0)
+        {
+            continue;
+        }
+        json.key(PHASE_NAMES[p]);
+        writeStatsArray(json, stats);
+    }
+    json.endObject();
+    json.endObject();
+}
+
+const char *ReadTimeline::phaseName(ReadPhase phase)
+{
+    return phase < ReadPhase::Count ? PHASE_NAMES[(size_t)phase] : "unknown";
+}
@@ -0,0 +1,160 @@
+/**
+ * @file read_timeline.h
+ * @brief Per-phase timing of meter reads and latency percentiles over recent reads
+ *
+ * A meter read runs through fixed phases, from resetting the radio for TX to
+ * publishing the result. The radio driver and the read orchestrator mark the
+ * end of each phase with a micros() timestamp; the time since the previous
+ * boundary is charged to that phase. A finished read is committed as one
+ * trace into a ring of the last CAPACITY traces, from which p50, p95 and max
+ * per phase are computed for diagnostics.
+ *
+ * A trace that is begun but never committed (for example a read made by a
+ * frequency scan) is discarded by the next begin(), so only reads the caller
+ * chooses to report reach the statistics. Phases a read never reached (no
+ * ACK, CRC failure) are left out of that trace, not counted as zero.
+ *
+ * This module is designed to be reusable across different projects (Arduino, ESPHome, etc.)
+ * and is independent of MQTT or WiFi dependencies.
+ */
+
+#ifndef READ_TIMELINE_H
+#define READ_TIMELINE_H
+
+#include <Arduino.h>
+
+class JsonWriter;
+
+/**
+ * @enum ReadPhase
+ * @brief Phases of one meter read, in order
+ */
+enum class ReadPhase : uint8_t
+{
+    PreTxReset,         // Radio to IDLE, FIFO flush, TX registers
+    WupPrefill,         // First wake-up bytes into the TX FIFO, STX, TX state reached
+    WupFeed,            // Feeding the rest of the ~2 s wake-up burst
+    InterrogationWrite, // Waiting for FIFO room and writing the request frame
+    TxDrain,            // Until the TX FIFO has emptied on air
+    AckSyncWait,        // Listening for the ACK frame start
+    AckPayload,         // Capturing the ACK frame
+    DataSyncWait,       // Listening for the data frame start
+    Capture,            // Capturing the data frame
+    Decode,             // 4-bit-per-bit serial decode
+    Crc,                // CRC validation
+    Parse,              // Field extraction
+    Publish,            // Handing the reading to MQTT / ESPHome
+    Count
+};
+
+/**
+ * @struct ReadTrace
+ * @brief Phase durations of one read
+ */
+struct ReadTrace
+{
+    uint32_t phaseUs[(size_t)ReadPhase::Count]; // Duration per phase, valid where recorded
+    uint16_t recorded;                          // Bit per phase that was reached
+    bool success;                               // The read produced a valid reading
+};
+
+/**
+ * @struct ReadPhaseStats
+ * @brief Latency percentiles of one phase over the traces in the ring
+ */
+struct ReadPhaseStats
+{
+    uint32_t p50Us;
+    uint32_t p95Us;
+    uint32_t maxUs;
+    uint8_t samples; // Traces that reached the phase
+};
+
+/**
+ * @class ReadTimeline
+ * @brief Open trace plus a ring of the last committed traces
+ */
+class ReadTimeline
+{
+public:
+    static constexpr uint8_t CAPACITY = 16;
+
+    ReadTimeline();
+
+    /**
+     * @brief Start a new trace, discarding one left open
+     * @param nowUs Current micros(); the first phase is timed from here
+     */
+    void begin(uint32_t nowUs);
+
+    /**
+     * @brief End a phase
+     *
+     * Charges the time since the previous boundary to the phase (added if the
+     * phase is marked twice). Ignored when no trace is open.
+     *
+     * @param phase Phase that just ended
+     * @param nowUs Current micros()
+     */
+    void mark(ReadPhase phase, uint32_t nowUs);
+
+    /**
+     * @brief Move the phase boundary without charging the time to any phase
+     *
+     * For work between phases that is not part of the read, e.g. printing
+     * the log lines deferred during the radio exchange.
+     */
+    void skip(uint32_t nowUs);
+
+    /**
+     * @brief Store the open trace in the ring
+     * @param success true if the read produced a valid reading
+     */
+    void commit(bool success);
+
+    bool isOpen() const { return m_open; }
+
+    /// Committed traces in the ring (at most CAPACITY)
+    uint8_t size() const { return m_count; }
+
+    /// Reads committed since boot
+    unsigned long getCommitted() const { return m_committed; }
+
+    /// Most recent committed trace, or nullptr
+    const ReadTrace *latest() const;
+
+    /**
+     * @brief Percentiles of one phase over the ring (nearest rank)
+     */
+    ReadPhaseStats getPhaseStats(ReadPhase phase) const;
+
+    /**
+     * @brief Percentiles of the whole read (sum of the recorded phases)
+     */
+    ReadPhaseStats getTotalStats() const;
+
+    /**
+     * @brief Write the statistics as a JSON object
+     *
+     * {"reads":16,"total_ms":[p50,p95,max],"phases_ms":{"pre_tx_reset":[p50,p95,max],...}}
+     * with milliseconds to one decimal; phases with no samples are omitted.
+     */
+    void writeJson(JsonWriter &json) const;
+
+    /// snake_case name used in the JSON, e.g. "wup_feed"
+    static const char *phaseName(ReadPhase phase);
+
+private:
+    static ReadPhaseStats computeStats(uint32_t *values, uint8_t n);
+
+    ReadTrace m_traces[CAPACITY];
+    uint8_t m_next;  // Ring slot the next commit writes
+    uint8_t m_count; // Valid traces in the ring
+    unsigned long m_committed;
+
+    ReadTrace m_current;
+    uint32_t m_boundaryUs;
+    bool m_open;
+};
+
+#endif // READ_TIMELINE_H
@@ -0,0 +1,157 @@
+/**
+ * @file reading_codec.cpp
+ * @brief Implementation of the compact binary reading payload
+ */
+
+#include "reading_codec.h"
+#include <cstring>
+
+namespace
+{
+const uint8_t FLAG_HISTORY = 0x01;
+const uint8_t FLAG_GAS = 0x02;
+
+// Bounds-checked byte writer; overflow is sticky so the caller checks once
+struct Writer
+{
+    uint8_t *out;
+    size_t size;
+    size_t length;
+    bool overflow;
+
+    void byte(uint8_t b)
+    {
+        if (length >= size)
+        {
+            overflow = true;
+            return;
+        }
+        out[length++] = b;
+    }
+
+    void varint(uint32_t v)
+    {
+        while (v >= 0x80)
+        {
+            byte((uint8_t)(v | 0x80));
+            v >>= 7;
+        }
+        byte((uint8_t)v);
+    }
+
+    void zigzag(int32_t v)
+    {
+        varint(((uint32_t)v << 1) ^ (uint32_t)(v >> 31));
+    }
+};
+
+struct Reader
+{
+    const uint8_t *data;
+    size_t size;
+    size_t pos;
+    bool error;
+
+    uint8_t byte()
+    {
+        if (pos >= size)
+        {
+            error = true;
+            return 0;
+        }
+        return data[pos++];
+    }
+
+    uint32_t varint()
+    {
+        uint32_t v = 0;
+        for (int shift = 0; shift < 35; shift += 7)
+        {
+            const uint8_t b = byte();
+            v |= (uint32_t)(b & 0x7F) << shift;
+            if (!(b & 0x80))
+            {
+                return v;
+            }
+        }
+        error = true; // More than 5 bytes cannot be a uint32
+        return 0;
+    }
+
+    int32_t zigzag()
+    {
+        const uint32_t v = varint();
+        return (int32_t)((v >> 1) ^ (0u - (v & 1)));
+    }
+};
+} // namespace
+
+size_t ReadingCodec::encode(const CompactReading &reading, uint8_t *out, size_t size)
+{
+    Writer w = {out, out ? size : 0, 0, false};
+    const uint8_t count = (reading.historyCount <= 13) ? reading.historyCount : 13;
+
+    w.byte(SCHEMA_VERSION);
+    w.byte((count > 0 ? FLAG_HISTORY : 0) | (reading.isGas ? FLAG_GAS : 0));
+    w.varint(reading.timestamp);
+    w.zigzag(reading.volume);
+    w.zigzag(reading.rssiDbm);
+    w.byte(reading.lqi);
+    w.byte(reading.readsCounter);
+    w.byte(reading.batteryMonths);
+    w.byte(reading.timeStart);
+    w.byte(reading.timeEnd);
+    w.zigzag(reading.frequencyOffsetHz);
+
+    if (count > 0)
+    {
+        // Monthly volumes only grow by a month's usage, so deltas stay 1-3 bytes
+        w.byte(count);
+        w.varint(reading.history[0]);
+        for (uint8_t i = 1; i < count; i++)
+        {
+            w.zigzag((int32_t)(reading.history[i] - reading.history[i - 1]));
+        }
+    }
+
+    return w.overflow ? 0 : w.length;
+}
+
+bool ReadingCodec::decode(const uint8_t *data, size_t size, CompactReading &reading)
+{
+    Reader r = {data, data ? size : 0, 0, false};
+    memset(&reading, 0, sizeof(reading));
+
+    if (r.byte() != SCHEMA_VERSION)
+    {
+        return false;
+    }
+    const uint8_t flags = r.byte();
+    reading.isGas = (flags & FLAG_GAS) != 0;
+    reading.timestamp = r.varint();
+    reading.volume = r.zigzag();
+    reading.rssiDbm = (int16_t)r.zigzag();
+    reading.lqi = r.byte();
+    reading.readsCounter = r.byte();
+    reading.batteryMonths = r.byte();
+    reading.timeStart = r.byte();
+    reading.timeEnd = r.byte();
+    reading.frequencyOffsetHz = r.zigzag();
+
+    if (flags & FLAG_HISTORY)
+    {
+        const uint8_t count = r.byte();
+        if (count == 0 || count > 13)
+        {
+            return false;
+        }
+        reading.historyCount = count;
+        reading.history[0] = r.varint();
+        for (uint8_t i = 1; i < count; i++)
+        {
+            reading.history[i] = reading.history[i - 1] + (uint32_t)r.zigzag();
+        }
+    }
+
+    return !r.error && r.pos == size;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file reading_codec.h
+ * @brief Compact binary encoding of a meter reading and its history
+ *
+ * An alternative to the text topics and the history JSON for deployments
+ * where a local ingester, not Home Assistant, consumes the data. A reading
+ * with 13 months of history encodes to about 50 bytes, against a dozen text
+ * topics plus a history JSON document of a few hundred bytes. The codec has
+ * no platform dependencies, so an ingester can compile the same decoder.
+ *
+ * Layout (schema version 1), all multi-byte integers as LEB128 varints,
+ * signed ones zigzag-encoded first:
+ *
+ *   u8      schema version (SCHEMA_VERSION)
+ *   u8      flags: bit 0 history present, bit 1 gas meter (volume in raw units)
+ *   varint  timestamp (UTC epoch seconds)
+ *   zigzag  volume (raw meter counter)
+ *   zigzag  RSSI (dBm)
+ *   u8 x5   LQI, reads counter, battery months, wake window start, end hour
+ *   zigzag  frequency offset (Hz)
+ *   [history present]
+ *   u8      month count n (1-13, oldest first)
+ *   varint  oldest month's volume
+ *   zigzag  n-1 deltas, each month minus the month before
+ *
+ * Decoders must reject a schema version they do not know. New fields are
+ * only ever appended, under a new version.
+ *
+ * This module is designed to be reusable across different projects (Arduino, ESPHome, etc.)
+ * and is independent of MQTT or WiFi dependencies.
+ */
+
+#ifndef READING_CODEC_H
+#define READING_CODEC_H
+
+#include <Arduino.h>
+
+/**
+ * @struct CompactReading
+ * @brief The values carried by one encoded payload
+ */
+struct CompactReading
+{
+    uint32_t timestamp;        // UTC epoch seconds of the read
+    int32_t volume;            // Raw meter counter
+    int16_t rssiDbm;           // RSSI in dBm
+    uint8_t lqi;               // Link quality indicator
+    uint8_t readsCounter;      // Meter's own read counter
+    uint8_t batteryMonths;     // Battery left in months
+    uint8_t timeStart;         // Wake window start hour
+    uint8_t timeEnd;           // Wake window end hour
+    bool isGas;                // Volume is in raw gas units, not litres
+    int32_t frequencyOffsetHz; // Radio frequency offset in use
+    uint8_t historyCount;      // Valid months in history (0 = no history)
+    uint32_t history[13];      // Monthly volumes, oldest first
+};
+
+/**
+ * @class ReadingCodec
+ * @brief Encoder and decoder for the compact reading payload
+ */
+class ReadingCodec
+{
+public:
+    static constexpr uint8_t SCHEMA_VERSION = 1;
+
+    /// Largest possible payload (every varint at its maximum length)
+    static constexpr size_t MAX_ENCODED_SIZE = 2 + 5 + 5 + 3 + 5 + 5 + 1 + 13 * 5;
+
+    /**
+     * @brief Encode a reading
+     * @param reading Values to encode (historyCount above 13 is clamped)
+     * @param out Output buffer
+     * @param size Output buffer size (MAX_ENCODED_SIZE always fits)
+     * @return Encoded length, or 0 if the buffer is too small
+     */
+    static size_t encode(const CompactReading &reading, uint8_t *out, size_t size);
+
+    /**
+     * @brief Decode a payload produced by encode()
+     * @param data Payload bytes
+     * @param size Payload length
+     * @param reading Decoded values (history entries past historyCount are zeroed)
+     * @return false if the payload is truncated, malformed or of an unknown schema version
+     */
+    static bool decode(const uint8_t *data, size_t size, CompactReading &reading);
+};
+
+#endif // READING_CODEC_H
@@ -0,0 +1,98 @@
+/**
+ * @file reading_queue.cpp
+ * @brief Implementation of the store-and-forward reading queue
+ */
+
+#include "reading_queue.h"
+#include "storage_abstraction.h"
+#include <cstring>
+
+namespace
+{
+// Newest readings of the queue, oldest first
+struct SavedQueue
+{
+    uint8_t version;
+    uint8_t count;
+    uint8_t reserved[2];
+    QueuedReading items[ReadingQueue::PERSISTED];
+};
+} // namespace
+
+ReadingQueue::ReadingQueue() : m_head(0), m_count(0), m_dropped(0)
+{
+}
+
+bool ReadingQueue::push(const QueuedReading &reading)
+{
+    bool kept = true;
+    if (m_count == CAPACITY)
+    {
+        // Keep the newest readings: the oldest is the least useful once published late
+        m_head = (m_head + 1) % CAPACITY;
+        m_count--;
+        m_dropped++;
+        kept = false;
+    }
+    m_items[(m_head + m_count) % CAPACITY] = reading;
+    m_count++;
+    return kept;
+}
+
+bool ReadingQueue::peek(QueuedReading &reading) const
+{
+    if (m_count == 0)
+    {
+        return false;
+    }
+    reading = m_items[m_head];
+    return true;
+}
+
+void ReadingQueue::pop()
+{
+    if (m_count == 0)
+    {
+        return;
+    }
+    m_head = (m_head + 1) % CAPACITY;
+    m_count--;
+}
+
+void ReadingQueue::clear()
+{
+    m_head = 0;
+    m_count = 0;
+}
+
+bool ReadingQueue::load(const char *key)
+{
+    SavedQueue saved;
+    if (!StorageAbstraction::loadBlob(key, &saved, sizeof(saved), STORAGE_MAGIC) ||
+        saved.version != LAYOUT_VERSION || saved.count > PERSISTED)
+    {
+        return false;
+    }
+    clear();
+    for (uint8_t i = 0; i < saved.count; i++)
+    {
+        push(saved.items[i]);
+    }
+    return saved.count > 0;
+}
+
+bool ReadingQueue::save(const char *key) const
+{
+    static_assert(sizeof(SavedQueue) <= StorageAbstraction::BLOB_MAX_SIZE, "Saved reading queue must fit a storage blob");
+
+    SavedQueue saved;
+    memset(&saved, 0, sizeof(saved));
+    saved.version = LAYOUT_VERSION;
+    saved.count = (m_count < PERSISTED) ? m_count : PERSISTED;
+    const uint8_t skip = m_count - saved.count;
+    for (uint8_t i = 0; i < saved.count; i++)
+    {
+        saved.items[i] = m_items[(m_head + skip + i) % CAPACITY];
+    }
+    return StorageAbstraction::saveBlob(key, &saved, sizeof(saved), STORAGE_MAGIC);
+}
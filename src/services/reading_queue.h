@@ -0,0 +1,101 @@
+/**
+ * @file reading_queue.h
+ * @brief Store-and-forward queue for readings taken while the broker is down
+ *
+ * A scheduled read still interrogates the meter when Wi-Fi or the broker is
+ * unreachable. Instead of publishing into the void, the reading is kept here
+ * with its original timestamp and published once the connection is back, so
+ * no meter interrogation (and no meter battery) is wasted on an outage.
+ *
+ * The queue is a small RAM ring that drops the oldest reading when full. The
+ * newest PERSISTED readings can optionally be saved to persistent storage so
+ * they also survive the offline reboot.
+ *
+ * This module is designed to be reusable across different projects (Arduino, ESPHome, etc.)
+ * and is independent of MQTT or WiFi dependencies.
+ */
+
+#ifndef READING_QUEUE_H
+#define READING_QUEUE_H
+
+#include <Arduino.h>
+
+/**
+ * @struct QueuedReading
+ * @brief The published values of one successful read
+ */
+struct QueuedReading
+{
+    uint32_t timestamp;        // UTC epoch seconds of the read
+    int32_t volume;            // Raw meter counter (litres, or gas units before the divisor)
+    int32_t frequencyOffsetHz; // Radio frequency offset in use when the meter was read
+    int16_t rssiDbm;           // RSSI in dBm
+    uint8_t rssi;              // Raw RSSI register value
+    uint8_t readsCounter;      // Meter's own read counter
+    uint8_t batteryMonths;     // Battery left in months
+    uint8_t lqi;               // Link quality indicator
+    uint8_t timeStart;         // Wake window start hour
+    uint8_t timeEnd;           // Wake window end hour
+};
+
+/**
+ * @class ReadingQueue
+ * @brief Bounded FIFO of readings awaiting publication
+ */
+class ReadingQueue
+{
+public:
+    static constexpr uint8_t CAPACITY = 8;  // Readings held in RAM
+    static constexpr uint8_t PERSISTED = 4; // Newest readings that fit one storage blob
+
+    ReadingQueue();
+
+    /**
+     * @brief Append a reading, dropping the oldest one if the queue is full
+     * @return false if a reading was dropped to make room
+     */
+    bool push(const QueuedReading &reading);
+
+    /**
+     * @brief Get the oldest reading without removing it
+     * @return false if the queue is empty
+     */
+    bool peek(QueuedReading &reading) const;
+
+    /**
+     * @brief Remove the oldest reading
+     */
+    void pop();
+
+    void clear();
+
+    uint8_t size() const { return m_count; }
+    bool isEmpty() const { return m_count == 0; }
+
+    /// Readings dropped because the queue was full
+    unsigned long getDropped() const { return m_dropped; }
+
+    /**
+     * @brief Load readings saved with save(), replacing the queue contents
+     * @param key Storage key
+     * @return true if a saved queue was found
+     */
+    bool load(const char *key);
+
+    /**
+     * @brief Save the newest PERSISTED readings (an empty queue clears the saved copy)
+     * @param key Storage key
+     */
+    bool save(const char *key) const;
+
+private:
+    static constexpr uint16_t STORAGE_MAGIC = 0x5251;
+    static constexpr uint8_t LAYOUT_VERSION = 2;
+
+    QueuedReading m_items[CAPACITY];
+    uint8_t m_head; // Index of the oldest reading
+    uint8_t m_count;
+    unsigned long m_dropped;
+};
+
+#endif // READING_QUEUE_H
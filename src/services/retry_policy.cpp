@@ -0,0 +1,141 @@
+/**
+ * @file retry_policy.cpp
+ * @brief Implementation of the read session retry policy
+ */
+
+#include "retry_policy.h"
+
+RetryPolicy::RetryPolicy()
+    : m_maxAttempts(1), m_baseCooldownMs(0), m_rng(1), m_retrying(false), m_cooldownStart(0), m_cooldownMs(0),
+      m_coolingDown(false), m_lastDelayMs(0), m_failedStreak(0), m_attempts(0), m_skippedAttempts(0),
+      m_failedSessions(0)
+{
+}
+
+void RetryPolicy::configure(int maxAttempts, unsigned long cooldownMs, uint32_t seed)
+{
+    m_maxAttempts = (maxAttempts < 1) ? 1 : maxAttempts;
+    m_baseCooldownMs = cooldownMs;
+    // xorshift32 must not start at zero; mix so nearby serials diverge quickly
+    m_rng = (seed * 2654435761UL) ^ 0x5DEECE66UL;
+    if (m_rng == 0)
+    {
+        m_rng = 1;
+    }
+}
+
+int RetryPolicy::getAttemptBudget() const
+{
+    if (isMeterUnresponsive() && m_maxAttempts > UNRESPONSIVE_ATTEMPTS)
+    {
+        return UNRESPONSIVE_ATTEMPTS;
+    }
+    return m_maxAttempts;
+}
+
+unsigned long RetryPolicy::onAttemptFailed(int attemptsMade, bool windowClosed, unsigned long nowMs)
+{
+    m_attempts++;
+
+    const int budget = getAttemptBudget();
+    if (!windowClosed && attemptsMade < budget)
+    {
+        m_retrying = true;
+        m_lastDelayMs = backoffDelayMs(attemptsMade);
+        return m_lastDelayMs;
+    }
+
+    // Session over: count the attempts a healthy meter in an open window would have had
+    if (attemptsMade < m_maxAttempts)
+    {
+        m_skippedAttempts += (unsigned long)(m_maxAttempts - attemptsMade);
+    }
+
+    m_retrying = false;
+    m_failedSessions++;
+    if (m_failedStreak < 0xFFFF)
+    {
+        m_failedStreak++;
+    }
+
+    const uint8_t doublings = (m_failedStreak - 1 < MAX_COOLDOWN_DOUBLINGS) ? (uint8_t)(m_failedStreak - 1)
+                                                                            : MAX_COOLDOWN_DOUBLINGS;
+    m_cooldownMs = m_baseCooldownMs << doublings;
+    m_cooldownStart = nowMs;
+    m_coolingDown = m_cooldownMs > 0;
+    return 0;
+}
+
+void RetryPolicy::onSuccess()
+{
+    m_attempts++;
+    m_retrying = false;
+    m_coolingDown = false;
+    m_failedStreak = 0;
+}
+
+void RetryPolicy::cancel()
+{
+    m_retrying = false;
+}
+
+void RetryPolicy::clearCooldown()
+{
+    m_coolingDown = false;
+}
+
+bool RetryPolicy::isCoolingDown(unsigned long nowMs) const
+{
+    return m_coolingDown && nowMs - m_cooldownStart < m_cooldownMs;
+}
+
+unsigned long RetryPolicy::getCooldownRemainingMs(unsigned long nowMs) const
+{
+    return isCoolingDown(nowMs) ? m_cooldownMs - (nowMs - m_cooldownStart) : 0;
+}
+
+RetryPolicy::State RetryPolicy::getState(unsigned long nowMs) const
+{
+    if (m_retrying)
+    {
+        return State::Retrying;
+    }
+    return isCoolingDown(nowMs) ? State::Cooldown : State::Idle;
+}
+
+const char *RetryPolicy::getStateName(unsigned long nowMs) const
+{
+    switch (getState(nowMs))
+    {
+    case State::Retrying:
+        return "retrying";
+    case State::Cooldown:
+        return "cooldown";
+    default:
+        return "idle";
+    }
+}
+
+unsigned long RetryPolicy::backoffDelayMs(int retry)
+{
+    unsigned long delayMs = MAX_DELAY_MS;
+    if (retry >= 1 && retry <= 16)
+    {
+        delayMs = BASE_DELAY_MS << (retry - 1);
+        if (delayMs > MAX_DELAY_MS)
+        {
+            delayMs = MAX_DELAY_MS;
+        }
+    }
+    // Uniform in [0.75, 1.25] x delay
+    const unsigned long spread = delayMs / 2;
+    return delayMs - spread / 2 + nextRandom() % (spread + 1);
+}
+
+uint32_t RetryPolicy::nextRandom()
+{
+    m_rng ^= m_rng << 13;
+    m_rng ^= m_rng >> 17;
+    m_rng ^= m_rng << 5;
+    return m_rng;
+}
@@ -0,0 +1,157 @@
+/**
+ * @file retry_policy.h
+ * @brief Retry and cooldown policy for meter read sessions
+ *
+ * Decides how long to wait between the attempts of a read session, how many
+ * attempts a session may use, and how long to cool down after a session
+ * fails. Retries back off exponentially with jitter so several meters on one
+ * node (or several nodes near one meter) don't keep transmitting in lockstep.
+ * Attempts that are predicted to fail are skipped: a session that starts
+ * while the meter's wake window is known to be closed makes one attempt, and
+ * a meter that has missed several sessions in a row is only probed until it
+ * answers again. Each further failed session doubles the cooldown.
+ *
+ * This module is designed to be reusable across different projects (Arduino, ESPHome, etc.)
+ * and is independent of MQTT or WiFi dependencies.
+ */
+
+#ifndef RETRY_POLICY_H
+#define RETRY_POLICY_H
+
+#include <Arduino.h>
+
+/**
+ * @class RetryPolicy
+ * @brief Per-meter retry backoff, attempt budget and failure streak tracking
+ *
+ * The caller owns the attempt loop and timers; the policy only answers
+ * "retry after how long, or give up?" and keeps the counters. All times are
+ * millis() values.
+ */
+class RetryPolicy
+{
+public:
+    enum class State : uint8_t
+    {
+        Idle,     // No session running, no cooldown
+        Retrying, // Waiting for the next attempt of a session
+        Cooldown  // Last session failed, scheduled reads held off
+    };
+
+    static constexpr unsigned long BASE_DELAY_MS = 5000;  // First retry delay
+    static constexpr unsigned long MAX_DELAY_MS = 60000;  // Retry delay cap
+    static constexpr uint8_t MAX_COOLDOWN_DOUBLINGS = 3;  // Cooldown grows to at most 8x
+    static constexpr uint8_t UNRESPONSIVE_AFTER = 3;      // Failed sessions before the meter counts as unresponsive
+    static constexpr uint8_t UNRESPONSIVE_ATTEMPTS = 2;   // Attempt budget while unresponsive
+
+    RetryPolicy();
+
+    /**
+     * @brief Set the limits and jitter seed
+     * @param maxAttempts Attempts per session when the meter is healthy (>= 1)
+     * @param cooldownMs Cooldown after the first failed session
+     * @param seed Jitter seed; use something per meter, e.g. the serial number
+     */
+    void configure(int maxAttempts, unsigned long cooldownMs, uint32_t seed);
+
+    /**
+     * @brief Get the attempt budget for the current session
+     * @return maxAttempts, or UNRESPONSIVE_ATTEMPTS while the meter is unresponsive
+     */
+    int getAttemptBudget() const;
+
+    /**
+     * @brief Report a failed attempt and decide what happens next
+     *
+     * @param attemptsMade Attempts made so far in this session, including this one
+     * @param windowClosed true if the meter's wake window is known to be closed now
+     * @param nowMs Current millis()
+     * @return Delay before the next attempt, or 0 if the session has failed and
+     *         the cooldown has started
+     */
+    unsigned long onAttemptFailed(int attemptsMade, bool windowClosed, unsigned long nowMs);
+
+    /**
+     * @brief Report a successful attempt; clears the failure streak and cooldown
+     */
+    void onSuccess();
+
+    /**
+     * @brief Abandon the running session without counting it as failed
+     */
+    void cancel();
+
+    /**
+     * @brief Lift the cooldown without clearing the failure streak
+     */
+    void clearCooldown();
+
+    /**
+     * @brief Check if scheduled reads are held off after a failed session
+     * @param nowMs Current millis()
+     */
+    bool isCoolingDown(unsigned long nowMs) const;
+
+    /**
+     * @brief Get the time left in the cooldown
+     * @param nowMs Current millis()
+     * @return Milliseconds, 0 when not cooling down
+     */
+    unsigned long getCooldownRemainingMs(unsigned long nowMs) const;
+
+    /**
+     * @brief Get the current state
+     * @param nowMs Current millis()
+     */
+    State getState(unsigned long nowMs) const;
+
+    /**
+     * @brief Get a state name for logs and status messages
+     * @param nowMs Current millis()
+     */
+    const char *getStateName(unsigned long nowMs) const;
+
+    /**
+     * @brief Check if the meter has missed enough sessions to be only probed
+     */
+    bool isMeterUnresponsive() const { return m_failedStreak >= UNRESPONSIVE_AFTER; }
+
+    /// Sessions failed in a row since the last successful read
+    uint16_t getFailedStreak() const { return m_failedStreak; }
+    /// Length of the current (or last) cooldown in milliseconds
+    unsigned long getCooldownMs() const { return m_cooldownMs; }
+    /// Retry delay chosen for the last failed attempt in milliseconds
+    unsigned long getLastDelayMs() const { return m_lastDelayMs; }
+    /// Attempts reported to the policy (successful and failed)
+    unsigned long getAttempts() const { return m_attempts; }
+    /// Attempts not made because they were predicted to fail
+    unsigned long getSkippedAttempts() const { return m_skippedAttempts; }
+    /// Sessions that used up their budget
+    unsigned long getFailedSessions() const { return m_failedSessions; }
+
+private:
+    /**
+     * @brief Exponential delay for a retry with +/-25% jitter
+     * @param retry Retry number, 1 for the first retry
+     */
+    unsigned long backoffDelayMs(int retry);
+
+    uint32_t nextRandom();
+
+    int m_maxAttempts;
+    unsigned long m_baseCooldownMs;
+    uint32_t m_rng;
+
+    bool m_retrying;
+    unsigned long m_cooldownStart;
+    unsigned long m_cooldownMs; // 0 when no cooldown has started
+    bool m_coolingDown;
+    unsigned long m_lastDelayMs;
+    uint16_t m_failedStreak;
+
+    unsigned long m_attempts;
+    unsigned long m_skippedAttempts;
+    unsigned long m_failedSessions;
+};
+
+#endif // RETRY_POLICY_H
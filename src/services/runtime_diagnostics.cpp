@@ -0,0 +1,145 @@
+/**
+ * @file runtime_diagnostics.cpp
+ * @brief Implementation of the heap, stack and loop-block telemetry
+ */
+
+#include "runtime_diagnostics.h"
+#include "json_writer.h"
+#include <string.h>
+
+#if defined(ESP32)
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+namespace
+{
+void writeSnapshot(JsonWriter &json, const MemorySnapshot &snapshot)
+{
+    json.beginObject();
+    json.field("free_heap", (unsigned long)snapshot.freeHeap);
+    json.field("largest_block", (unsigned long)snapshot.largestFreeBlock);
+    json.field("frag_pct", (unsigned int)snapshot.fragmentationPct);
+    json.field("stack_free", (unsigned long)snapshot.stackFree);
+    json.endObject();
+}
+} // namespace
+
+RuntimeDiagnostics::RuntimeDiagnostics()
+    : m_last{}, m_beforeRead{}, m_afterRead{}, m_haveReadSnapshots(false),
+      m_minFreeHeap(UINT32_MAX), m_minStackFree(UINT32_MAX),
+      m_loopCount(0), m_maxLoopMs(0), m_loopHist{}
+{
+}
+
+MemorySnapshot RuntimeDiagnostics::readPlatform()
+{
+    MemorySnapshot snapshot = {};
+#if defined(ESP8266)
+    snapshot.freeHeap = ESP.getFreeHeap();
+    snapshot.largestFreeBlock = ESP.getMaxFreeBlockSize();
+    snapshot.fragmentationPct = ESP.getHeapFragmentation();
+    snapshot.stackFree = ESP.getFreeContStack();
+#elif defined(ESP32)
+    snapshot.freeHeap = ESP.getFreeHeap();
+    snapshot.largestFreeBlock = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+    snapshot.minFreeHeap = ESP.getMinFreeHeap();
+    snapshot.stackFree = uxTaskGetStackHighWaterMark(nullptr); // Bytes on ESP-IDF
+    if (snapshot.freeHeap > 0)
+    {
+        snapshot.fragmentationPct = (uint8_t)(100 - (uint32_t)((uint64_t)snapshot.largestFreeBlock * 100 / snapshot.freeHeap));
+    }
+#endif
+    return snapshot;
+}
+
+const MemorySnapshot &RuntimeDiagnostics::sample()
+{
+    recordSample(readPlatform());
+    return m_last;
+}
+
+void RuntimeDiagnostics::recordSample(const MemorySnapshot &snapshot)
+{
+    m_last = snapshot;
+    if (snapshot.freeHeap < m_minFreeHeap)
+    {
+        m_minFreeHeap = snapshot.freeHeap;
+    }
+    if (snapshot.minFreeHeap != 0 && snapshot.minFreeHeap < m_minFreeHeap)
+    {
+        m_minFreeHeap = snapshot.minFreeHeap;
+    }
+    if (snapshot.stackFree < m_minStackFree)
+    {
+        m_minStackFree = snapshot.stackFree;
+    }
+}
+
+void RuntimeDiagnostics::snapshotBeforeRead()
+{
+    m_beforeRead = sample();
+}
+
+void RuntimeDiagnostics::snapshotAfterRead()
+{
+    m_afterRead = sample();
+    m_haveReadSnapshots = true;
+}
+
+uint8_t RuntimeDiagnostics::loopBucketFor(uint32_t durationMs)
+{
+    uint8_t bits = 0;
+    while (durationMs != 0 && bits < LOOP_BUCKETS - 1)
+    {
+        durationMs >>= 1;
+        bits++;
+    }
+    return bits;
+}
+
+void RuntimeDiagnostics::recordLoop(uint32_t durationMs)
+{
+    m_loopCount++;
+    if (durationMs > m_maxLoopMs)
+    {
+        m_maxLoopMs = durationMs;
+    }
+    m_loopHist[loopBucketFor(durationMs)]++;
+}
+
+void RuntimeDiagnostics::writeJson(JsonWriter &json) const
+{
+    json.beginObject();
+    json.field("free_heap", (unsigned long)m_last.freeHeap);
+    json.field("largest_block", (unsigned long)m_last.largestFreeBlock);
+    json.field("frag_pct", (unsigned int)m_last.fragmentationPct);
+    json.field("min_free_heap", (unsigned long)(m_minFreeHeap == UINT32_MAX ? 0 : m_minFreeHeap));
+    json.field("stack_free", (unsigned long)(m_minStackFree == UINT32_MAX ? 0 : m_minStackFree));
+    json.field("loops", (unsigned long)m_loopCount);
+    json.field("loop_max_ms", (unsigned long)m_maxLoopMs);
+    json.key("loop_hist");
+    json.beginArray();
+    uint8_t used = LOOP_BUCKETS;
+    while (used > 0 && m_loopHist[used - 1] == 0)
+    {
+        used--;
+    }
+    for (uint8_t b = 0; b < used; b++)
+    {
+        json.value((unsigned long)m_loopHist[b]);
+    }
+    json.endArray();
+    if (m_haveReadSnapshots)
+    {
+        json.key("read");
+        json.beginObject();
+        json.key("before");
+        writeSnapshot(json, m_beforeRead);
+        json.key("after");
+        writeSnapshot(json, m_afterRead);
+        json.endObject();
+    }
+    json.endObject();
+}
@@ -0,0 +1,121 @@
+/**
+ * @file runtime_diagnostics.h
+ * @brief Heap, stack high-water and loop-block telemetry
+ *
+ * Tracks free heap, the largest free block (and the fragmentation it implies),
+ * the lowest free heap seen, the unused part of the loop task's stack and a
+ * histogram of how long the main loop was blocked. Memory is sampled
+ * periodically and just before and after each meter read, so the cost of a
+ * read (static radio buffers aside, which never show up as heap) and the stack
+ * depth it reaches can be compared with the idle state.
+ *
+ * Platform sources:
+ * - ESP8266: ESP.getFreeHeap(), getMaxFreeBlockSize(), getHeapFragmentation()
+ *   and getFreeContStack(), which scans the loop stack the core paints with a
+ *   guard pattern at boot; the minimum free heap is the lowest value sampled.
+ * - ESP32: ESP.getFreeHeap() and getMinFreeHeap(), the largest free 8-bit
+ *   capable block and uxTaskGetStackHighWaterMark() of the loop task.
+ * - Other targets (native tests) report zeros; samples can be fed in directly.
+ *
+ * Loop blocks go into power-of-two buckets in milliseconds: bucket b counts
+ * blocks whose duration has bit length b (bucket 0 is under 1 ms, bucket 1 is
+ * 1 ms, bucket 2 is 2-3 ms, ...); the last bucket also takes everything longer.
+ *
+ * This module is designed to be reusable across different projects (Arduino, ESPHome, etc.)
+ * and is independent of MQTT or WiFi dependencies.
+ */
+
+#ifndef RUNTIME_DIAGNOSTICS_H
+#define RUNTIME_DIAGNOSTICS_H
+
+#include <Arduino.h>
+
+class JsonWriter;
+
+/**
+ * @struct MemorySnapshot
+ * @brief Memory state at one point in time
+ */
+struct MemorySnapshot
+{
+    uint32_t freeHeap;         // Bytes free on the heap
+    uint32_t largestFreeBlock; // Largest single allocation that would succeed
+    uint8_t fragmentationPct;  // 100 - largest block as a percentage of free heap
+    uint32_t minFreeHeap;      // Platform's lowest free heap since boot, 0 if not tracked
+    uint32_t stackFree;        // Loop task stack never used since boot (high-water mark)
+};
+
+/**
+ * @class RuntimeDiagnostics
+ * @brief Memory samples, read snapshots and loop-block histogram
+ */
+class RuntimeDiagnostics
+{
+public:
+    static constexpr uint8_t LOOP_BUCKETS = 14; // Last bucket: 4096 ms and longer
+
+    RuntimeDiagnostics();
+
+    /// Read the platform counters (zeros on targets without them)
+    static MemorySnapshot readPlatform();
+
+    /// Sample the platform and fold it into the statistics
+    const MemorySnapshot &sample();
+
+    /// Fold a sample taken elsewhere into the statistics
+    void recordSample(const MemorySnapshot &snapshot);
+
+    /// Sample just before a meter read
+    void snapshotBeforeRead();
+
+    /// Sample just after a meter read
+    void snapshotAfterRead();
+
+    /**
+     * @brief Count one main-loop block
+     * @param durationMs How long the loop (or the meter reader's share of it) ran
+     */
+    void recordLoop(uint32_t durationMs);
+
+    const MemorySnapshot &getLast() const { return m_last; }
+    const MemorySnapshot &getBeforeRead() const { return m_beforeRead; }
+    const MemorySnapshot &getAfterRead() const { return m_afterRead; }
+    bool hasReadSnapshots() const { return m_haveReadSnapshots; }
+
+    /// Lowest free heap seen since boot (platform minimum or lowest sample)
+    uint32_t getMinFreeHeap() const { return m_minFreeHeap; }
+
+    /// Smallest stack headroom seen since boot
+    uint32_t getMinStackFree() const { return m_minStackFree; }
+
+    uint32_t getLoopCount() const { return m_loopCount; }
+    uint32_t getMaxLoopMs() const { return m_maxLoopMs; }
+    uint32_t getLoopBucket(uint8_t bucket) const { return bucket < LOOP_BUCKETS ? m_loopHist[bucket] : 0; }
+
+    /// Bucket index for a loop block (bit length of durationMs, capped)
+    static uint8_t loopBucketFor(uint32_t durationMs);
+
+    /**
+     * @brief Write the statistics as a JSON object
+     *
+     * {"free_heap":..,"largest_block":..,"frag_pct":..,"min_free_heap":..,"stack_free":..,
+     * "loops":..,"loop_max_ms":..,"loop_hist":[..],"read":{"before":{..},"after":{..}}}
+     * with the histogram trimmed after its last non-empty bucket and "read"
+     * present once a read has been snapshotted.
+     */
+    void writeJson(JsonWriter &json) const;
+
+private:
+    MemorySnapshot m_last;
+    MemorySnapshot m_beforeRead;
+    MemorySnapshot m_afterRead;
+    bool m_haveReadSnapshots;
+    uint32_t m_minFreeHeap;
+    uint32_t m_minStackFree;
+
+    uint32_t m_loopCount;
+    uint32_t m_maxLoopMs;
+    uint32_t m_loopHist[LOOP_BUCKETS];
+};
+
+#endif // RUNTIME_DIAGNOSTICS_H
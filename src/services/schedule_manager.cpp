@@ -6,8 +6,26 @@
 #include "schedule_manager.h"
 #include "../core/logging.h"
 
+// Indexed by tm_wday (0=Sunday)
+static const char *const DAY_NAMES[7] = {
+    "Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday"};
+
+// Prefixes for monthly "Nth weekday" schedules, e.g. "First-Monday", "Last-Friday"
+static const struct
+{
+    const char *prefix;
+    uint8_t occurrences;
+} NTH_PREFIXES[] = {
+    {"First-", 0x01},
+    {"Second-", 0x02},
+    {"Third-", 0x04},
+    {"Fourth-", 0x08},
+    {"Last-", ScheduleMask::LAST},
+};
+
 // Static member initialization
 const char *ScheduleManager::s_schedule = "Monday-Friday";
+ScheduleMask ScheduleManager::s_mask = {0x3E, ScheduleMask::EVERY_WEEK}; // Monday-Friday
 int ScheduleManager::s_readHourUtc = 10;
 int ScheduleManager::s_readMinuteUtc = 0;
 int ScheduleManager::s_readHourLocal = 10;
@@ -26,21 +44,74 @@ void ScheduleManager::begin(const char *schedule, int readHourUtc, int readMinut
 
 bool ScheduleManager::isValidSchedule(const char *schedule)
 {
-    return (strcmp(schedule, "Monday-Friday") == 0 ||
-            strcmp(schedule, "Monday-Saturday") == 0 ||
-            strcmp(schedule, "Monday-Sunday") == 0 ||
-            strcmp(schedule, "Monday") == 0 ||
-            strcmp(schedule, "Tuesday") == 0 ||
-            strcmp(schedule, "Wednesday") == 0 ||
-            strcmp(schedule, "Thursday") == 0 ||
-            strcmp(schedule, "Friday") == 0 ||
-            strcmp(schedule, "Saturday") == 0 ||
-            strcmp(schedule, "Sunday") == 0);
+    ScheduleMask mask;
+    return compileSchedule(schedule, mask);
+}
+
+bool ScheduleManager::compileSchedule(const char *schedule, ScheduleMask &mask)
+{
+    mask.weekdays = 0;
+    mask.occurrences = ScheduleMask::EVERY_WEEK;
+
+    if (!schedule)
+        return false;
+
+    // Presets
+    if (strcmp(schedule, "Monday-Friday") == 0)
+    {
+        mask.weekdays = 0x3E; // Monday..Friday
+        return true;
+    }
+    if (strcmp(schedule, "Monday-Saturday") == 0)
+    {
+        mask.weekdays = 0x7E; // Monday..Saturday
+        return true;
+    }
+    if (strcmp(schedule, "Monday-Sunday") == 0)
+    {
+        mask.weekdays = 0x7F; // All days
+        return true;
+    }
+
+    // Optional "Nth-" prefix selects a monthly rule
+    const char *dayName = schedule;
+    uint8_t occurrences = ScheduleMask::EVERY_WEEK;
+    for (const auto &nth : NTH_PREFIXES)
+    {
+        size_t len = strlen(nth.prefix);
+        if (strncmp(schedule, nth.prefix, len) == 0)
+        {
+            dayName = schedule + len;
+            occurrences = nth.occurrences;
+            break;
+        }
+    }
+
+    for (int day = 0; day < 7; day++)
+    {
+        if (strcmp(dayName, DAY_NAMES[day]) == 0)
+        {
+            mask.weekdays = (uint8_t)(1u << day);
+            mask.occurrences = occurrences;
+            return true;
+        }
+    }
+
+    return false;
 }
 
 void ScheduleManager::setSchedule(const char *schedule)
 {
-    if (isValidSchedule(schedule))
+    if (!schedule)
+    {
+        // No schedule at all: disable scheduled reads rather than guess
+        LOG_W("everblu_meter", "No reading schedule set - scheduled reads disabled");
+        s_schedule = "";
+        compileSchedule(nullptr, s_mask);
+        return;
+    }
+
+    if (compileSchedule(schedule, s_mask))
     {
         s_schedule = schedule;
         LOG_I("everblu_meter", "Reading schedule set to: %s", s_schedule);
@@ -49,6 +120,7 @@ void ScheduleManager::setSchedule(const char *schedule)
     {
         LOG_W("everblu_meter", "Invalid schedule '%s' - falling back to 'Monday-Friday'", schedule);
         s_schedule = "Monday-Friday";
+        compileSchedule(s_schedule, s_mask);
     }
 }
 
@@ -63,39 +135,92 @@ bool ScheduleManager::isReadingDay(struct tm *ptm)
         return false;
 
     // ptm->tm_wday: 0=Sunday, 1=Monday, ..., 6=Saturday
-    int dayOfWeek = ptm->tm_wday;
+    return matchesDay(s_mask, ptm->tm_wday, ptm->tm_mday, daysInMonth(ptm->tm_year + 1900, ptm->tm_mon + 1));
+}
 
-    if (strcmp(s_schedule, "Monday-Friday") == 0)
-    {
-        return dayOfWeek >= 1 && dayOfWeek <= 5; // Monday-Friday
-    }
-    else if (strcmp(s_schedule, "Monday-Saturday") == 0)
-    {
-        return dayOfWeek >= 1 && dayOfWeek <= 6; // Monday-Saturday
-    }
-    else if (strcmp(s_schedule, "Monday-Sunday") == 0)
+time_t ScheduleManager::computeNextFireUtc(time_t fromUtc, const ScheduleMask &mask, int readHourUtc,
+                                           int readMinuteUtc, int timezoneOffsetMinutes)
+{
+    static const time_t SECONDS_PER_DAY = 24 * 60 * 60;
+
+    if (mask.weekdays == 0 || fromUtc <= 0)
+        return 0;
+
+    const time_t offsetSec = (time_t)timezoneOffsetMinutes * 60;
+
+    // Reading time of day in the local-offset frame, which is where the
+    // weekday of the schedule is evaluated
+    time_t readSecLocal = ((time_t)constrain(readHourUtc, 0, 23) * 3600 +
+                           (time_t)constrain(readMinuteUtc, 0, 59) * 60 + offsetSec) %
+                          SECONDS_PER_DAY;
+    if (readSecLocal < 0)
+        readSecLocal += SECONDS_PER_DAY;
+
+    const time_t fromLocal = fromUtc + offsetSec;
+    time_t day = fromLocal / SECONDS_PER_DAY;
+
+    // Weekly rules need at most 8 candidates (single day whose time has
+    // passed today); monthly rules can be up to 35 days apart
+    const bool weekly = (mask.occurrences & ScheduleMask::EVERY_WEEK) == ScheduleMask::EVERY_WEEK;
+    const int maxDays = weekly ? 8 : 37;
+
+    for (int i = 0; i < maxDays; i++, day++)
     {
-        return true; // All days including Sunday (dayOfWeek 0-6)
+        const time_t candidateLocal = day * SECONDS_PER_DAY + readSecLocal;
+        if (candidateLocal < fromLocal)
+            continue;
+
+        const int dayOfWeek = (int)((day + 4) % 7); // 1970-01-01 was a Thursday
+        int dayOfMonth = 1;
+        int monthDays = 31;
+        if (!weekly)
+        {
+            // Civil date from days since epoch (H. Hinnant's algorithm)
+            const long z = (long)day + 719468;
+            const long era = z / 146097;
+            const long doe = z - era * 146097;
+            const long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+            const long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+            const long mp = (5 * doy + 2) / 153;
+            const int month = (int)(mp < 10 ? mp + 3 : mp - 9);
+            const int year = (int)(yoe + era * 400 + (month <= 2 ? 1 : 0));
+            dayOfMonth = (int)(doy - (153 * mp + 2) / 5 + 1);
+            monthDays = daysInMonth(year, month);
+        }
+
+        if (matchesDay(mask, dayOfWeek, dayOfMonth, monthDays))
+        {
+            return candidateLocal - offsetSec;
+        }
     }
-    // check for single day reading schedule
-    switch (dayOfWeek)
+
+    return 0;
+}
+
+time_t ScheduleManager::computeNextFireUtc(time_t fromUtc, const char *schedule, int readHourUtc,
+                                           int readMinuteUtc, int timezoneOffsetMinutes)
+{
+    ScheduleMask mask;
+    if (!compileSchedule(schedule, mask))
+        return 0;
+    return computeNextFireUtc(fromUtc, mask, readHourUtc, readMinuteUtc, timezoneOffsetMinutes);
+}
+
+time_t ScheduleManager::computeNextFireUtc(time_t fromUtc)
+{
+    return computeNextFireUtc(fromUtc, s_mask, s_readHourUtc, s_readMinuteUtc, s_timezoneOffsetMinutes);
+}
+
+time_t ScheduleManager::startOfNextLocalDayUtc(time_t utc, int timezoneOffsetMinutes)
+{
+    const int64_t offsetSec = (int64_t)timezoneOffsetMinutes * 60;
+    const int64_t local = (int64_t)utc + offsetSec;
+    int64_t day = local / 86400;
+    if (local % 86400 < 0)
     {
-    case 0:
-        return strcmp(s_schedule, "Sunday") == 0;
-    case 1:
-        return strcmp(s_schedule, "Monday") == 0;
-    case 2:
-        return strcmp(s_schedule, "Tuesday") == 0;
-    case 3:
-        return strcmp(s_schedule, "Wednesday") == 0;
-    case 4:
-        return strcmp(s_schedule, "Thursday") == 0;
-    case 5:
-        return strcmp(s_schedule, "Friday") == 0;
-    case 6:
-        return strcmp(s_schedule, "Saturday") == 0;
+        day--;
     }
-    return false;
+    return (time_t)((day + 1) * 86400 - offsetSec);
 }
 
 void ScheduleManager::setReadingTimeFromLocal(int hourLocal, int minuteLocal)
@@ -177,6 +302,16 @@ void ScheduleManager::setTimezoneOffset(int offsetMinutes)
     LOG_I("everblu_meter", "Timezone offset set to %d minutes", s_timezoneOffsetMinutes);
 }
 
+int ScheduleManager::daysInMonth(int year, int month)
+{
+    static const uint8_t DAYS[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    if (month < 1 || month > 12)
+        return 31;
+    if (month == 2 && ((year % 4 == 0 && year % 100 != 0) || year % 400 == 0))
+        return 29;
+    return DAYS[month - 1];
+}
+
 void ScheduleManager::recalculateLocalFromUtc()
 {
     int totalUtcMin = s_readHourUtc * 60 + s_readMinuteUtc;
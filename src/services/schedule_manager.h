@@ -3,7 +3,8 @@
  * @brief Daily reading schedule management
  *
  * Handles scheduled meter readings with support for different reading patterns
- * (weekdays, weekdays + Saturday, daily). Manages time zone conversions between
+ * (weekdays, weekdays + Saturday, daily, single day, Nth weekday of the month).
+ * Manages time zone conversions between
  * UTC and local time, and auto-alignment of reading times to meter wake windows.
  *
  * This module is designed to be reusable across different projects (Arduino, ESPHome, etc.)
@@ -16,15 +17,33 @@
 #include <Arduino.h>
 #include <time.h>
 
+/**
+ * @struct ScheduleMask
+ * @brief Reading schedule compiled into day bitmaps
+ *
+ * Built once from the schedule name, so checking a day is a bit test and new
+ * schedule types add no per-check parsing cost.
+ */
+struct ScheduleMask
+{
+    static constexpr uint8_t EVERY_WEEK = 0x1F; ///< Occurrences 1-5: every matching weekday
+    static constexpr uint8_t LAST = 0x20;       ///< Last occurrence of the weekday in the month
+
+    uint8_t weekdays;    ///< Bit n set = read on tm_wday n (bit 0 = Sunday), 0 = never
+    uint8_t occurrences; ///< Bit n set = (n+1)th occurrence in the month, plus LAST
+};
+
 /**
  * @class ScheduleManager
  * @brief Manages daily meter reading schedules with timezone support
  *
  * Provides reading schedule validation, timezone conversion, and automatic
- * alignment to meter wake windows. Supports three reading patterns:
+ * alignment to meter wake windows. Supports these reading patterns:
  * - "Monday-Friday" (weekdays only)
  * - "Monday-Saturday" (weekdays plus Saturday)
  * - "Monday-Sunday" (daily)
+ * - "Monday".."Sunday" (one day a week)
+ * - "First-Monday".."Fourth-Sunday", "Last-Monday".."Last-Sunday" (monthly)
  */
 class ScheduleManager
 {
@@ -43,14 +62,46 @@ public:
      * @brief Validate a reading schedule string
      *
      * @param schedule Schedule string to validate
-     * @return true if schedule is valid ("Monday-Friday", "Monday-Saturday", or "Monday-Sunday")
+     * @return true if schedule is a preset, a day name or an Nth weekday rule
      */
     static bool isValidSchedule(const char *schedule);
 
+    /**
+     * @brief Compile a reading schedule string into day bitmaps
+     *
+     * @param schedule Schedule string (case-sensitive, as accepted by isValidSchedule())
+     * @param mask Output: compiled schedule, or an empty mask when invalid
+     * @return true if the schedule was recognised
+     */
+    static bool compileSchedule(const char *schedule, ScheduleMask &mask);
+
+    /**
+     * @brief Check if a calendar day is covered by a compiled schedule
+     *
+     * @param mask Compiled schedule
+     * @param dayOfWeek Day of the week (0=Sunday, 1=Monday, ..., 6=Saturday)
+     * @param dayOfMonth Day of the month (1-31)
+     * @param daysInMonth Number of days in that month (28-31)
+     * @return true if a reading is due on that day
+     */
+    static inline bool matchesDay(const ScheduleMask &mask, int dayOfWeek, int dayOfMonth, int daysInMonth)
+    {
+        if ((mask.weekdays & (1u << dayOfWeek)) == 0)
+            return false;
+        if ((mask.occurrences & ScheduleMask::EVERY_WEEK) == ScheduleMask::EVERY_WEEK)
+            return true;
+
+        uint8_t occurrence = 1u << ((dayOfMonth - 1) / 7);
+        if (dayOfMonth + 7 > daysInMonth)
+            occurrence |= ScheduleMask::LAST;
+        return (mask.occurrences & occurrence) != 0;
+    }
+
     /**
      * @brief Set and validate the reading schedule
      *
-     * Falls back to "Monday-Friday" if invalid schedule is provided.
+     * Falls back to "Monday-Friday" if invalid schedule is provided. A null
+     * schedule disables scheduled reads.
      *
      * @param schedule Reading schedule string
      */
@@ -71,6 +122,55 @@ public:
      */
     static bool isReadingDay(struct tm *ptm);
 
+    /**
+     * @brief Compute the next scheduled reading as an absolute UTC timestamp
+     *
+     * Walks forward from fromUtc to the first reading day whose reading time
+     * (evaluated in local-offset time) is at or after fromUtc. Uses integer
+     * arithmetic only, so callers can cache the result and compare it against
+     * the current epoch until the configuration or the clock changes.
+     *
+     * @param fromUtc Earliest acceptable fire time (UTC epoch seconds)
+     * @param mask Compiled reading schedule
+     * @param readHourUtc Reading hour in UTC (0-23)
+     * @param readMinuteUtc Reading minute in UTC (0-59)
+     * @param timezoneOffsetMinutes Timezone offset from UTC in minutes
+     * @return UTC epoch of the next reading, or 0 if the schedule matches no day
+     */
+    static time_t computeNextFireUtc(time_t fromUtc, const ScheduleMask &mask, int readHourUtc,
+                                     int readMinuteUtc, int timezoneOffsetMinutes);
+
+    /**
+     * @brief Compute the next scheduled reading from a schedule string
+     *
+     * Convenience overload that compiles the schedule first. Prefer caching a
+     * ScheduleMask when called repeatedly.
+     *
+     * @return UTC epoch of the next reading, or 0 if the schedule is invalid
+     */
+    static time_t computeNextFireUtc(time_t fromUtc, const char *schedule, int readHourUtc,
+                                     int readMinuteUtc, int timezoneOffsetMinutes);
+
+    /**
+     * @brief Compute the next scheduled reading using the current schedule state
+     *
+     * @param fromUtc Earliest acceptable fire time (UTC epoch seconds)
+     * @return UTC epoch of the next reading, or 0 if the schedule matches no day
+     */
+    static time_t computeNextFireUtc(time_t fromUtc);
+
+    /**
+     * @brief Get the start of the local-offset day after a given time
+     *
+     * Used when the reading time moves after a read, so the new slot starts
+     * on the following day instead of firing a second time today.
+     *
+     * @param utc UTC epoch seconds
+     * @param timezoneOffsetMinutes Timezone offset from UTC in minutes
+     * @return UTC epoch of the next local-offset midnight
+     */
+    static time_t startOfNextLocalDayUtc(time_t utc, int timezoneOffsetMinutes);
+
     /**
      * @brief Update reading time from local (UTC+offset) time
      *
@@ -143,6 +243,7 @@ public:
 
 private:
     static const char *s_schedule;
+    static ScheduleMask s_mask;
     static int s_readHourUtc;
     static int s_readMinuteUtc;
     static int s_readHourLocal;
@@ -150,6 +251,7 @@ private:
     static int s_timezoneOffsetMinutes;
 
     // Helper functions
+    static int daysInMonth(int year, int month);
     static void recalculateLocalFromUtc();
     static void recalculateUtcFromLocal();
 
@@ -0,0 +1,154 @@
+/**
+ * @file spi_stats.cpp
+ * @brief Implementation of the SPI transaction counters
+ */
+
+#include "spi_stats.h"
+#include "json_writer.h"
+#include <string.h>
+
+namespace
+{
+const char *const OP_NAMES[(size_t)SpiOp::Count] = {
+    "single_read",
+    "single_write",
+    "burst_read",
+    "burst_write",
+    "strobe",
+};
+
+// CC1101 header byte: bit 7 read, bit 6 burst (also set for status registers,
+// which are single reads, so the length decides single against burst)
+const uint8_t HEADER_READ = 0x80;
+} // namespace
+
+SpiStats::SpiStats()
+    : m_ops{}
+{
+}
+
+SpiOp SpiStats::classify(uint8_t header, int len)
+{
+    if (len <= 1)
+    {
+        return SpiOp::Strobe;
+    }
+    const bool read = (header & HEADER_READ) != 0;
+    if (len == 2)
+    {
+        return read ? SpiOp::SingleRead : SpiOp::SingleWrite;
+    }
+    return read ? SpiOp::BurstRead : SpiOp::BurstWrite;
+}
+
+uint8_t SpiStats::bucketFor(uint32_t durationUs)
+{
+    uint8_t bits = 0;
+    while (durationUs != 0 && bits < SpiOpStats::BUCKETS - 1)
+    {
+        durationUs >>= 1;
+        bits++;
+    }
+    return bits;
+}
+
+void SpiStats::record(SpiOp op, int len, uint32_t durationUs)
+{
+    if (op >= SpiOp::Count)
+    {
+        return;
+    }
+    SpiOpStats &stats = m_ops[(size_t)op];
+    stats.count++;
+    stats.bytes += len > 0 ? (uint32_t)len : 0;
+    stats.totalUs += durationUs;
+    if (durationUs > stats.maxUs)
+    {
+        stats.maxUs = durationUs;
+    }
+    uint16_t &bucket = stats.hist[bucketFor(durationUs)];
+    if (bucket != UINT16_MAX)
+    {
+        bucket++;
+    }
+}
+
+void SpiStats::reset()
+{
+    memset(m_ops, 0, sizeof(m_ops));
+}
+
+const SpiOpStats &SpiStats::get(SpiOp op) const
+{
+    return m_ops[op < SpiOp::Count ? (size_t)op : 0];
+}
+
+uint32_t SpiStats::totalCount() const
+{
+    uint32_t total = 0;
+    for (const SpiOpStats &stats : m_ops)
+    {
+        total += stats.count;
+    }
+    return total;
+}
+
+uint32_t SpiStats::totalUs() const
+{
+    uint32_t total = 0;
+    for (const SpiOpStats &stats : m_ops)
+    {
+        total += stats.totalUs;
+    }
+    return total;
+}
+
+void SpiStats::writeJson(JsonWriter &json) const
+{
+    uint32_t bytes = 0;
+    for (const SpiOpStats &stats : m_ops)
+    {
+        bytes += stats.bytes;
+    }
+
+    json.beginObject();
+    json.field("n", (unsigned long)totalCount());
+    json.field("bytes", (unsigned long)bytes);
+    json.field("us", (unsigned long)totalUs());
+    json.key("ops");
+    json.beginObject();
+    for (size_t op = 0; op < (size_t)SpiOp::Count; op++)
+    {
+        const SpiOpStats &stats = m_ops[op];
+        if (stats.count == 0)
+        {
+            continue;
+        }
+        json.key(OP_NAMES[op]);
+        json.beginObject();
+        json.field("n", (unsigned long)stats.count);
+        json.field("bytes", (unsigned long)stats.bytes);
+        json.field("us", (unsigned long)stats.totalUs);
+        json.field("max_us", (unsigned long)stats.maxUs);
+        json.key("hist");
+        json.beginArray();
+        uint8_t used = SpiOpStats::BUCKETS;
+        while (used > 0 && stats.hist[used - 1] == 0)
+        {
+            used--;
+        }
+        for (uint8_t b = 0; b < used; b++)
+        {
+            json.value((unsigned int)stats.hist[b]);
+        }
+        json.endArray();
+        json.endObject();
+    }
+    json.endObject();
+    json.endObject();
+}
+
+const char *SpiStats::opName(SpiOp op)
+{
+    return op < SpiOp::Count ? OP_NAMES[(size_t)op] : "unknown";
+}
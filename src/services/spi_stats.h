@@ -0,0 +1,111 @@
+/**
+ * @file spi_stats.h
+ * @brief SPI transaction counters and log2 latency histograms per operation type
+ *
+ * The radio driver funnels every CC1101 access through one SPI transfer
+ * function. Timing each transfer there, and sorting it by what it did (single
+ * register read or write, burst read or write, command strobe), shows how
+ * many transactions a meter read costs and how long the bus path takes, which
+ * on ESPHome includes the SPIDevice enable()/disable() bookkeeping. Driver
+ * changes such as register caching or fewer burst reconfigurations can then be
+ * compared on real hardware by the counts and histograms before and after.
+ *
+ * Latencies go into power-of-two buckets: bucket b counts transfers whose
+ * duration in microseconds has bit length b (bucket 0 is 0 us, bucket 1 is
+ * 1 us, bucket 2 is 2-3 us, bucket 3 is 4-7 us, ...); the last bucket also
+ * takes everything longer.
+ *
+ * This module is designed to be reusable across different projects (Arduino, ESPHome, etc.)
+ * and is independent of MQTT or WiFi dependencies.
+ */
+
+#ifndef SPI_STATS_H
+#define SPI_STATS_H
+
+#include <Arduino.h>
+
+class JsonWriter;
+
+/**
+ * @enum SpiOp
+ * @brief Kind of SPI transaction, from the CC1101 header byte and length
+ */
+enum class SpiOp : uint8_t
+{
+    SingleRead,  // Header plus one register or status byte read
+    SingleWrite, // Header plus one register byte written
+    BurstRead,   // Header plus several bytes read (RX FIFO, register dump)
+    BurstWrite,  // Header plus several bytes written (TX FIFO, PATABLE)
+    Strobe,      // Command strobe, header only
+    Count
+};
+
+/**
+ * @struct SpiOpStats
+ * @brief Counters of one operation type
+ */
+struct SpiOpStats
+{
+    static constexpr uint8_t BUCKETS = 16;
+
+    uint32_t count;         // Transactions
+    uint32_t bytes;         // Bytes clocked, header included
+    uint32_t totalUs;       // Sum of durations
+    uint32_t maxUs;         // Longest transaction
+    uint16_t hist[BUCKETS]; // Log2 latency buckets (saturating)
+};
+
+/**
+ * @class SpiStats
+ * @brief Per-operation SPI counters, normally reset at the start of each read
+ */
+class SpiStats
+{
+public:
+    SpiStats();
+
+    /**
+     * @brief Classify a transfer before it is clocked out
+     * @param header First byte sent (address with the read and burst bits)
+     * @param len Transfer length including the header
+     */
+    static SpiOp classify(uint8_t header, int len);
+
+    /**
+     * @brief Count one transaction
+     * @param op Operation type
+     * @param len Bytes clocked, header included
+     * @param durationUs Time from before enable/beginTransaction to after disable/endTransaction
+     */
+    void record(SpiOp op, int len, uint32_t durationUs);
+
+    void reset();
+
+    const SpiOpStats &get(SpiOp op) const;
+
+    /// Transactions of all types
+    uint32_t totalCount() const;
+
+    /// Time spent in SPI transfers of all types
+    uint32_t totalUs() const;
+
+    /**
+     * @brief Write the counters as a JSON object
+     *
+     * {"n":812,"bytes":2950,"us":8123,"ops":{"single_read":{"n":..,"bytes":..,"us":..,
+     * "max_us":..,"hist":[..]},...}} with each histogram trimmed after its last
+     * non-empty bucket; operation types with no transactions are omitted.
+     */
+    void writeJson(JsonWriter &json) const;
+
+    /// snake_case name used in the JSON, e.g. "burst_read"
+    static const char *opName(SpiOp op);
+
+    /// Bucket index for a duration (bit length of durationUs, capped)
+    static uint8_t bucketFor(uint32_t durationUs);
+
+private:
+    SpiOpStats m_ops[(size_t)SpiOp::Count];
+};
+
+#endif // SPI_STATS_H
@@ -58,6 +58,31 @@ esphome::ESPPreferenceObject &getFloatPref(uint32_t hash)
     cache.emplace_back(hash, esphome::global_preferences->make_preference<FloatStorage>(hash, true));
     return cache.back().second;
 }
+
+// Fixed-size record for saveBlob()/loadBlob(). Every blob uses the same struct
+// so the preference length never changes; the real record size is in length.
+struct BlobStorage
+{
+    uint16_t magic_number;
+    uint16_t length;
+    uint8_t data[StorageAbstraction::BLOB_MAX_SIZE];
+};
+
+// Same caching and in_flash rules as getFloatPref(), kept separate because the
+// preference type (and therefore its size) differs.
+esphome::ESPPreferenceObject &getBlobPref(uint32_t hash)
+{
+    static std::vector<std::pair<uint32_t, esphome::ESPPreferenceObject>> cache;
+    for (auto &entry : cache)
+    {
+        if (entry.first == hash)
+        {
+            return entry.second;
+        }
+    }
+    cache.emplace_back(hash, esphome::global_preferences->make_preference<BlobStorage>(hash, true));
+    return cache.back().second;
+}
 } // namespace
 #endif
 
@@ -307,6 +332,198 @@ float StorageAbstraction::loadFloat(const char *key, float defaultValue, uint16_
 #endif
 }
 
+bool StorageAbstraction::saveBlob(const char *key, const void *data, size_t size, uint16_t magic)
+{
+    if (size > BLOB_MAX_SIZE)
+    {
+        LOG_E("everblu_meter", "Cannot save %s: %u bytes exceeds the %u byte limit", key,
+              (unsigned)size, (unsigned)BLOB_MAX_SIZE);
+        return false;
+    }
+
+#ifdef EVERBLU_USE_ESPHOME_PREFS
+    if (esphome::global_preferences == nullptr)
+    {
+        LOG_E("everblu_meter", "Cannot save %s: global_preferences is null!", key);
+        return false;
+    }
+
+    BlobStorage storage{};
+    storage.magic_number = magic;
+    storage.length = static_cast<uint16_t>(size);
+    memcpy(storage.data, data, size);
+
+    esphome::ESPPreferenceObject &pref = getBlobPref(esphome::fnv1_hash(key));
+    bool success = pref.save(&storage);
+    if (success)
+    {
+        // Leave the flash sync to ESPHome's periodic flush: blobs are written
+        // after every read session and losing the last one on a crash is harmless
+        LOG_D("everblu_meter", "Saved %s (%u bytes) to ESPHome preferences", key, (unsigned)size);
+    }
+    else
+    {
+        LOG_E("everblu_meter", "Failed to save %s to ESPHome preferences", key);
+    }
+    return success;
+
+#elif defined(ESP8266)
+    // ESP8266: single blob slot after the frequency offset
+    if (BLOB_ADDR + 4 + size > EEPROM_SIZE)
+    {
+        LOG_E("everblu_meter", "Cannot save %s: EEPROM blob slot too small", key);
+        return false;
+    }
+    EEPROM.put(BLOB_ADDR, magic);
+    EEPROM.put(BLOB_ADDR + 2, static_cast<uint16_t>(size));
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < size; i++)
+    {
+        EEPROM.write(BLOB_ADDR + 4 + i, bytes[i]);
+    }
+    bool success = EEPROM.commit();
+    if (!success)
+    {
+        LOG_E("everblu_meter", "Failed to save %s to EEPROM", key);
+    }
+    return success;
+
+#elif defined(ESP32)
+    if (!keyFits(key))
+    {
+        LOG_E("everblu_meter", "Cannot save %s: key longer than %u characters", key, (unsigned)KEY_MAX_LEN);
+        return false;
+    }
+    preferences.begin("everblu", false);
+    char magicKey[32];
+    snprintf(magicKey, sizeof(magicKey), "%s_magic", key);
+    bool success = preferences.putUShort(magicKey, magic) == sizeof(uint16_t);
+    size_t written = preferences.putBytes(key, data, size);
+    preferences.end();
+
+    success = success && (written == size);
+    if (!success)
+    {
+        LOG_E("everblu_meter", "Failed to save %s to Preferences", key);
+    }
+    return success;
+
+#else
+    (void)data;
+    (void)magic;
+    return false;
+#endif
+}
+
+bool StorageAbstraction::loadBlob(const char *key, void *data, size_t size, uint16_t magic)
+{
+    if (size > BLOB_MAX_SIZE)
+    {
+        return false;
+    }
+
+#ifdef EVERBLU_USE_ESPHOME_PREFS
+    if (esphome::global_preferences == nullptr)
+    {
+        return false;
+    }
+
+    BlobStorage storage{};
+    esphome::ESPPreferenceObject &pref = getBlobPref(esphome::fnv1_hash(key));
+    if (!pref.load(&storage) || storage.magic_number != magic || storage.length != size)
+    {
+        LOG_I("everblu_meter", "No valid data for %s in ESPHome preferences", key);
+        return false;
+    }
+    memcpy(data, storage.data, size);
+    return true;
+
+#elif defined(ESP8266)
+    uint16_t storedMagic = 0;
+    uint16_t storedSize = 0;
+    EEPROM.get(BLOB_ADDR, storedMagic);
+    EEPROM.get(BLOB_ADDR + 2, storedSize);
+    if (storedMagic != magic || storedSize != size || BLOB_ADDR + 4 + size > EEPROM_SIZE)
+    {
+        LOG_I("everblu_meter", "No valid data for %s in EEPROM", key);
+        return false;
+    }
+    uint8_t *bytes = static_cast<uint8_t *>(data);
+    for (size_t i = 0; i < size; i++)
+    {
+        bytes[i] = EEPROM.read(BLOB_ADDR + 4 + i);
+    }
+    return true;
+
+#elif defined(ESP32)
+    if (!keyFits(key))
+    {
+        return false;
+    }
+    preferences.begin("everblu", true);
+    char magicKey[32];
+    snprintf(magicKey, sizeof(magicKey), "%s_magic", key);
+    bool valid = preferences.getUShort(magicKey, 0) == magic && preferences.getBytesLength(key) == size;
+    if (valid)
+    {
+        valid = preferences.getBytes(key, data, size) == size;
+    }
+    preferences.end();
+    if (!valid)
+    {
+        LOG_I("everblu_meter", "No valid data for %s in Preferences", key);
+    }
+    return valid;
+
+#else
+    (void)key;
+    (void)data;
+    (void)magic;
+    return false;
+#endif
+}
+
+bool StorageAbstraction::saveUint32(const char *key, uint32_t value, uint16_t magic)
+{
+#if defined(ESP8266) && !defined(EVERBLU_USE_ESPHOME_PREFS)
+    uint32_t stored = 0;
+    uint16_t storedMagic = 0;
+    EEPROM.get(WORD_ADDR, storedMagic);
+    EEPROM.get(WORD_ADDR + 2, stored);
+    if (storedMagic == magic && stored == value)
+    {
+        return true; // Unchanged: spare the flash sector an erase
+    }
+    EEPROM.put(WORD_ADDR, magic);
+    EEPROM.put(WORD_ADDR + 2, value);
+    bool success = EEPROM.commit();
+    if (!success)
+    {
+        LOG_E("everblu_meter", "Failed to save %s to EEPROM", key);
+    }
+    return success;
+#else
+    return saveBlob(key, &value, sizeof(value), magic);
+#endif
+}
+
+bool StorageAbstraction::loadUint32(const char *key, uint32_t &value, uint16_t magic)
+{
+#if defined(ESP8266) && !defined(EVERBLU_USE_ESPHOME_PREFS)
+    uint16_t storedMagic = 0;
+    EEPROM.get(WORD_ADDR, storedMagic);
+    if (storedMagic != magic)
+    {
+        LOG_I("everblu_meter", "No valid data for %s in EEPROM", key);
+        return false;
+    }
+    EEPROM.get(WORD_ADDR + 2, value);
+    return true;
+#else
+    return loadBlob(key, &value, sizeof(value), magic);
+#endif
+}
+
 bool StorageAbstraction::hasKey(const char *key)
 {
 #ifdef EVERBLU_USE_ESPHOME_PREFS
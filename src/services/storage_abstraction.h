@@ -65,6 +65,69 @@ public:
     static float loadFloat(const char *key, float defaultValue = 0.0, uint16_t magic = 0xABCD,
                            float minValue = -999999.0, float maxValue = 999999.0);
 
+    /**
+     * @brief Save a small binary record to persistent storage
+     *
+     * Stores up to BLOB_MAX_SIZE bytes (e.g. a packed statistics struct) with a
+     * magic number and length, so a record written by an older layout is
+     * rejected on load instead of being misread. ESP8266 EEPROM has a single
+     * blob slot, which is enough for the standalone single-meter build.
+     *
+     * @param key Storage key/identifier (e.g., "slot_hist", max KEY_MAX_LEN chars on ESP32, longer keys are rejected)
+     * @param data Bytes to store
+     * @param size Number of bytes (at most BLOB_MAX_SIZE)
+     * @param magic Magic number for validation
+     * @return true if save succeeded, false on error or oversized record
+     */
+    static bool saveBlob(const char *key, const void *data, size_t size, uint16_t magic);
+
+    /**
+     * @brief Load a binary record saved with saveBlob()
+     *
+     * @param key Storage key/identifier
+     * @param data Output buffer, left untouched unless the load succeeds
+     * @param size Expected record size; a stored record of another size is rejected
+     * @param magic Expected magic number
+     * @return true if a record with matching magic and size was loaded
+     */
+    static bool loadBlob(const char *key, void *data, size_t size, uint16_t magic);
+
+    /**
+     * @brief Save a 32-bit value (e.g. a content hash) to persistent storage
+     *
+     * ESP8266 EEPROM has a single word slot, like the float slot; ESP32 and
+     * ESPHome store it as a blob under its own key.
+     *
+     * @param key Storage key/identifier (max 9 chars on ESP32)
+     * @param value Value to store
+     * @param magic Magic number for validation
+     * @return true if save succeeded, false on error
+     */
+    static bool saveUint32(const char *key, uint32_t value, uint16_t magic);
+
+    /**
+     * @brief Load a value saved with saveUint32()
+     *
+     * @param key Storage key/identifier
+     * @param value Output, left untouched unless the load succeeds
+     * @param magic Expected magic number
+     * @return true if a value with matching magic was loaded
+     */
+    static bool loadUint32(const char *key, uint32_t &value, uint16_t magic);
+
+    /// Largest record accepted by saveBlob()
+    static constexpr size_t BLOB_MAX_SIZE = 96;
+
+    /// Longest blob key on ESP32: NVS keys are limited to 15 characters and the
+    /// magic number is stored under "<key>_magic"
+    static constexpr size_t KEY_MAX_LEN = 9;
+
+    /// True if a blob key and its "<key>_magic" companion fit ESP32 NVS
+    static constexpr bool keyFits(const char *key, size_t len = 0)
+    {
+        return key[len] == '\0' || (len < KEY_MAX_LEN && keyFits(key, len + 1));
+    }
+
     /**
      * @brief Check if a key exists in storage
      *
@@ -100,8 +163,10 @@ private:
     StorageAbstraction() = delete;
 
     // Storage addresses for ESP8266 EEPROM
-    static constexpr uint16_t EEPROM_SIZE = 64;
+    static constexpr uint16_t EEPROM_SIZE = 128;
     static constexpr uint16_t FREQ_OFFSET_ADDR = 0;
+    static constexpr uint16_t WORD_ADDR = 8;  // magic (2) + uint32 (4)
+    static constexpr uint16_t BLOB_ADDR = 16; // magic (2) + length (2) + data
 };
 
 #endif // STORAGE_ABSTRACTION_H
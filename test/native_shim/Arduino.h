@@ -0,0 +1,119 @@
+/**
+ * @file Arduino.h
+ * @brief Minimal Arduino core shim for native (host) builds of the services layer
+ *
+ * Provides just enough of the Arduino API for src/services/ to compile and run
+ * on the host: a virtual millisecond clock, Print/Stream/Serial and the common
+ * helper macros. Used by the [env:native_services] PlatformIO environment only;
+ * firmware builds never see this header.
+ *
+ * Time never advances on its own. Tests move it with nativeAdvanceMillis() or
+ * through delay(), so a simulated year runs in seconds and is fully repeatable.
+ */
+
+#ifndef NATIVE_SHIM_ARDUINO_H
+#define NATIVE_SHIM_ARDUINO_H
+
+#include <math.h>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+// ---------------------------------------------------------------------------
+// Virtual clock
+// ---------------------------------------------------------------------------
+
+// Milliseconds since simulated boot. Never wraps on the host (64-bit).
+inline unsigned long g_nativeMillis = 0;
+
+inline unsigned long millis() { return g_nativeMillis; }
+inline unsigned long micros() { return g_nativeMillis * 1000UL; }
+inline void delay(unsigned long ms) { g_nativeMillis += ms; }
+inline void delayMicroseconds(unsigned int us) { g_nativeMillis += us / 1000U; }
+inline void yield() {}
+inline void nativeAdvanceMillis(unsigned long ms) { g_nativeMillis += ms; }
+
+// ---------------------------------------------------------------------------
+// Helpers normally provided by the Arduino core
+// ---------------------------------------------------------------------------
+
+#define HIGH 0x1
+#define LOW 0x0
+
+template <class T, class L, class H>
+inline T constrain(T x, L low, H high)
+{
+    return x < (T)low ? (T)low : (x > (T)high ? (T)high : x);
+}
+
+inline long map(long x, long inMin, long inMax, long outMin, long outMax)
+{
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+// ---------------------------------------------------------------------------
+// Serial
+// ---------------------------------------------------------------------------
+
+// Serial output is discarded unless a test sets this, so long simulations are
+// not dominated by log formatting and terminal I/O.
+inline bool g_nativeSerialEcho = false;
+
+class Print
+{
+public:
+    virtual ~Print() = default;
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size)
+    {
+        size_t n = 0;
+        while (n < size && write(buffer[n]))
+            n++;
+        return n;
+    }
+    virtual void flush() {}
+
+    size_t print(const char *s) { return write(reinterpret_cast<const uint8_t *>(s), strlen(s)); }
+    size_t print(char c) { return write(static_cast<uint8_t>(c)); }
+    size_t println(const char *s = "") { return print(s) + print('\n'); }
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)))
+    {
+        char buf[512];
+        va_list args;
+        va_start(args, format);
+        int len = vsnprintf(buf, sizeof(buf), format, args);
+        va_end(args);
+        if (len <= 0)
+            return 0;
+        return write(reinterpret_cast<const uint8_t *>(buf), strlen(buf));
+    }
+};
+
+class Stream : public Print
+{
+public:
+    virtual int available() { return 0; }
+    virtual int read() { return -1; }
+    virtual int peek() { return -1; }
+};
+
+class HardwareSerial : public Stream
+{
+public:
+    void begin(unsigned long) {}
+    void setDebugOutput(bool) {}
+    using Print::write;
+    size_t write(uint8_t c) override
+    {
+        if (g_nativeSerialEcho)
+            putchar(c);
+        return 1;
+    }
+};
+
+inline HardwareSerial Serial;
+
+#endif // NATIVE_SHIM_ARDUINO_H
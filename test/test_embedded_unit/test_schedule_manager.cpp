@@ -277,6 +277,57 @@ void test_all_schedules_all_days(void)
     }
 }
 
+/**
+ * Test: Next fire time walks forward to the next reading day, honouring the offset
+ */
+void test_compute_next_fire_utc(void)
+{
+    // Friday 2025-02-14 12:00:00 UTC
+    const time_t friNoonUtc = 1739534400;
+
+    // Later the same day
+    TEST_ASSERT_EQUAL(friNoonUtc + 2 * 3600,
+                      ScheduleManager::computeNextFireUtc(friNoonUtc, "Monday-Friday", 14, 0, 0));
+    // Exactly at the deadline counts as due
+    TEST_ASSERT_EQUAL(friNoonUtc,
+                      ScheduleManager::computeNextFireUtc(friNoonUtc, "Monday-Friday", 12, 0, 0));
+    // Already passed on Friday: skip the weekend to Monday 10:00 UTC
+    TEST_ASSERT_EQUAL(friNoonUtc + 2 * 86400 + 22 * 3600,
+                      ScheduleManager::computeNextFireUtc(friNoonUtc, "Monday-Friday", 10, 0, 0));
+    // Single day schedule whose time has passed today: one week later
+    TEST_ASSERT_EQUAL(friNoonUtc + 7 * 86400 - 2 * 3600,
+                      ScheduleManager::computeNextFireUtc(friNoonUtc, "Friday", 10, 0, 0));
+    // 23:30 UTC with +60 min offset is 00:30 local the next day, so the first
+    // weekday match is Sunday 23:30 UTC (Monday 00:30 local)
+    TEST_ASSERT_EQUAL(friNoonUtc + 2 * 86400 + 11 * 3600 + 30 * 60,
+                      ScheduleManager::computeNextFireUtc(friNoonUtc, "Monday-Friday", 23, 30, 60));
+    // Unknown schedule never fires
+    TEST_ASSERT_EQUAL(0, ScheduleManager::computeNextFireUtc(friNoonUtc, "Someday", 10, 0, 0));
+}
+
+/**
+ * Test: Monthly Nth-weekday schedules compile and pick the right calendar day
+ */
+void test_nth_weekday_schedules(void)
+{
+    ScheduleMask mask;
+    TEST_ASSERT_TRUE(ScheduleManager::compileSchedule("First-Monday", mask));
+    TEST_ASSERT_TRUE(ScheduleManager::compileSchedule("Last-Sunday", mask));
+    TEST_ASSERT_FALSE(ScheduleManager::compileSchedule("Fifth-Monday", mask));
+    TEST_ASSERT_FALSE(ScheduleManager::compileSchedule("First-", mask));
+    TEST_ASSERT_EQUAL(0, mask.weekdays);
+
+    // Friday 2025-02-14 12:00:00 UTC
+    const time_t friNoonUtc = 1739534400;
+
+    // First Monday after 14 Feb is 3 March 2025
+    TEST_ASSERT_EQUAL(1740996000, ScheduleManager::computeNextFireUtc(friNoonUtc, "First-Monday", 10, 0, 0));
+    // Last Friday of February 2025 is the 28th
+    TEST_ASSERT_EQUAL(1740736800, ScheduleManager::computeNextFireUtc(friNoonUtc, "Last-Friday", 10, 0, 0));
+    // Second Friday is the 14th itself, but 10:00 has passed: next is 14 March
+    TEST_ASSERT_EQUAL(1741946400, ScheduleManager::computeNextFireUtc(friNoonUtc, "Second-Friday", 10, 0, 0));
+}
+
 // Optional: Unity test runner setup
 void setUp(void)
 {
@@ -299,6 +350,8 @@ void setup(void)
     // Run schedule manager tests defined in this file
     RUN_TEST(test_schedule_null);
     RUN_TEST(test_all_schedules_all_days);
+    RUN_TEST(test_compute_next_fire_utc);
+    RUN_TEST(test_nth_weekday_schedules);
 
     UNITY_END();
 }
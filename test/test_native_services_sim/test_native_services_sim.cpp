@@ -0,0 +1,1540 @@
+/**
+ * @file test_native_services_sim.cpp
+ * @brief Simulated-clock tests for the services layer (no hardware required)
+ *
+ * Builds ScheduleManager, MeterReader and FrequencyManager for the host against
+ * the Arduino shim in test/native_shim/, whose millis() is a virtual clock. A
+ * fake config provider, time provider, data publisher and radio replace the
+ * platform adapters and the CC1101, so each scenario can fast-forward through
+ * months of schedules, DST offset changes, failed reads and cooldowns in well
+ * under a second of wall time.
+ *
+ * Run with: pio test -e native_services -v
+ */
+
+#include <unity.h>
+
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+#include "core/logging.h"
+#include "services/deferred_log.h"
+#include "services/json_writer.h"
+#include "services/meter_history.h"
+#include "services/meter_reader.h"
+#include "services/read_timeline.h"
+#include "services/reading_codec.h"
+#include "services/reading_queue.h"
+#include "services/runtime_diagnostics.h"
+#include "services/schedule_manager.h"
+#include "services/spi_stats.h"
+#include "services/storage_abstraction.h"
+
+// ============================================================================
+// Simulation clock
+// ============================================================================
+
+// 2025-01-01 00:00:00 UTC, a Wednesday
+static const time_t SIM_START_UTC = 1735689600;
+static const time_t SECONDS_PER_DAY = 24 * 60 * 60;
+static const unsigned long MS_PER_DAY = 24UL * 60 * 60 * 1000;
+
+// Loop cadence. One second keeps retry backoff (5 s and up) and schedule checks
+// (500 ms throttle) realistic while a year still runs in a few seconds.
+static const unsigned long TICK_MS = 1000;
+
+// Throughput accounting across all scenarios
+static double g_totalSimDays = 0.0;
+static double g_totalWallSeconds = 0.0;
+
+static int dayOfWeek(time_t t)
+{
+    return (int)(((t / SECONDS_PER_DAY) + 4) % 7); // 1970-01-01 was a Thursday
+}
+
+static long secondOfDay(time_t t)
+{
+    return (long)(t % SECONDS_PER_DAY);
+}
+
+// ============================================================================
+// Fakes
+// ============================================================================
+
+class FakeConfigProvider : public IConfigProvider
+{
+public:
+    const char *schedule = "Monday-Sunday";
+    int readHourUtc = 10;
+    int readMinuteUtc = 0;
+    int timezoneOffsetMinutes = 0;
+    int maxRetries = 3;
+    unsigned long retryCooldownMs = 3600000UL;
+    unsigned long readCacheMaxAgeMs = 60000UL;
+    int readBudgetPerDay = 24;
+    int readBudgetBurst = 10;
+    unsigned long publishFullRefreshMs = 0;
+    bool autoAlign = false;
+    bool autoAlignMidpoint = true;
+
+    uint8_t getMeterYear() const override { return 21; }
+    uint32_t getMeterSerial() const override { return 1234567; }
+    bool isMeterGas() const override { return false; }
+    int getGasVolumeDivisor() const override { return 100; }
+
+    float getFrequency() const override { return 433.82f; }
+    bool isAutoScanEnabled() const override { return false; }
+    bool isAutoScanOnFailureEnabled() const override { return false; }
+
+    const char *getReadingSchedule() const override { return schedule; }
+    int getReadHourUTC() const override { return readHourUtc; }
+    int getReadMinuteUTC() const override { return readMinuteUtc; }
+    int getTimezoneOffsetMinutes() const override { return timezoneOffsetMinutes; }
+    bool isAutoAlignReadingTime() const override { return autoAlign; }
+    bool useAutoAlignMidpoint() const override { return autoAlignMidpoint; }
+
+    int getMaxRetries() const override { return maxRetries; }
+    unsigned long getRetryCooldownMs() const override { return retryCooldownMs; }
+    unsigned long getReadCacheMaxAgeMs() const override { return readCacheMaxAgeMs; }
+    int getReadBudgetPerDay() const override { return readBudgetPerDay; }
+    int getReadBudgetBurst() const override { return readBudgetBurst; }
+    unsigned long getPublishFullRefreshMs() const override { return publishFullRefreshMs; }
+
+    const char *getWiFiSSID() const override { return ""; }
+    const char *getWiFiPassword() const override { return ""; }
+    const char *getMqttServer() const override { return ""; }
+    const char *getMqttUsername() const override { return ""; }
+    const char *getMqttPassword() const override { return ""; }
+    const char *getMqttClientId() const override { return ""; }
+    const char *getNtpServer() const override { return ""; }
+};
+
+class FakeTimeProvider : public ITimeProvider
+{
+public:
+    bool synced = true;
+    time_t stepSeconds = 0; // Simulated wall clock corrections
+
+    bool isTimeSynced() const override { return synced; }
+    time_t getCurrentTime() const override
+    {
+        return SIM_START_UTC + (time_t)(millis() / 1000UL) + stepSeconds;
+    }
+    void requestSync() override {}
+};
+
+class FakeDataPublisher : public IDataPublisher
+{
+public:
+    std::vector<time_t> readingTimes; // UTC epoch of each published reading
+    const ITimeProvider *clock = nullptr;
+    int statisticsPublishes = 0;
+    int historyPublishes = 0;
+
+    void publishSnapshot(const ReadingSnapshot &snapshot) override
+    {
+        readingTimes.push_back(clock->getCurrentTime());
+        statisticsPublishes++;
+        if (snapshot.reading.history_available && snapshot.historyChanged)
+        {
+            historyPublishes++;
+        }
+    }
+    void publishWiFiDetails(const char *, int, int, const char *, const char *, const char *) override {}
+    void publishMeterSettings(int, unsigned long, const char *, const char *, float) override {}
+    void publishStatusMessage(const char *) override {}
+    void publishRadioState(const char *) override {}
+    void publishActiveReading(bool) override {}
+    void publishError(const char *) override {}
+    void publishStatistics(unsigned long, unsigned long, unsigned long) override { statisticsPublishes++; }
+    void publishFrequencyOffset(float) override {}
+    void publishTunedFrequency(float) override {}
+    void publishUptime(unsigned long, const char *) override {}
+    void publishFirmwareVersion(const char *) override {}
+    void publishDiscovery() override {}
+    bool isReady() const override { return true; }
+};
+
+// Fake radio: each read takes readDurationMs of virtual time and succeeds
+// unless the scenario marks the meter unreachable at that moment.
+struct FakeMeter
+{
+    std::function<bool(time_t)> reachable;
+    unsigned long readDurationMs = 1500;
+    std::vector<time_t> attemptTimes;
+    const ITimeProvider *clock = nullptr;
+
+    // Meter RTC: fixed offset from UTC plus linear drift since SIM_START_UTC
+    time_t clockOffset = 0;
+    double clockPpm = 0.0;
+    int windowStart = 6;
+    int windowEnd = 18;
+    bool historyAvailable = false; // Frames carry the (constant) monthly history
+    int volume = 123456;
+
+    time_t meterClockAt(time_t utc) const
+    {
+        return utc + clockOffset + (time_t)((double)(utc - SIM_START_UTC) * clockPpm / 1e6);
+    }
+};
+
+static FakeMeter g_meter;
+static ReadTimeline g_readTimeline;
+
+ReadTimeline &cc1101_get_read_timeline(void)
+{
+    return g_readTimeline;
+}
+
+bool cc1101_init(float freq)
+{
+    (void)freq;
+    return true;
+}
+
+struct tmeter_data get_meter_data_for_meter(uint8_t meter_year, uint32_t meter_serial)
+{
+    (void)meter_year;
+    (void)meter_serial;
+
+    const time_t now = g_meter.clock->getCurrentTime();
+    g_meter.attemptTimes.push_back(now);
+    g_readTimeline.begin(micros());
+    delay(g_meter.readDurationMs);
+    g_readTimeline.mark(ReadPhase::Capture, micros());
+
+    tmeter_data data{};
+    if (!g_meter.reachable || g_meter.reachable(now))
+    {
+        data.volume = g_meter.volume;
+        data.reads_counter = 42;
+        data.battery_left = 120;
+        data.time_start = g_meter.windowStart;
+        data.time_end = g_meter.windowEnd;
+        data.meter_clock_epoch = (uint32_t)g_meter.meterClockAt(now);
+        if (g_meter.historyAvailable)
+        {
+            data.history_available = true;
+            for (int i = 0; i < 13; i++)
+            {
+                data.history[i] = 100000 + i * 1500;
+            }
+        }
+    }
+    return data;
+}
+
+// Normally defined in core/utils.cpp, which is not part of the native build
+bool g_echo_debug_quiet = false;
+
+void printMeterDataSummary(const struct tmeter_data *meter_data, bool isMeterGas, int volumeDivisor)
+{
+    (void)meter_data;
+    (void)isMeterGas;
+    (void)volumeDivisor;
+}
+
+// ============================================================================
+// Harness
+// ============================================================================
+
+struct Sim
+{
+    FakeConfigProvider config;
+    FakeTimeProvider clock;
+    FakeDataPublisher publisher;
+    MeterReader reader;
+
+    Sim() : reader(&config, &clock, &publisher)
+    {
+        publisher.clock = &clock;
+        g_meter.clock = &clock;
+    }
+
+    time_t now() const { return clock.getCurrentTime(); }
+
+    // Advance the virtual clock tick by tick, calling reader.loop() and an
+    // optional per-tick hook (for config changes, stalls, clock steps).
+    void run(double days, const std::function<void(Sim &)> &hook = nullptr)
+    {
+        const unsigned long end = millis() + (unsigned long)(days * MS_PER_DAY);
+        const auto wallStart = std::chrono::steady_clock::now();
+
+        while (millis() < end)
+        {
+            reader.loop();
+            nativeAdvanceMillis(TICK_MS);
+            if (hook)
+            {
+                hook(*this);
+            }
+        }
+
+        const std::chrono::duration<double> wall = std::chrono::steady_clock::now() - wallStart;
+        g_totalSimDays += days;
+        g_totalWallSeconds += wall.count();
+    }
+};
+
+void setUp(void)
+{
+    g_nativeMillis = 0;
+    g_meter = FakeMeter();
+}
+
+void tearDown(void) {}
+
+// ============================================================================
+// Scenarios
+// ============================================================================
+
+/**
+ * Test: A full year of Monday-Friday reads fires exactly once per weekday, on time
+ */
+void test_sim_year_weekday_schedule(void)
+{
+    Sim sim;
+    sim.config.schedule = "Monday-Friday";
+    sim.reader.begin();
+
+    sim.run(365);
+
+    // 2025 has 261 weekdays
+    TEST_ASSERT_EQUAL(261, (int)sim.publisher.readingTimes.size());
+    for (time_t t : sim.publisher.readingTimes)
+    {
+        const int dow = dayOfWeek(t);
+        TEST_ASSERT_TRUE(dow >= 1 && dow <= 5);
+        TEST_ASSERT_INT_WITHIN(2, 10 * 3600, secondOfDay(t));
+    }
+}
+
+/**
+ * Test: Daily local 10:00 reads stay on local time across spring and autumn DST changes
+ *
+ * The integration updates the offset and UTC read time at each transition (as a
+ * DST-aware platform would) and invalidates the schedule. No day may be missed
+ * or read twice.
+ */
+void test_sim_dst_transitions(void)
+{
+    const time_t springForwardUtc = 1743296400; // 2025-03-30 01:00 UTC
+    const time_t fallBackUtc = 1761440400;      // 2025-10-26 01:00 UTC
+
+    Sim sim;
+    sim.config.schedule = "Monday-Sunday";
+    sim.reader.begin();
+
+    bool springDone = false;
+    bool autumnDone = false;
+    std::vector<int> offsetAtRead;
+
+    sim.run(365, [&](Sim &s)
+            {
+        const time_t now = s.now();
+        if (!springDone && now >= springForwardUtc)
+        {
+            springDone = true;
+            s.config.timezoneOffsetMinutes = 60;
+            s.config.readHourUtc = 9;
+            s.reader.invalidateSchedule();
+        }
+        if (!autumnDone && now >= fallBackUtc)
+        {
+            autumnDone = true;
+            s.config.timezoneOffsetMinutes = 0;
+            s.config.readHourUtc = 10;
+            s.reader.invalidateSchedule();
+        }
+        if (offsetAtRead.size() < s.publisher.readingTimes.size())
+        {
+            offsetAtRead.push_back(s.config.timezoneOffsetMinutes);
+        } });
+
+    TEST_ASSERT_EQUAL(365, (int)sim.publisher.readingTimes.size());
+    for (size_t i = 0; i < sim.publisher.readingTimes.size(); i++)
+    {
+        const time_t local = sim.publisher.readingTimes[i] + (time_t)offsetAtRead[i] * 60;
+        TEST_ASSERT_INT_WITHIN(2, 10 * 3600, secondOfDay(local));
+        if (i > 0)
+        {
+            const time_t prevLocal = sim.publisher.readingTimes[i - 1] + (time_t)offsetAtRead[i - 1] * 60;
+            TEST_ASSERT_EQUAL(1, (int)(local / SECONDS_PER_DAY - prevLocal / SECONDS_PER_DAY));
+        }
+    }
+}
+
+/**
+ * Test: An unreachable meter uses every retry, counts one failure, then recovers
+ */
+void test_sim_failures_retries_and_cooldown(void)
+{
+    const time_t outageDay = SIM_START_UTC / SECONDS_PER_DAY + 5;
+
+    Sim sim;
+    sim.config.schedule = "Monday-Sunday";
+    sim.config.maxRetries = 3;
+    sim.config.retryCooldownMs = 3600000UL;
+    g_meter.reachable = [&](time_t t)
+    { return t / SECONDS_PER_DAY != outageDay; };
+    sim.reader.begin();
+
+    sim.run(28);
+
+    unsigned long attempts = 0, successes = 0, failures = 0;
+    sim.reader.getStatistics(attempts, successes, failures);
+    TEST_ASSERT_EQUAL(27, (int)sim.publisher.readingTimes.size());
+    TEST_ASSERT_EQUAL(27 + 3, (int)attempts);
+    TEST_ASSERT_EQUAL(27, (int)successes);
+    TEST_ASSERT_EQUAL(1, (int)failures);
+
+    // All three attempts on the outage day happen within seconds of 10:00
+    int outageAttempts = 0;
+    for (time_t t : g_meter.attemptTimes)
+    {
+        if (t / SECONDS_PER_DAY == outageDay)
+        {
+            outageAttempts++;
+            TEST_ASSERT_INT_WITHIN(30, 10 * 3600 + 15, secondOfDay(t));
+        }
+    }
+    TEST_ASSERT_EQUAL(3, outageAttempts);
+}
+
+/**
+ * Test: A deadline that falls inside a cooldown catches up when the cooldown ends,
+ * unless the cooldown outlasts the catch-up window
+ */
+void test_sim_cooldown_catch_up(void)
+{
+    const time_t outageDay = SIM_START_UTC / SECONDS_PER_DAY + 1;
+
+    {
+        Sim sim;
+        sim.config.retryCooldownMs = (24UL * 60 + 30) * 60 * 1000; // 24 h 30 min
+        g_meter.reachable = [&](time_t t)
+        { return t / SECONDS_PER_DAY != outageDay; };
+        sim.reader.begin();
+        sim.run(4);
+
+        // Day 0 ok, day 1 failed, day 2 caught up around 10:30, day 3 on time
+        TEST_ASSERT_EQUAL(3, (int)sim.publisher.readingTimes.size());
+        TEST_ASSERT_EQUAL(outageDay + 1, sim.publisher.readingTimes[1] / SECONDS_PER_DAY);
+        TEST_ASSERT_INT_WITHIN(60, 10 * 3600 + 30 * 60, secondOfDay(sim.publisher.readingTimes[1]));
+        TEST_ASSERT_INT_WITHIN(2, 10 * 3600, secondOfDay(sim.publisher.readingTimes[2]));
+    }
+
+    {
+        g_nativeMillis = 0;
+        g_meter.attemptTimes.clear();
+
+        Sim sim;
+        sim.config.retryCooldownMs = 26UL * 60 * 60 * 1000; // Outlasts the 1 h catch-up window
+        sim.reader.begin();
+        sim.run(4);
+
+        // Day 2's read is too late to catch up and is skipped
+        TEST_ASSERT_EQUAL(2, (int)sim.publisher.readingTimes.size());
+        TEST_ASSERT_EQUAL(outageDay + 2, sim.publisher.readingTimes[1] / SECONDS_PER_DAY);
+    }
+}
+
+/**
+ * Test: A blocked loop that overruns the deadline still reads; a very long stall skips
+ */
+void test_sim_blocked_loop_catch_up(void)
+{
+    const time_t firstDay = SIM_START_UTC / SECONDS_PER_DAY;
+
+    Sim sim;
+    sim.reader.begin();
+
+    bool shortStallDone = false;
+    bool longStallDone = false;
+    sim.run(4, [&](Sim &s)
+            {
+        const time_t now = s.now();
+        const long sod = secondOfDay(now);
+        if (!shortStallDone && now / SECONDS_PER_DAY == firstDay + 1 && sod >= 10 * 3600 - 10)
+        {
+            shortStallDone = true;
+            nativeAdvanceMillis(50UL * 1000); // Loop blocked for 50 s across the deadline
+        }
+        if (!longStallDone && now / SECONDS_PER_DAY == firstDay + 2 && sod >= 10 * 3600 - 10)
+        {
+            longStallDone = true;
+            nativeAdvanceMillis(2UL * 60 * 60 * 1000); // Blocked for 2 h
+        } });
+
+    // Days 0, 1 (late) and 3; day 2 skipped
+    TEST_ASSERT_EQUAL(3, (int)sim.publisher.readingTimes.size());
+    TEST_ASSERT_EQUAL(firstDay + 1, sim.publisher.readingTimes[1] / SECONDS_PER_DAY);
+    TEST_ASSERT_INT_WITHIN(2, 10 * 3600 + 41, secondOfDay(sim.publisher.readingTimes[1]));
+    TEST_ASSERT_EQUAL(firstDay + 3, sim.publisher.readingTimes[2] / SECONDS_PER_DAY);
+}
+
+/**
+ * Test: No reads while time is unsynced, and a backwards clock step never repeats a read
+ */
+void test_sim_clock_disturbances(void)
+{
+    const time_t firstDay = SIM_START_UTC / SECONDS_PER_DAY;
+
+    Sim sim;
+    sim.reader.begin();
+
+    bool stepped = false;
+    sim.run(5, [&](Sim &s)
+            {
+        const time_t now = s.now();
+        const time_t day = now / SECONDS_PER_DAY;
+        s.clock.synced = (day != firstDay + 1);
+        if (!stepped && day == firstDay + 3 && secondOfDay(now) >= 10 * 3600 + 60)
+        {
+            stepped = true;
+            s.clock.stepSeconds = -3600; // NTP pulls the clock back an hour after today's read
+        } });
+
+    // Day 1 unsynced; day 3 read exactly once despite passing 10:00 twice
+    TEST_ASSERT_EQUAL(4, (int)sim.publisher.readingTimes.size());
+    int day3Reads = 0;
+    for (time_t t : sim.publisher.readingTimes)
+    {
+        TEST_ASSERT_NOT_EQUAL(firstDay + 1, t / SECONDS_PER_DAY);
+        if (t / SECONDS_PER_DAY == firstDay + 3)
+            day3Reads++;
+    }
+    TEST_ASSERT_EQUAL(1, day3Reads);
+}
+
+/**
+ * Test: Auto-aligned reading time drives a year of next-fire computations
+ */
+void test_sim_auto_align_year(void)
+{
+    const auto wallStart = std::chrono::steady_clock::now();
+
+    struct Case
+    {
+        int start;
+        int end;
+        bool midpoint;
+        long expectedUtcSecond;
+    } cases[] = {
+        {6, 18, true, 11 * 3600},  // Midpoint 12:00 local (UTC+1)
+        {6, 18, false, 5 * 3600},  // Window start 06:00 local
+        {22, 6, true, 1 * 3600},   // Window wraps midnight: midpoint 02:00 local
+    };
+
+    for (const Case &c : cases)
+    {
+        ScheduleManager::begin("Monday-Sunday", 10, 0, 60);
+        TEST_ASSERT_TRUE(ScheduleManager::autoAlignToMeterWindow(c.start, c.end, c.midpoint));
+
+        int fires = 0;
+        time_t next = ScheduleManager::computeNextFireUtc(SIM_START_UTC);
+        while (next > 0 && next < SIM_START_UTC + 365 * SECONDS_PER_DAY)
+        {
+            TEST_ASSERT_EQUAL(c.expectedUtcSecond, secondOfDay(next));
+            fires++;
+            next = ScheduleManager::computeNextFireUtc(next + 1);
+        }
+        TEST_ASSERT_EQUAL(365, fires);
+    }
+
+    // An empty window is rejected and leaves the reading time alone
+    ScheduleManager::begin("Monday-Sunday", 10, 0, 0);
+    TEST_ASSERT_FALSE(ScheduleManager::autoAlignToMeterWindow(8, 8, true));
+    TEST_ASSERT_EQUAL(10, ScheduleManager::getReadingHourUtc());
+
+    const std::chrono::duration<double> wall = std::chrono::steady_clock::now() - wallStart;
+    g_totalSimDays += 3 * 365;
+    g_totalWallSeconds += wall.count();
+}
+
+/**
+ * Test: Auto-align learns the hour where the meter answers first time
+ */
+void test_sim_read_slot_learning(void)
+{
+    Sim sim;
+    sim.config.autoAlign = true;
+    sim.config.readMinuteUtc = 30;
+    sim.reader.begin();
+
+    // Wake window 06-18. The meter only answers the first attempt in the
+    // 14:00 hour; elsewhere it needs one retry.
+    g_meter.reachable = [](time_t t)
+    { return secondOfDay(t) / 3600 == 14 || secondOfDay(t) % 3600 >= 30 * 60 + 5; };
+
+    sim.run(120);
+
+    // One read a day, including the days the slot moved
+    TEST_ASSERT_EQUAL(120, (int)sim.publisher.readingTimes.size());
+
+    // Every hour of the window was explored before settling
+    const ReadSlotStats &stats = sim.reader.getReadSlotStats();
+    for (int hour = 6; hour < 18; hour++)
+    {
+        TEST_ASSERT_TRUE(stats.getSessions(hour) >= ReadSlotStats::MIN_SESSIONS_PER_HOUR);
+    }
+    TEST_ASSERT_EQUAL(100, stats.getFirstAttemptPercent(14));
+    TEST_ASSERT_EQUAL(0, stats.getFirstAttemptPercent(12));
+
+    // Settled on 14:00 with no retries for the last month
+    const size_t n = sim.publisher.readingTimes.size();
+    const size_t attemptsBefore = g_meter.attemptTimes.size();
+    for (size_t i = n - 30; i < n; i++)
+    {
+        TEST_ASSERT_EQUAL(14, secondOfDay(sim.publisher.readingTimes[i]) / 3600);
+    }
+    TEST_ASSERT_EQUAL(14 * 3600 + 1800, secondOfDay(g_meter.attemptTimes[attemptsBefore - 1]));
+    TEST_ASSERT_EQUAL(14 * 3600 + 1800, secondOfDay(g_meter.attemptTimes[attemptsBefore - 30]));
+}
+
+/**
+ * Test: Reconnecting after an aligned read keeps the learned slot
+ *
+ * The consumer drops and returns every hour and right after each read. The
+ * aligned deadline must survive every reconnect, and no day may be read twice.
+ */
+void test_sim_reconnect_keeps_aligned_slot(void)
+{
+    Sim sim;
+    sim.config.autoAlign = true;
+    sim.config.readMinuteUtc = 30;
+    sim.reader.begin();
+    sim.reader.setHAConnected(true);
+
+    size_t readsSeen = 0;
+    int reconnects = 0;
+    sim.run(30, [&](Sim &s)
+            {
+        const bool afterRead = s.publisher.readingTimes.size() != readsSeen;
+        readsSeen = s.publisher.readingTimes.size();
+        if (!afterRead && secondOfDay(s.now()) % 3600 != 0)
+        {
+            return;
+        }
+        const time_t next = s.reader.getNextScheduledReadUtc();
+        s.reader.setHAConnected(false);
+        s.reader.setHAConnected(true);
+        TEST_ASSERT_EQUAL((long)next, (long)s.reader.getNextScheduledReadUtc());
+        reconnects++; });
+
+    TEST_ASSERT_TRUE(reconnects > 30 * 24);
+    TEST_ASSERT_EQUAL(30, (int)sim.publisher.readingTimes.size());
+    for (size_t i = 1; i < sim.publisher.readingTimes.size(); i++)
+    {
+        TEST_ASSERT_EQUAL(sim.publisher.readingTimes[i - 1] / SECONDS_PER_DAY + 1,
+                          sim.publisher.readingTimes[i] / SECONDS_PER_DAY);
+    }
+    // The first read moved the slot off the configured 10:30
+    TEST_ASSERT_NOT_EQUAL(10, secondOfDay(sim.publisher.readingTimes.back()) / 3600);
+}
+
+/**
+ * Test: Meter clock drift is tracked and reads stay clear of the window edge
+ */
+void test_sim_meter_clock_drift(void)
+{
+    Sim sim;
+    sim.config.autoAlign = true;
+    sim.config.autoAlignMidpoint = false; // Explore from the window start, the risky edge
+    sim.config.readHourUtc = 8;
+    sim.reader.begin();
+
+    // Meter clock 3 minutes slow and gaining 25 ppm; it only listens 06-12 by its own clock
+    g_meter.clockOffset = -180;
+    g_meter.clockPpm = 25.0;
+    g_meter.windowStart = 6;
+    g_meter.windowEnd = 12;
+    g_meter.reachable = [](time_t t)
+    {
+        const long meterSecond = secondOfDay(g_meter.meterClockAt(t));
+        return meterSecond >= 6 * 3600 && meterSecond < 12 * 3600;
+    };
+
+    sim.run(90);
+
+    // Every read answered first time, including the 06:00 slot that opens
+    // three minutes late by our clock
+    TEST_ASSERT_EQUAL(90, (int)sim.publisher.readingTimes.size());
+    TEST_ASSERT_EQUAL(90, (int)g_meter.attemptTimes.size());
+    int earlySlotReads = 0;
+    for (time_t t : sim.publisher.readingTimes)
+    {
+        if (secondOfDay(t) / 3600 == 6)
+        {
+            TEST_ASSERT_TRUE(secondOfDay(g_meter.meterClockAt(t)) >= 6 * 3600);
+            earlySlotReads++;
+        }
+    }
+    TEST_ASSERT_TRUE(earlySlotReads >= ReadSlotStats::MIN_SESSIONS_PER_HOUR);
+
+    const MeterClockTracker &tracker = sim.reader.getMeterClock();
+    TEST_ASSERT_TRUE(tracker.hasDrift());
+    TEST_ASSERT_FLOAT_WITHIN(2.0f, 25.0f, tracker.getDriftPpm());
+    TEST_ASSERT_INT_WITHIN(3, (int)(g_meter.meterClockAt(sim.now()) - sim.now()),
+                           (int)tracker.getOffsetSeconds(sim.now()));
+
+    // A meter clock step restarts the estimate instead of skewing it
+    MeterClockTracker stepped = tracker;
+    TEST_ASSERT_FALSE(stepped.addSample(sim.now() + 3600, sim.now()));
+    TEST_ASSERT_FALSE(stepped.hasDrift());
+    TEST_ASSERT_EQUAL(3600, stepped.getOffsetSeconds(sim.now()));
+}
+
+/**
+ * Test: Retries back off with jitter, an unresponsive meter is only probed,
+ * cooldowns double per failed session, and a closed wake window skips retries
+ */
+void test_sim_retry_backoff_and_failure_model(void)
+{
+    const time_t firstDay = SIM_START_UTC / SECONDS_PER_DAY;
+
+    Sim sim;
+    sim.config.maxRetries = 5;
+    sim.config.retryCooldownMs = 3600000UL;
+    sim.reader.begin();
+
+    // Dead from day 1 to day 5, back on day 6; asleep outside 06-18 every day
+    g_meter.reachable = [&](time_t t)
+    {
+        const time_t day = t / SECONDS_PER_DAY - firstDay;
+        const long sod = secondOfDay(t);
+        return (day < 1 || day > 5) && sod >= 6 * 3600 && sod < 18 * 3600;
+    };
+
+    bool manualDone = false;
+    sim.run(7.9, [&](Sim &s)
+            {
+        // A manual read at 20:00 on day 7, with the wake window known to be closed
+        if (!manualDone && s.now() >= (firstDay + 7) * SECONDS_PER_DAY + 20 * 3600)
+        {
+            manualDone = true;
+            s.reader.triggerReading(false);
+        } });
+
+    std::vector<std::vector<time_t>> perDay(8);
+    for (time_t t : g_meter.attemptTimes)
+    {
+        perDay[t / SECONDS_PER_DAY - firstDay].push_back(t);
+    }
+
+    // Full budget while the meter might just be unlucky, then two-attempt probes
+    const int expected[] = {1, 5, 5, 5, 2, 2, 1, 2};
+    for (int day = 0; day < 8; day++)
+    {
+        TEST_ASSERT_EQUAL(expected[day], (int)perDay[day].size());
+    }
+
+    // Delays roughly double: 5 s, 10 s, 20 s, 40 s (+/-25%), plus the 1.5 s read
+    const std::vector<time_t> &day1 = perDay[1];
+    const long first = (long)(day1[1] - day1[0]);
+    const long last = (long)(day1[4] - day1[3]);
+    TEST_ASSERT_TRUE(first >= 4 && first <= 8);
+    TEST_ASSERT_TRUE(last >= 31 && last <= 52);
+
+    // Jitter differs between days (and so between meters)
+    bool jittered = false;
+    for (int i = 1; i < 5; i++)
+    {
+        jittered |= (perDay[1][i] - perDay[1][i - 1]) != (perDay[2][i] - perDay[2][i - 1]);
+    }
+    TEST_ASSERT_TRUE(jittered);
+
+    const RetryPolicy &policy = sim.reader.getRetryPolicy();
+    TEST_ASSERT_EQUAL(1, (int)policy.getFailedStreak()); // Day 6 cleared the streak of 5
+    TEST_ASSERT_EQUAL(6, (int)policy.getFailedSessions());
+    TEST_ASSERT_EQUAL(3 + 3 + 4, (int)policy.getSkippedAttempts());
+    TEST_ASSERT_EQUAL(3600000UL, policy.getCooldownMs());
+    TEST_ASSERT_TRUE(policy.getState(millis()) == RetryPolicy::State::Idle); // 1 h cooldown over by 21:00
+
+    unsigned long attempts = 0, successes = 0, failures = 0;
+    sim.reader.getStatistics(attempts, successes, failures);
+    TEST_ASSERT_EQUAL(23, (int)attempts);
+    TEST_ASSERT_EQUAL(3, (int)successes);
+    TEST_ASSERT_EQUAL(6, (int)failures);
+
+    // Cooldowns double with the streak and are capped
+    RetryPolicy p;
+    p.configure(3, 1000, 42);
+    unsigned long lengths[5];
+    for (int i = 0; i < 5; i++)
+    {
+        TEST_ASSERT_TRUE(p.onAttemptFailed(1, false, 0) > 0);
+        TEST_ASSERT_TRUE(p.onAttemptFailed(2, false, 0) > 0 || p.isMeterUnresponsive());
+        if (!p.isMeterUnresponsive())
+        {
+            TEST_ASSERT_EQUAL(0UL, p.onAttemptFailed(3, false, 0));
+        }
+        lengths[i] = p.getCooldownMs();
+    }
+    TEST_ASSERT_EQUAL(1000UL, lengths[0]);
+    TEST_ASSERT_EQUAL(2000UL, lengths[1]);
+    TEST_ASSERT_EQUAL(4000UL, lengths[2]);
+    TEST_ASSERT_EQUAL(8000UL, lengths[3]);
+    TEST_ASSERT_EQUAL(8000UL, lengths[4]);
+}
+
+/**
+ * Test: Manual triggers reuse a fresh reading, join a read in flight, and
+ * force bypasses the cache
+ */
+void test_sim_read_cache_and_coalescing(void)
+{
+    const time_t firstDay = SIM_START_UTC / SECONDS_PER_DAY;
+
+    Sim sim;
+    sim.config.readCacheMaxAgeMs = 5UL * 60 * 1000;
+    sim.reader.begin();
+
+    // Unreachable from 12:00 so the 12:00 manual read goes through its retries
+    g_meter.reachable = [&](time_t t)
+    { return secondOfDay(t) < 12 * 3600; };
+
+    // Scheduled read at 10:00; automation polls every 30 s from 10:01 to 10:20;
+    // forced read at 10:02; manual read at 12:00 with triggers during its retries
+    sim.run(0.6, [&](Sim &s)
+            {
+        const long sod = secondOfDay(s.now());
+        if (sod >= 10 * 3600 + 60 && sod <= 10 * 3600 + 20 * 60 && sod % 30 == 0)
+        {
+            s.reader.triggerReading(false);
+        }
+        if (sod == 10 * 3600 + 120)
+        {
+            s.reader.triggerReading(false, true);
+        }
+        if (sod == 12 * 3600 || sod == 12 * 3600 + 3 || sod == 12 * 3600 + 9)
+        {
+            s.reader.triggerReading(false);
+        } });
+
+    // 10:00 scheduled, 10:02 forced, then the first poll after each cached
+    // reading expires (10:07:30, 10:13:00, 10:18:30); the rest are cache hits
+    int morning = 0;
+    for (time_t t : g_meter.attemptTimes)
+    {
+        if (t / SECONDS_PER_DAY == firstDay && secondOfDay(t) < 11 * 3600)
+        {
+            morning++;
+        }
+    }
+    TEST_ASSERT_EQUAL(5, morning);
+
+    unsigned long cacheHits = 0, coalesced = 0;
+    sim.reader.getTriggerSavings(cacheHits, coalesced);
+    TEST_ASSERT_EQUAL(39 - 3, (int)cacheHits);
+    TEST_ASSERT_EQUAL(2, (int)coalesced);
+
+    // One session of three attempts at 12:00, not three sessions
+    unsigned long attempts = 0, successes = 0, failures = 0;
+    sim.reader.getStatistics(attempts, successes, failures);
+    TEST_ASSERT_EQUAL(5 + 3, (int)attempts);
+    TEST_ASSERT_EQUAL(1, (int)failures);
+    TEST_ASSERT_TRUE(sim.reader.getLastReadingAgeMs() >= 2UL * 3600 * 1000);
+}
+
+/**
+ * Test: A forced-read automation storm is held to the read budget, and the
+ * scheduled read still gets its tokens
+ */
+void test_sim_read_budget(void)
+{
+    Sim sim;
+    sim.config.maxRetries = 3;   // Scheduled reserve of 3 tokens
+    sim.config.readBudgetBurst = 10;
+    sim.config.readBudgetPerDay = 24;
+    sim.reader.begin();
+
+    // Forced manual read every 2 minutes, all day
+    sim.run(1, [&](Sim &s)
+            {
+        if (secondOfDay(s.now()) % 120 == 60)
+        {
+            s.reader.triggerReading(false, true);
+        } });
+
+    // 7 reads from the burst (10 - 3 reserve), then one per hourly token
+    const int manualCalls = 720;
+    unsigned long attempts = 0, successes = 0, failures = 0;
+    sim.reader.getStatistics(attempts, successes, failures);
+    TEST_ASSERT_INT_WITHIN(2, 7 + 23 + 1, (int)attempts);
+
+    bool scheduledOnTime = false;
+    for (time_t t : sim.publisher.readingTimes)
+    {
+        scheduledOnTime |= secondOfDay(t) >= 10 * 3600 && secondOfDay(t) <= 10 * 3600 + 2;
+    }
+    TEST_ASSERT_TRUE(scheduledOnTime);
+
+    ReadBudget &budget = sim.reader.getReadBudget();
+    TEST_ASSERT_EQUAL(0, (int)budget.getDeniedScheduled());
+    TEST_ASSERT_EQUAL(manualCalls - ((int)attempts - 1), (int)budget.getDeniedManual());
+    TEST_ASSERT_TRUE(budget.getTokens(millis()) <= 4);
+
+    // The reserve is for scheduled sessions only; scans pay SCAN_COST
+    ReadBudget b;
+    b.configure(24, 10, 3);
+    TEST_ASSERT_TRUE(b.tryConsume(ReadBudget::SCAN_COST, ReadBudget::Priority::Manual, millis()));
+    TEST_ASSERT_FALSE(b.tryConsume(ReadBudget::SCAN_COST, ReadBudget::Priority::Manual, millis()));
+    TEST_ASSERT_TRUE(b.tryConsume(2, ReadBudget::Priority::Manual, millis()));
+    TEST_ASSERT_FALSE(b.tryConsume(1, ReadBudget::Priority::Manual, millis()));
+    TEST_ASSERT_TRUE(b.tryConsume(3, ReadBudget::Priority::Scheduled, millis()));
+    TEST_ASSERT_FALSE(b.tryConsume(1, ReadBudget::Priority::Scheduled, millis()));
+    TEST_ASSERT_EQUAL(3600000UL, b.getMsUntilNextToken(millis()));
+    nativeAdvanceMillis(3600000UL);
+    TEST_ASSERT_EQUAL(1, (int)b.getTokens(millis()));
+}
+
+void test_sim_json_payloads(void)
+{
+    // History attributes keep their published format
+    uint32_t history[13] = {1000, 1500, 2100};
+    char buf[256];
+    int written = MeterHistory::generateHistoryJson(history, 2500, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("{\"history\":[1000,1500,2100],\"monthly_usage\":[500,600],"
+                             "\"current_month_usage\":400,\"months_available\":3}",
+                             buf);
+    TEST_ASSERT_EQUAL((int)strlen(buf), written);
+
+    // A buffer one byte short publishes nothing rather than truncated JSON
+    char small[96];
+    TEST_ASSERT_EQUAL(0, MeterHistory::generateHistoryJson(history, 2500, small, written));
+    TEST_ASSERT_EQUAL_STRING("", small);
+    TEST_ASSERT_TRUE(MeterHistory::generateHistoryJson(history, 2500, small, written + 1) > 0);
+
+    // Escaping, nesting and commas
+    JsonWriter w(buf, sizeof(buf));
+    w.beginObject();
+    w.field("name", "a\"b\\c\nd\x01");
+    w.key("ids");
+    w.beginArray();
+    w.value("x");
+    w.value(-5);
+    w.value(3.14159, 2);
+    w.endArray();
+    w.key("dev");
+    w.beginObject();
+    w.field("ok", true);
+    w.field("none", (const char *)nullptr);
+    w.endObject();
+    w.field("n", 7UL);
+    w.endObject();
+    TEST_ASSERT_TRUE(w.ok());
+    TEST_ASSERT_EQUAL_STRING("{\"name\":\"a\\\"b\\\\c\\nd\\u0001\",\"ids\":[\"x\",-5,3.14],"
+                             "\"dev\":{\"ok\":true,\"none\":null},\"n\":7}",
+                             buf);
+
+    // Integers are formatted without printf, across the whole range
+    JsonWriter n(buf, sizeof(buf));
+    n.beginArray();
+    n.value(0L);
+    n.value(LONG_MIN);
+    n.value(LONG_MAX);
+    n.value(ULONG_MAX);
+    n.endArray();
+    char expected[96];
+    snprintf(expected, sizeof(expected), "[0,%ld,%ld,%lu]", LONG_MIN, LONG_MAX, ULONG_MAX);
+    TEST_ASSERT_EQUAL_STRING(expected, buf);
+
+    // Non-finite numbers have no JSON form and become null
+    JsonWriter f(buf, sizeof(buf));
+    f.beginArray();
+    f.value(NAN, 1);
+    f.value(INFINITY, 2);
+    f.value(-INFINITY, 0);
+    f.value(1.5, 1);
+    f.endArray();
+    TEST_ASSERT_TRUE(f.ok());
+    TEST_ASSERT_EQUAL_STRING("[null,null,null,1.5]", buf);
+
+    // Overflow is sticky and never writes past the buffer
+    char tiny[8];
+    JsonWriter t(tiny, sizeof(tiny));
+    t.beginObject();
+    t.field("key", "value");
+    t.field("k", 1);
+    t.endObject();
+    TEST_ASSERT_FALSE(t.ok());
+    TEST_ASSERT_TRUE(strlen(tiny) < sizeof(tiny));
+}
+
+void test_sim_reading_queue(void)
+{
+    // Ten hourly reads during an outage: the oldest two make room for the newest
+    ReadingQueue queue;
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        QueuedReading reading = {};
+        reading.timestamp = 1767225600UL + i * 3600;
+        reading.volume = (int32_t)(1000 + i);
+        TEST_ASSERT_EQUAL(i < ReadingQueue::CAPACITY, queue.push(reading));
+    }
+    TEST_ASSERT_EQUAL(ReadingQueue::CAPACITY, queue.size());
+    TEST_ASSERT_EQUAL(2, (int)queue.getDropped());
+
+    // Drained oldest first, with the original timestamps
+    QueuedReading reading;
+    for (uint32_t i = 2; i < 10; i++)
+    {
+        TEST_ASSERT_TRUE(queue.peek(reading));
+        TEST_ASSERT_EQUAL((int)(1000 + i), (int)reading.volume);
+        TEST_ASSERT_EQUAL(1767225600UL + i * 3600, (unsigned long)reading.timestamp);
+        queue.pop();
+    }
+    TEST_ASSERT_TRUE(queue.isEmpty());
+    TEST_ASSERT_FALSE(queue.peek(reading));
+    queue.pop(); // Harmless when empty
+    TEST_ASSERT_EQUAL(0, queue.size());
+
+    // ESP32 NVS keys are 15 characters at most, "<key>_magic" included
+    TEST_ASSERT_TRUE(StorageAbstraction::keyFits("rd_queue"));
+    TEST_ASSERT_TRUE(StorageAbstraction::keyFits("slot_hist"));
+    TEST_ASSERT_TRUE(StorageAbstraction::keyFits("disc_hash"));
+    TEST_ASSERT_FALSE(StorageAbstraction::keyFits("read_queue"));
+}
+
+/**
+ * Test: Unchanged statistics and history are only republished on the hourly
+ * full refresh and when Home Assistant reconnects
+ */
+void test_sim_publish_filter(void)
+{
+    Sim sim;
+    sim.config.publishFullRefreshMs = 3600000UL;
+    g_meter.historyAvailable = true;
+    sim.reader.begin();
+    const int bootPublishes = sim.publisher.statisticsPublishes;
+
+    // 288 five-minute statistics ticks, the scheduled read, a forced read half
+    // an hour later that brings the same history and volume, and one more with
+    // a new volume (current_month_usage in the history JSON changes)
+    sim.run(1, [&](Sim &s)
+            {
+        if (secondOfDay(s.now()) == 10 * 3600 + 1800)
+        {
+            s.reader.triggerReading(false, true);
+        }
+        if (secondOfDay(s.now()) == 10 * 3600 + 2700)
+        {
+            g_meter.volume += 25;
+            s.reader.triggerReading(false, true);
+        } });
+    TEST_ASSERT_EQUAL(3, (int)sim.publisher.readingTimes.size());
+    TEST_ASSERT_EQUAL(2, sim.publisher.historyPublishes);
+    const int dayPublishes = sim.publisher.statisticsPublishes - bootPublishes;
+    TEST_ASSERT_INT_WITHIN(2, 24 + 3, dayPublishes);
+    TEST_ASSERT_TRUE(sim.reader.getPublishFilter().getSuppressed() > 200);
+
+    // A reconnect republishes on the next tick instead of waiting for the refresh
+    sim.run(1.0 / 24 + 0.001); // Just past a refresh
+    const int beforeReconnect = sim.publisher.statisticsPublishes;
+    sim.reader.setHAConnected(true);
+    sim.run(6.0 / 1440);
+    TEST_ASSERT_EQUAL(beforeReconnect + 1, sim.publisher.statisticsPublishes);
+
+    // Filter semantics: a value only counts as published once the caller says so
+    PublishFilter filter;
+    filter.configure(1000);
+    TEST_ASSERT_TRUE(filter.shouldPublish(0, "42", millis()));
+    TEST_ASSERT_TRUE(filter.shouldPublish(0, "42", millis())); // Publish failed, retry
+    filter.markPublished(0, "42");
+    TEST_ASSERT_FALSE(filter.shouldPublish(0, "42", millis()));
+    TEST_ASSERT_TRUE(filter.shouldPublish(0, "43", millis()));
+    TEST_ASSERT_TRUE(filter.shouldPublish(PublishFilter::MAX_ENTITIES, "42", millis()));
+    nativeAdvanceMillis(1000);
+    TEST_ASSERT_TRUE(filter.shouldPublish(0, "42", millis())); // Full refresh
+    filter.configure(0);
+    filter.markPublished(0, "42");
+    TEST_ASSERT_TRUE(filter.shouldPublish(0, "42", millis())); // Disabled
+}
+
+/**
+ * Test: The compact binary payload round-trips, rejects damaged or unknown
+ * payloads, and is far smaller than the history JSON (size and speed reported)
+ */
+void test_sim_reading_codec(void)
+{
+    CompactReading in;
+    memset(&in, 0, sizeof(in)); // Padding too, for the memcmp below
+    in.timestamp = 1767225600UL;
+    in.volume = 123456;
+    in.rssiDbm = -88;
+    in.lqi = 40;
+    in.readsCounter = 42;
+    in.batteryMonths = 120;
+    in.timeStart = 6;
+    in.timeEnd = 18;
+    in.frequencyOffsetHz = -12300;
+    in.historyCount = 13;
+    for (int i = 0; i < 13; i++)
+    {
+        in.history[i] = 100000 + i * 1537;
+    }
+    in.history[7] -= 20000; // Meter replaced mid-year: a negative delta still round-trips
+
+    uint8_t payload[ReadingCodec::MAX_ENCODED_SIZE];
+    const size_t length = ReadingCodec::encode(in, payload, sizeof(payload));
+    TEST_ASSERT_TRUE(length > 0);
+
+    CompactReading out;
+    TEST_ASSERT_TRUE(ReadingCodec::decode(payload, length, out));
+    TEST_ASSERT_EQUAL(0, memcmp(&in, &out, sizeof(in)));
+
+    // Damaged payloads are rejected, never half-decoded
+    TEST_ASSERT_FALSE(ReadingCodec::decode(payload, length - 1, out));
+    payload[0] = ReadingCodec::SCHEMA_VERSION + 1;
+    TEST_ASSERT_FALSE(ReadingCodec::decode(payload, length, out));
+    payload[0] = ReadingCodec::SCHEMA_VERSION;
+    TEST_ASSERT_EQUAL(0, (int)ReadingCodec::encode(in, payload, length - 1));
+
+    // Without history, and with every field at its widest
+    CompactReading wide;
+    memset(&wide, 0, sizeof(wide));
+    wide.timestamp = 0xFFFFFFFFUL;
+    wide.volume = INT32_MIN;
+    wide.rssiDbm = INT16_MIN;
+    wide.frequencyOffsetHz = INT32_MAX;
+    wide.isGas = true;
+    TEST_ASSERT_TRUE(ReadingCodec::decode(payload, ReadingCodec::encode(wide, payload, sizeof(payload)), out));
+    TEST_ASSERT_EQUAL(0, memcmp(&wide, &out, sizeof(wide)));
+
+    // Size against the history attributes JSON alone
+    char json[1024];
+    const int jsonLength = MeterHistory::generateHistoryJson(in.history, (uint32_t)in.volume, json, sizeof(json));
+    TEST_ASSERT_TRUE(length * 4 < (size_t)jsonLength);
+
+    // Speed
+    const int rounds = 100000;
+    size_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++)
+    {
+        in.timestamp++;
+        sink += ReadingCodec::encode(in, payload, sizeof(payload));
+    }
+    const std::chrono::duration<double, std::nano> encodeTime = std::chrono::steady_clock::now() - start;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++)
+    {
+        sink += ReadingCodec::decode(payload, length, out) ? 1 : 0;
+    }
+    const std::chrono::duration<double, std::nano> decodeTime = std::chrono::steady_clock::now() - start;
+    TEST_ASSERT_TRUE(sink > 0);
+
+    char msg[160];
+    snprintf(msg, sizeof(msg), "Binary reading %u bytes (history JSON %d bytes), encode %.0f ns, decode %.0f ns",
+             (unsigned)length, jsonLength, encodeTime.count() / rounds, decodeTime.count() / rounds);
+    TEST_MESSAGE(msg);
+}
+
+void test_sim_history_model(void)
+{
+    uint32_t history[13] = {1000, 1500, 2100, 2100, 2900};
+    HistoryModel model;
+
+    // One pass gives the same statistics and JSON as the standalone helpers
+    TEST_ASSERT_TRUE(model.build(history, 3300));
+    TEST_ASSERT_TRUE(model.isValid());
+    const HistoryStats expected = MeterHistory::calculateStats(history, 3300);
+    TEST_ASSERT_EQUAL(0, memcmp(&expected, &model.getStats(), sizeof(expected)));
+    TEST_ASSERT_EQUAL(5, model.getStats().monthCount);
+    TEST_ASSERT_EQUAL(400, (int)model.getStats().currentMonthUsage);
+    TEST_ASSERT_EQUAL(2300, (int)model.getStats().totalUsage);
+    char json[HistoryModel::JSON_BUFFER_SIZE];
+    const int length = MeterHistory::generateHistoryJson(history, 3300, json, sizeof(json));
+    TEST_ASSERT_EQUAL_STRING(json, model.json());
+    TEST_ASSERT_EQUAL(length, model.jsonLength());
+
+    // The same frame again is neither rescanned nor rendered
+    TEST_ASSERT_FALSE(model.build(history, 3300));
+    model.json();
+    TEST_ASSERT_EQUAL(1, (int)model.getRenderCount());
+
+    // A new volume changes current_month_usage; a new month changes the history
+    TEST_ASSERT_TRUE(model.build(history, 3400));
+    TEST_ASSERT_TRUE(strstr(model.json(), "\"current_month_usage\":500") != nullptr);
+    history[5] = 3400;
+    TEST_ASSERT_TRUE(model.build(history, 3400));
+    TEST_ASSERT_EQUAL(6, model.getStats().monthCount);
+    TEST_ASSERT_EQUAL(2, (int)model.getRenderCount()); // Rendered on demand only
+
+    // No history empties the model
+    TEST_ASSERT_TRUE(model.build(nullptr, 3400));
+    TEST_ASSERT_FALSE(model.isValid());
+    TEST_ASSERT_EQUAL_STRING("", model.json());
+
+    // The largest document fits the model's buffer
+    uint32_t full[13];
+    for (int i = 0; i < 13; i++)
+    {
+        full[i] = (i % 2) ? 4000000000UL : 1000000000UL + (uint32_t)i;
+    }
+    TEST_ASSERT_TRUE(model.build(full, 4294967295UL));
+    TEST_ASSERT_TRUE(model.jsonLength() > 0);
+
+    // Rendering cost against reusing the cached document
+    const int rounds = 20000;
+    uint32_t volume = 3400;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++)
+    {
+        model.build(history, ++volume);
+        model.json();
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++)
+    {
+        model.build(history, volume);
+        model.json();
+    }
+    const auto t2 = std::chrono::steady_clock::now();
+    const std::chrono::duration<double, std::nano> renderTime = t1 - t0;
+    const std::chrono::duration<double, std::nano> cachedTime = t2 - t1;
+    char msg[128];
+    snprintf(msg, sizeof(msg), "History build+render %.0f ns, unchanged frame %.0f ns",
+             renderTime.count() / rounds, cachedTime.count() / rounds);
+    TEST_MESSAGE(msg);
+}
+
+static bool captureLine(DeferredLog &log, const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    const bool ok = log.capture(fmt, args);
+    va_end(args);
+    return ok;
+}
+
+void test_sim_deferred_log(void)
+{
+    DeferredLog log;
+    DeferredLogRecord record;
+    char text[256];
+
+    // Every conversion the radio code uses formats exactly as printf would
+    char name[16] = "radio";
+    TEST_ASSERT_TRUE(captureLine(log, "[CC1101] rssi=%d lqi=%u F_est=%d\n", -87, 42u, (int8_t)-3));
+    TEST_ASSERT_TRUE(captureLine(log, "[METER] Year=%d, Serial=%lu %s\n", 21, 4294967295UL, name));
+    TEST_ASSERT_TRUE(captureLine(log, "%02X %3d %i %.6f %-*s| 100%%", 0xAB, 7, -1, 433.82, 6, "x"));
+    TEST_ASSERT_TRUE(captureLine(log, "%lld %zu %hhd %c", -5000000000LL, (size_t)12, 300, 'Z'));
+    strcpy(name, "gone"); // %s is copied at capture, not read at flush
+    TEST_ASSERT_EQUAL(4, log.size());
+
+    char third[64];
+    char fourth[64];
+    snprintf(third, sizeof(third), "%02X %3d %i %.6f %-*s| 100%%", 0xAB, 7, -1, 433.82, 6, "x");
+    snprintf(fourth, sizeof(fourth), "%lld %zu %hhd %c", -5000000000LL, (size_t)12, (signed char)300, 'Z');
+    const char *expect[] = {"[CC1101] rssi=-87 lqi=42 F_est=-3\n",
+                            "[METER] Year=21, Serial=4294967295 radio\n", third, fourth};
+    uint32_t lastUs = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        TEST_ASSERT_TRUE(log.pop(record));
+        TEST_ASSERT_TRUE(record.timestampUs >= lastUs);
+        lastUs = record.timestampUs;
+        DeferredLog::format(record, text, sizeof(text));
+        TEST_ASSERT_EQUAL_STRING(expect[i], text);
+    }
+    TEST_ASSERT_FALSE(log.pop(record));
+
+    // Arguments that do not fit a record, or %n, are refused but not dropped
+    TEST_ASSERT_FALSE(captureLine(log, "%s\n", "a string far longer than the thirty-two bytes a record holds"));
+    int written = 0;
+    TEST_ASSERT_FALSE(captureLine(log, "abc%n", &written));
+    TEST_ASSERT_TRUE(log.isEmpty());
+    TEST_ASSERT_EQUAL(0, (int)log.takeDropped());
+
+    // A full ring drops new lines and counts them; the oldest are kept
+    for (int i = 0; i < DeferredLog::CAPACITY + 3; i++)
+    {
+        captureLine(log, "line %d", i);
+    }
+    TEST_ASSERT_TRUE(log.isFull());
+    TEST_ASSERT_EQUAL(3, (int)log.takeDropped());
+    TEST_ASSERT_TRUE(log.pop(record));
+    DeferredLog::format(record, text, sizeof(text));
+    TEST_ASSERT_EQUAL_STRING("line 0", text);
+    while (log.pop(record))
+    {
+    }
+
+    // Truncated output stays terminated
+    captureLine(log, "[METER] Decoded %d bytes from %d raw bytes\n", 122, 683);
+    log.pop(record);
+    TEST_ASSERT_EQUAL(7, (int)DeferredLog::format(record, text, 8));
+    TEST_ASSERT_EQUAL_STRING("[METER]", text);
+
+    // Exported record: format ID, timestamp, word count, flags, raw words
+    uint8_t bin[DeferredLog::MAX_EXPORT_SIZE];
+    const size_t binLength = DeferredLog::exportRecord(record, bin, sizeof(bin));
+    TEST_ASSERT_EQUAL(10 + 2 * 4, (int)binLength);
+    const uint32_t id = (uint32_t)bin[0] | (uint32_t)bin[1] << 8 | (uint32_t)bin[2] << 16 | (uint32_t)bin[3] << 24;
+    TEST_ASSERT_EQUAL_UINT32(DeferredLog::formatId(record.fmt), id);
+    TEST_ASSERT_EQUAL(2, bin[8]);
+    TEST_ASSERT_EQUAL(122, bin[10]);
+    TEST_ASSERT_EQUAL(0, (int)DeferredLog::exportRecord(record, bin, binLength - 1));
+
+    // Capture cost against formatting the line on the spot
+    const int rounds = 100000;
+    size_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++)
+    {
+        captureLine(log, "[CC1101] rssi=%d lqi=%u F_est=%d\n", -87, (unsigned)i, 3);
+        log.pop(record);
+        sink += record.wordCount;
+    }
+    const std::chrono::duration<double, std::nano> captureTime = std::chrono::steady_clock::now() - start;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++)
+    {
+        sink += (size_t)snprintf(text, sizeof(text), "[CC1101] rssi=%d lqi=%u F_est=%d\n", -87, (unsigned)i, 3);
+    }
+    const std::chrono::duration<double, std::nano> formatTime = std::chrono::steady_clock::now() - start;
+    TEST_ASSERT_TRUE(sink > 0);
+
+    char msg[128];
+    snprintf(msg, sizeof(msg), "Deferred capture %.0f ns, vsnprintf alone %.0f ns (before any Serial write)",
+             captureTime.count() / rounds, formatTime.count() / rounds);
+    TEST_MESSAGE(msg);
+}
+
+/**
+ * Test: Log lines are classed by their leading tag; untagged lines have their own bit
+ */
+void test_sim_log_tags(void)
+{
+    static_assert(everblu_log_line_tag("[METER] Reading") == EVERBLU_LOG_TAG_METER, "Tags fold at compile time");
+    TEST_ASSERT_EQUAL(EVERBLU_LOG_TAG_CC1101, everblu_log_line_tag("[RX] 12 bytes"));
+    TEST_ASSERT_EQUAL(EVERBLU_LOG_TAG_MQTT, everblu_log_line_tag("[MQTT] Connected"));
+    TEST_ASSERT_EQUAL(EVERBLU_LOG_TAG_OTHER, everblu_log_line_tag("[WIFI] Connected"));
+    TEST_ASSERT_EQUAL(EVERBLU_LOG_TAG_UNTAGGED, everblu_log_line_tag("Saved %s (%u bytes)"));
+    TEST_ASSERT_EQUAL(EVERBLU_LOG_LEVEL_WARN, everblu_log_line_level("[WARNING] Low signal"));
+    TEST_ASSERT_TRUE((EVERBLU_LOG_TAG_MASK & EVERBLU_LOG_TAG_UNTAGGED) != 0);
+    TEST_ASSERT_TRUE(everblu_log_line_enabled("Plain line"));
+}
+
+/**
+ * Test: Read timeline percentiles, skipped gaps, discarded traces and the reader's commits
+ */
+void test_sim_read_timeline(void)
+{
+    ReadTimeline timeline;
+    TEST_ASSERT_NULL(timeline.latest());
+
+    // 20 reads with a wake-up feed of 1..20 ms; only the last CAPACITY (5..20) count
+    for (uint32_t i = 1; i <= 20; i++)
+    {
+        const uint32_t t0 = 4000000000UL; // Phases straddle the micros() wrap
+        timeline.begin(t0);
+        timeline.mark(ReadPhase::WupFeed, t0 + i * 1000);
+        timeline.skip(t0 + i * 1000 + 50000); // Log flush, not charged
+        timeline.mark(ReadPhase::Decode, t0 + i * 1000 + 50000 + 300);
+        timeline.commit(i % 4 != 0);
+    }
+    TEST_ASSERT_EQUAL(ReadTimeline::CAPACITY, timeline.size());
+    TEST_ASSERT_EQUAL(20, (int)timeline.getCommitted());
+    TEST_ASSERT_FALSE(timeline.isOpen());
+    TEST_ASSERT_FALSE(timeline.latest()->success);
+    TEST_ASSERT_EQUAL_UINT32(20000, timeline.latest()->phaseUs[(size_t)ReadPhase::WupFeed]);
+
+    const ReadPhaseStats feed = timeline.getPhaseStats(ReadPhase::WupFeed);
+    TEST_ASSERT_EQUAL(16, feed.samples);
+    TEST_ASSERT_EQUAL_UINT32(12000, feed.p50Us); // 8th of 5..20
+    TEST_ASSERT_EQUAL_UINT32(20000, feed.p95Us); // 16th
+    TEST_ASSERT_EQUAL_UINT32(20000, feed.maxUs);
+    TEST_ASSERT_EQUAL_UINT32(300, timeline.getPhaseStats(ReadPhase::Decode).maxUs);
+    TEST_ASSERT_EQUAL(0, timeline.getPhaseStats(ReadPhase::Crc).samples);
+    TEST_ASSERT_EQUAL_UINT32(12300, timeline.getTotalStats().p50Us);
+
+    // A trace that is never committed is dropped by the next begin()
+    timeline.begin(0);
+    timeline.mark(ReadPhase::WupFeed, 999999);
+    timeline.begin(0);
+    timeline.commit(true);
+    TEST_ASSERT_EQUAL(0, (int)(timeline.latest()->recorded & (1U << (size_t)ReadPhase::WupFeed)));
+    timeline.mark(ReadPhase::Parse, 5); // No trace open: ignored
+    timeline.commit(true);
+    TEST_ASSERT_EQUAL(21, (int)timeline.getCommitted());
+
+    char buffer[640];
+    JsonWriter json(buffer, sizeof(buffer));
+    timeline.writeJson(json);
+    TEST_ASSERT_TRUE(json.ok());
+    TEST_ASSERT_EQUAL_STRING("{\"reads\":16,\"total_ms\":[12.3,20.3,20.3],"
+                             "\"phases_ms\":{\"wup_feed\":[13.0,20.0,20.0],\"decode\":[0.3,0.3,0.3]}}",
+                             buffer);
+
+    // The reader commits every reported read, failed or not, and publishing is timed
+    g_meter.reachable = [](time_t t) { return secondOfDay(t) < 12 * 3600; };
+    Sim sim;
+    sim.config.schedule = "Monday-Sunday";
+    sim.reader.begin();
+    const unsigned long before = g_readTimeline.getCommitted();
+    sim.run(2);
+    const unsigned long attempts = (unsigned long)g_meter.attemptTimes.size();
+    TEST_ASSERT_TRUE(attempts > 0);
+    TEST_ASSERT_EQUAL(attempts, g_readTimeline.getCommitted() - before);
+    TEST_ASSERT_EQUAL_UINT32(g_meter.readDurationMs * 1000, g_readTimeline.getPhaseStats(ReadPhase::Capture).maxUs);
+    TEST_ASSERT_TRUE(g_readTimeline.getPhaseStats(ReadPhase::Publish).samples > 0);
+}
+
+/**
+ * Test: SPI transactions are classified from the CC1101 header and bucketed by log2 latency
+ */
+void test_sim_spi_stats(void)
+{
+    TEST_ASSERT_EQUAL((int)SpiOp::Strobe, (int)SpiStats::classify(0x36, 1));      // SIDLE
+    TEST_ASSERT_EQUAL((int)SpiOp::SingleWrite, (int)SpiStats::classify(0x12, 2)); // MDMCFG2
+    TEST_ASSERT_EQUAL((int)SpiOp::SingleRead, (int)SpiStats::classify(0xF5, 2));  // MARCSTATE (status register)
+    TEST_ASSERT_EQUAL((int)SpiOp::BurstWrite, (int)SpiStats::classify(0x7F, 40)); // TX FIFO
+    TEST_ASSERT_EQUAL((int)SpiOp::BurstRead, (int)SpiStats::classify(0xFF, 65));  // RX FIFO
+
+    TEST_ASSERT_EQUAL(0, SpiStats::bucketFor(0));
+    TEST_ASSERT_EQUAL(1, SpiStats::bucketFor(1));
+    TEST_ASSERT_EQUAL(3, SpiStats::bucketFor(7));
+    TEST_ASSERT_EQUAL(4, SpiStats::bucketFor(8));
+    TEST_ASSERT_EQUAL(SpiOpStats::BUCKETS - 1, SpiStats::bucketFor(UINT32_MAX));
+
+    SpiStats spi;
+    spi.record(SpiOp::SingleRead, 2, 5);
+    spi.record(SpiOp::SingleRead, 2, 6);
+    spi.record(SpiOp::SingleRead, 2, 40);
+    spi.record(SpiOp::BurstWrite, 40, 300);
+    TEST_ASSERT_EQUAL_UINT32(4, spi.totalCount());
+    TEST_ASSERT_EQUAL_UINT32(351, spi.totalUs());
+    const SpiOpStats &reads = spi.get(SpiOp::SingleRead);
+    TEST_ASSERT_EQUAL_UINT32(6, reads.bytes);
+    TEST_ASSERT_EQUAL_UINT32(40, reads.maxUs);
+    TEST_ASSERT_EQUAL(2, reads.hist[3]);
+    TEST_ASSERT_EQUAL(1, reads.hist[6]);
+
+    char buffer[256];
+    JsonWriter json(buffer, sizeof(buffer));
+    spi.writeJson(json);
+    TEST_ASSERT_TRUE(json.ok());
+    TEST_ASSERT_EQUAL_STRING("{\"n\":4,\"bytes\":46,\"us\":351,\"ops\":{"
+                             "\"single_read\":{\"n\":3,\"bytes\":6,\"us\":51,\"max_us\":40,\"hist\":[0,0,0,2,0,0,1]},"
+                             "\"burst_write\":{\"n\":1,\"bytes\":40,\"us\":300,\"max_us\":300,\"hist\":[0,0,0,0,0,0,0,0,0,1]}}}",
+                             buffer);
+
+    spi.reset();
+    TEST_ASSERT_EQUAL_UINT32(0, spi.totalCount());
+    TEST_ASSERT_EQUAL(0, spi.get(SpiOp::BurstWrite).hist[9]);
+}
+
+/**
+ * Test: Memory minimums, loop-block buckets, the diagnostics JSON and the reader's read snapshots
+ */
+void test_sim_runtime_diagnostics(void)
+{
+    TEST_ASSERT_EQUAL(0, RuntimeDiagnostics::loopBucketFor(0));
+    TEST_ASSERT_EQUAL(1, RuntimeDiagnostics::loopBucketFor(1));
+    TEST_ASSERT_EQUAL(2, RuntimeDiagnostics::loopBucketFor(3));
+    TEST_ASSERT_EQUAL(3, RuntimeDiagnostics::loopBucketFor(4));
+    TEST_ASSERT_EQUAL(RuntimeDiagnostics::LOOP_BUCKETS - 1, RuntimeDiagnostics::loopBucketFor(60000));
+
+    RuntimeDiagnostics diagnostics;
+    char buffer[512];
+    JsonWriter empty(buffer, sizeof(buffer));
+    diagnostics.writeJson(empty);
+    TEST_ASSERT_TRUE(empty.ok());
+    TEST_ASSERT_EQUAL_STRING("{\"free_heap\":0,\"largest_block\":0,\"frag_pct\":0,\"min_free_heap\":0,"
+                             "\"stack_free\":0,\"loops\":0,\"loop_max_ms\":0,\"loop_hist\":[]}",
+                             buffer);
+
+    // Minimums come from the lowest sample or the platform's own minimum, whichever is lower
+    diagnostics.recordSample({1000, 800, 20, 0, 300});
+    diagnostics.recordSample({900, 600, 33, 0, 500});
+    diagnostics.recordSample({1200, 1100, 8, 700, 400});
+    TEST_ASSERT_EQUAL_UINT32(1200, diagnostics.getLast().freeHeap);
+    TEST_ASSERT_EQUAL_UINT32(700, diagnostics.getMinFreeHeap());
+    TEST_ASSERT_EQUAL_UINT32(300, diagnostics.getMinStackFree());
+
+    const uint32_t loops[] = {0, 1, 3, 40, 40};
+    for (uint32_t ms : loops)
+    {
+        diagnostics.recordLoop(ms);
+    }
+    TEST_ASSERT_EQUAL_UINT32(5, diagnostics.getLoopCount());
+    TEST_ASSERT_EQUAL_UINT32(40, diagnostics.getMaxLoopMs());
+    TEST_ASSERT_EQUAL_UINT32(2, diagnostics.getLoopBucket(6));
+    TEST_ASSERT_EQUAL_UINT32(0, diagnostics.getLoopBucket(RuntimeDiagnostics::LOOP_BUCKETS));
+
+    JsonWriter json(buffer, sizeof(buffer));
+    diagnostics.writeJson(json);
+    TEST_ASSERT_TRUE(json.ok());
+    TEST_ASSERT_EQUAL_STRING("{\"free_heap\":1200,\"largest_block\":1100,\"frag_pct\":8,\"min_free_heap\":700,"
+                             "\"stack_free\":300,\"loops\":5,\"loop_max_ms\":40,\"loop_hist\":[1,1,1,0,0,0,2]}",
+                             buffer);
+
+    // The reader snapshots memory around every read it reports
+    g_meter.reachable = [](time_t t) { return secondOfDay(t) < 12 * 3600; };
+    Sim sim;
+    sim.config.schedule = "Monday-Sunday";
+    sim.reader.begin();
+    TEST_ASSERT_FALSE(sim.reader.getDiagnostics().hasReadSnapshots());
+    sim.run(1);
+    TEST_ASSERT_TRUE(g_meter.attemptTimes.size() > 0);
+    TEST_ASSERT_TRUE(sim.reader.getDiagnostics().hasReadSnapshots());
+    JsonWriter readJson(buffer, sizeof(buffer));
+    sim.reader.getDiagnostics().writeJson(readJson);
+    TEST_ASSERT_TRUE(readJson.ok());
+    TEST_ASSERT_NOT_NULL(strstr(buffer, "\"read\":{\"before\":{"));
+}
+
+/**
+ * Report: simulated days per wall-clock second across all scenarios
+ */
+void test_sim_report_throughput(void)
+{
+    char msg[128];
+    snprintf(msg, sizeof(msg), "Simulated %.0f days in %.3f s (%.0f simulated days/s)",
+             g_totalSimDays, g_totalWallSeconds,
+             g_totalWallSeconds > 0.0 ? g_totalSimDays / g_totalWallSeconds : 0.0);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(g_totalSimDays > 0.0);
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_sim_year_weekday_schedule);
+    RUN_TEST(test_sim_dst_transitions);
+    RUN_TEST(test_sim_failures_retries_and_cooldown);
+    RUN_TEST(test_sim_cooldown_catch_up);
+    RUN_TEST(test_sim_blocked_loop_catch_up);
+    RUN_TEST(test_sim_clock_disturbances);
+    RUN_TEST(test_sim_auto_align_year);
+    RUN_TEST(test_sim_read_slot_learning);
+    RUN_TEST(test_sim_reconnect_keeps_aligned_slot);
+    RUN_TEST(test_sim_meter_clock_drift);
+    RUN_TEST(test_sim_retry_backoff_and_failure_model);
+    RUN_TEST(test_sim_read_cache_and_coalescing);
+    RUN_TEST(test_sim_read_budget);
+    RUN_TEST(test_sim_json_payloads);
+    RUN_TEST(test_sim_reading_queue);
+    RUN_TEST(test_sim_publish_filter);
+    RUN_TEST(test_sim_reading_codec);
+    RUN_TEST(test_sim_history_model);
+    RUN_TEST(test_sim_deferred_log);
+    RUN_TEST(test_sim_log_tags);
+    RUN_TEST(test_sim_read_timeline);
+    RUN_TEST(test_sim_spi_stats);
+    RUN_TEST(test_sim_runtime_diagnostics);
+    RUN_TEST(test_sim_report_throughput);
+    return UNITY_END();
+}
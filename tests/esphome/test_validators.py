@@ -97,13 +97,17 @@ def test_meter_code_invalid(code):
         ("friday", "Friday"),
         ("Saturday", "Saturday"),
         ("  Monday-Saturday  ", "Monday-Saturday"),
+        ("first-monday", "First-Monday"),
+        ("LAST-FRIDAY", "Last-Friday"),
     ],
 )
 def test_reading_schedule_normalizes_case(value, expected):
     assert comp.validate_reading_schedule(value) == expected
 
 
-@pytest.mark.parametrize("value", ["Funday", "Mon-Fri", "Everyday", ""])
+@pytest.mark.parametrize(
+    "value", ["Funday", "Mon-Fri", "Everyday", "", "Fifth-Monday", "First-Funday", "First-"]
+)
 def test_reading_schedule_invalid(value):
     with pytest.raises(cv.Invalid):
         comp.validate_reading_schedule(value)
@@ -0,0 +1,240 @@
+#!/usr/bin/env python3
+"""
+Decode binary deferred debug records in a captured firmware log.
+
+Firmware built with -DECHO_DEBUG_BINARY prints the echo_debug() lines deferred
+during a radio read as hex records instead of text:
+
+  [I][everblu_meter] [DLOG] 5A1C93E0A08601000200...
+
+Each record carries an FNV-1a hash of its format string rather than the string
+itself (layout in src/services/deferred_log.h). This script rebuilds the
+hash -> format table from the echo_debug() calls in the source tree, decodes
+every [DLOG] record and passes all other lines through unchanged, so the output
+reads like a normal log. Decode against the same source revision the firmware
+was built from.
+
+Usage:
+  python tools/deferred_log_decoder.py capture.log
+  pio device monitor | python tools/deferred_log_decoder.py -
+"""
+
+from __future__ import annotations
+
+import argparse
+import pathlib
+import re
+import struct
+import sys
+from typing import TextIO
+
+DLOG_RE = re.compile(r"\[DLOG\] ([0-9A-Fa-f]+)")
+
+# echo_debug(flag, "literal" ["literal" ...], ...)
+CALL_RE = re.compile(
+    r'echo_debug\s*\(\s*[^,;]+,\s*((?:"(?:[^"\\]|\\.)*"\s*)+)', re.DOTALL
+)
+LITERAL_RE = re.compile(r'"((?:[^"\\]|\\.)*)"')
+
+SPEC_RE = re.compile(
+    r"%([-+ #0]*)(\*|\d*)(?:\.(\*|\d*))?(hh|h|ll|l|z|j|t|q|L)?([diuxXocfFeEgGaAsp%])"
+)
+
+C_ESCAPES = {
+    "n": "\n",
+    "t": "\t",
+    "r": "\r",
+    "0": "\0",
+    "\\": "\\",
+    '"': '"',
+    "'": "'",
+    "a": "\a",
+    "b": "\b",
+    "f": "\f",
+    "v": "\v",
+}
+
+FLAG_LONG_64 = 0x01
+FLAG_POINTER_64 = 0x02
+
+
+def fnv1a(data: bytes) -> int:
+    h = 2166136261
+    for b in data:
+        h ^= b
+        h = (h * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def unescape_c(text: str) -> str:
+    out = []
+    i = 0
+    while i < len(text):
+        ch = text[i]
+        if ch != "\\" or i + 1 >= len(text):
+            out.append(ch)
+            i += 1
+            continue
+        nxt = text[i + 1]
+        if nxt == "x":
+            m = re.match(r"[0-9A-Fa-f]{1,2}", text[i + 2 :])
+            digits = m.group(0) if m else "0"
+            out.append(chr(int(digits, 16)))
+            i += 2 + len(digits) if m else 2
+        else:
+            out.append(C_ESCAPES.get(nxt, nxt))
+            i += 2
+    return "".join(out)
+
+
+def build_format_table(src_dir: pathlib.Path) -> dict[int, str]:
+    table: dict[int, str] = {}
+    for path in sorted(src_dir.rglob("*")):
+        if path.suffix not in (".c", ".cpp", ".h"):
+            continue
+        source = path.read_text(encoding="utf-8", errors="replace")
+        for call in CALL_RE.finditer(source):
+            fmt = "".join(unescape_c(lit) for lit in LITERAL_RE.findall(call.group(1)))
+            table[fnv1a(fmt.encode("latin-1", errors="replace"))] = fmt
+    return table
+
+
+class Words:
+    def __init__(self, words: list[int]) -> None:
+        self.words = words
+        self.pos = 0
+
+    def take(self, size: int) -> int:
+        count = 2 if size > 4 else 1
+        if self.pos + count > len(self.words):
+            raise ValueError("record has fewer argument words than its format needs")
+        value = self.words[self.pos]
+        if count == 2:
+            value |= self.words[self.pos + 1] << 32
+        self.pos += count
+        return value
+
+    def take_string(self) -> str:
+        raw = b"".join(struct.pack("<I", w) for w in self.words[self.pos :])
+        end = raw.find(b"\0")
+        if end < 0:
+            raise ValueError("unterminated string argument")
+        self.pos += end // 4 + 1
+        return raw[:end].decode("latin-1")
+
+
+def int_size(length: str | None, flags: int) -> int:
+    if length in ("ll", "j", "q"):
+        return 8
+    if length == "l":
+        return 8 if flags & FLAG_LONG_64 else 4
+    if length in ("z", "t"):
+        return 8 if flags & FLAG_POINTER_64 else 4
+    return 4
+
+
+def to_signed(value: int, bits: int) -> int:
+    value &= (1 << bits) - 1
+    return value - (1 << bits) if value >> (bits - 1) else value
+
+
+def format_record(fmt: str, words: Words, flags: int) -> str:
+    def convert(m: re.Match[str]) -> str:
+        flag_chars, width, precision, length, conv = m.groups()
+        if conv == "%":
+            return "%"
+        if width == "*":
+            width = str(to_signed(words.take(4), 32))
+        if precision == "*":
+            precision = str(to_signed(words.take(4), 32))
+        spec = (
+            "%"
+            + flag_chars
+            + (width or "")
+            + (f".{precision}" if precision is not None else "")
+        )
+
+        if conv in "diuxXoc":
+            size = int_size(length, flags)
+            bits = {"hh": 8, "h": 16}.get(length or "", size * 8)
+            value = words.take(size) & ((1 << bits) - 1)
+            if conv in "di":
+                return (spec + "d") % to_signed(value, bits)
+            if conv == "c":
+                return (spec + "c") % chr(value & 0xFF)
+            return (spec + ("d" if conv == "u" else conv)) % value
+        if conv in "fFeEgGaA":
+            value = struct.unpack("<d", struct.pack("<Q", words.take(8)))[0]
+            if conv in "aA":
+                text = value.hex()
+                return text.upper() if conv == "A" else text
+            return (spec + conv) % value
+        if conv == "s":
+            return (spec + "s") % words.take_string()
+        # %p
+        return f"0x{words.take(8 if flags & FLAG_POINTER_64 else 4):x}"
+
+    return SPEC_RE.sub(convert, fmt)
+
+
+def decode_record(data: bytes, table: dict[int, str]) -> tuple[int, str]:
+    if len(data) < 10:
+        raise ValueError("record shorter than its header")
+    fmt_id, timestamp_us, count, flags = struct.unpack_from("<IIBB", data)
+    if len(data) != 10 + 4 * count:
+        raise ValueError(
+            f"record length {len(data)} does not match {count} argument words"
+        )
+    words = list(struct.unpack_from(f"<{count}I", data, 10))
+    fmt = table.get(fmt_id)
+    if fmt is None:
+        args = " ".join(f"{w:08X}" for w in words)
+        return timestamp_us, f"<unknown format {fmt_id:08X}> {args}\n"
+    return timestamp_us, format_record(fmt, Words(words), flags)
+
+
+def decode_stream(stream: TextIO, table: dict[int, str]) -> None:
+    first_us: int | None = None
+    for line in stream:
+        m = DLOG_RE.search(line)
+        if not m:
+            sys.stdout.write(line)
+            continue
+        try:
+            timestamp_us, text = decode_record(bytes.fromhex(m.group(1)), table)
+        except ValueError as err:
+            sys.stdout.write(f"{line.rstrip()}  <decode error: {err}>\n")
+            continue
+        if first_us is None:
+            first_us = timestamp_us
+        offset_us = (timestamp_us - first_us) & 0xFFFFFFFF
+        sys.stdout.write(f"[+{offset_us // 1000}.{offset_us % 1000:03d}ms] {text}")
+        if not text.endswith("\n"):
+            sys.stdout.write("\n")
+
+
+def main() -> int:
+    repo_root = pathlib.Path(__file__).resolve().parent.parent
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter
+    )
+    parser.add_argument("log", help="captured log file, or - for stdin")
+    parser.add_argument(
+        "--src",
+        type=pathlib.Path,
+        default=repo_root / "src",
+        help="source tree the firmware was built from (default: %(default)s)",
+    )
+    args = parser.parse_args()
+
+    table = build_format_table(args.src)
+    if args.log == "-":
+        decode_stream(sys.stdin, table)
+    else:
+        with pathlib.Path(args.log).open(encoding="utf-8", errors="replace") as stream:
+            decode_stream(stream, table)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())